@@ -0,0 +1,282 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Banc de mesure au cycle près : exécution du firmware dans le simulateur
+ * simavr (ATmega328P à 16 MHz).
+ *
+ * Le firmware délimite les portions de code à mesurer en écrivant dans le
+ * registre GPIOR0 : un identifiant non nul ouvre une mesure, 0 la ferme.
+ * Il nomme chaque identifiant en écrivant l'identifiant dans GPIOR2, puis
+ * les caractères du nom dans GPIOR1 (terminés par 0).
+ *
+ * Le signal du bouton (broche D2) est rejoué en boucle à partir d'un
+ * fichier de paliers (une ligne "date_us niveau" par transition, la
+ * dernière date fixant la période).
+ *
+ * La simulation s'arrête lorsque le firmware s'endort, interruptions
+ * désactivées.
+ *
+ * Usage : cycles firmware.elf waveform.txt
+ * -------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <sim_avr.h>
+#include <sim_elf.h>
+#include <sim_io.h>
+#include <sim_cycle_timers.h>
+#include <avr_ioport.h>
+
+/**
+ * @brief Adresses des registres GPIOR0, GPIOR1 et GPIOR2 dans l'espace des données.
+ */
+#define GPIOR0_ADDR 0x3e
+#define GPIOR1_ADDR 0x4a
+#define GPIOR2_ADDR 0x4b
+
+/**
+ * @brief Nombre maximal de mesures, de transitions et de caractères d'un nom.
+ */
+#define MAX_REGIONS 256
+#define MAX_EDGES   256
+#define MAX_NAME    32
+
+/**
+ * @brief Statistiques d'une portion de code mesurée.
+ */
+struct region {
+    char     name[MAX_NAME];
+    uint32_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+};
+
+/**
+ * @brief Transition du signal du bouton.
+ */
+struct edge {
+    uint32_t time_us;
+    uint8_t  level;
+};
+
+static struct region regions[MAX_REGIONS];
+static struct edge   edges[MAX_EDGES];
+static uint16_t      num_edges;
+static uint16_t      next_edge;
+static uint32_t      period_us;
+
+static uint8_t          open_id;
+static avr_cycle_count_t open_cycle;
+
+static uint8_t naming_id;
+static uint8_t naming_length;
+
+static avr_irq_t *button_irq;
+
+/**
+ * @brief Écriture dans GPIOR0 : ouverture ou fermeture d'une mesure.
+ *
+ * @note Le rappel a lieu pendant l'exécution de l'instruction `out` :
+ *       avr->cycle n'inclut pas encore ses cycles. La mesure comprend donc
+ *       l'instruction `out` d'ouverture et le chargement de l'identifiant
+ *       de fermeture : c'est ce que mesure la portion vide "overhead".
+ */
+static void gpior0_write(avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param) {
+
+    avr->data[addr] = value;
+
+    if (value) {
+        open_id    = value;
+        open_cycle = avr->cycle;
+        return;
+    }
+
+    if (!open_id) return;
+
+    struct region *r = &regions[open_id];
+    uint64_t cycles  = avr->cycle - open_cycle;
+
+    if (!r->count || cycles < r->min) r->min = cycles;
+    if (cycles > r->max) r->max = cycles;
+
+    r->total += cycles;
+    r->count++;
+
+    open_id = 0;
+
+}
+
+/**
+ * @brief Écriture dans GPIOR1 : caractère suivant du nom d'une mesure.
+ */
+static void gpior1_write(avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param) {
+
+    avr->data[addr] = value;
+
+    char *name = regions[naming_id].name;
+
+    if (naming_length < MAX_NAME - 1) name[naming_length++] = value;
+    if (!value) naming_length = MAX_NAME;
+    name[MAX_NAME - 1] = 0;
+
+}
+
+/**
+ * @brief Écriture dans GPIOR2 : début du nom d'une mesure.
+ */
+static void gpior2_write(avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param) {
+
+    avr->data[addr] = value;
+
+    naming_id     = value;
+    naming_length = 0;
+
+    regions[value].name[0] = 0;
+
+}
+
+/**
+ * @brief Rejoue la transition suivante du signal du bouton.
+ */
+static avr_cycle_count_t replay(avr_t *avr, avr_cycle_count_t when, void *param) {
+
+    struct edge *e = &edges[next_edge];
+
+    avr_raise_irq(button_irq, e->level);
+
+    uint32_t from_us = e->time_us;
+
+    if (++next_edge == num_edges) next_edge = 0;
+
+    uint32_t to_us    = edges[next_edge].time_us;
+    uint32_t delay_us = to_us > from_us ? to_us - from_us : period_us - from_us + to_us;
+
+    if (!delay_us) delay_us = 1;
+
+    return when + avr_usec_to_cycles(avr, delay_us);
+
+}
+
+/**
+ * @brief Lecture du fichier de paliers.
+ */
+static int load_waveform(const char *path) {
+
+    FILE *f = fopen(path, "r");
+    char  line[64];
+
+    if (!f) return -1;
+
+    while (fgets(line, sizeof(line), f)) {
+
+        unsigned long time_us;
+        unsigned      level;
+
+        if (line[0] == '#' || sscanf(line, "%lu %u", &time_us, &level) != 2) continue;
+
+        period_us = time_us;
+
+        if (num_edges < MAX_EDGES) {
+            edges[num_edges].time_us = time_us;
+            edges[num_edges].level   = level ? 1 : 0;
+            num_edges++;
+        }
+
+    }
+
+    fclose(f);
+
+    // La dernière ligne fixe la période : son niveau est celui du début du cycle suivant.
+    if (num_edges > 1) num_edges--;
+
+    return num_edges ? 0 : -1;
+
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s firmware.elf waveform.txt\n", argv[0]);
+        return 1;
+    }
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+
+    if (elf_read_firmware(argv[1], &firmware)) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    if (load_waveform(argv[2])) {
+        fprintf(stderr, "cannot read %s\n", argv[2]);
+        return 1;
+    }
+
+    avr_t *avr = avr_make_mcu_by_name("atmega328p");
+
+    if (!avr) {
+        fprintf(stderr, "atmega328p is not supported by this simavr build\n");
+        return 1;
+    }
+
+    avr_init(avr);
+    avr_load_firmware(avr, &firmware);
+    avr->frequency = 16000000;
+
+    avr_register_io_write(avr, GPIOR0_ADDR, gpior0_write, NULL);
+    avr_register_io_write(avr, GPIOR1_ADDR, gpior1_write, NULL);
+    avr_register_io_write(avr, GPIOR2_ADDR, gpior2_write, NULL);
+
+    button_irq = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 2);
+    avr_cycle_timer_register_usec(avr, edges[0].time_us + 1, replay, NULL);
+
+    int state;
+
+    do state = avr_run(avr);
+    while (state != cpu_Done && state != cpu_Crashed);
+
+    if (state == cpu_Crashed) {
+        fprintf(stderr, "firmware crashed at cycle %llu\n", (unsigned long long) avr->cycle);
+        return 1;
+    }
+
+    // La portion vide (identifiant 1) mesure le coût des marqueurs eux-mêmes.
+    uint64_t overhead = regions[1].count ? regions[1].min : 0;
+
+    printf("%-28s %8s %8s %8s %8s\n", "region", "count", "min", "avg", "max");
+
+    for (int id = 1; id < MAX_REGIONS; id++) {
+
+        struct region *r = &regions[id];
+
+        if (!r->count) continue;
+
+        uint64_t bias = id == 1 ? 0 : overhead;
+
+        printf("%-28s %8u %8llu %8.1f %8llu\n",
+            r->name[0] ? r->name : "?",
+            r->count,
+            (unsigned long long) (r->min - bias),
+            (double) r->total / r->count - bias,
+            (unsigned long long) (r->max - bias));
+
+    }
+
+    printf("\ncycles at 16 MHz, marker overhead (%llu cycles) subtracted, %llu cycles simulated\n",
+        (unsigned long long) overhead,
+        (unsigned long long) avr->cycle);
+
+    return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#!/bin/sh
+# -------------------------------------------------------------------------
+# Banc de mesure au cycle près : compile le programme de mesure pour la
+# carte Nano (ATmega328P), l'exécute dans simavr, puis affiche l'occupation
+# de la mémoire flash et de la mémoire vive de chaque configuration.
+#
+# Usage : bench/run.sh [waveform.txt] [env...]
+#
+#   waveform.txt  signal du bouton (bench/waveforms/bouncy.txt par défaut)
+#   env...        environnements PlatformIO dont on veut l'occupation
+#                 mémoire (bench et led-chaser par défaut)
+#
+# PlatformIO n'ajoute pas sa chaîne de compilation AVR au PATH : avr-size et
+# avr-nm sont cherchés dans le PATH, puis dans le paquet toolchain-atmelavr
+# de PlatformIO (PLATFORMIO_CORE_DIR, ~/.platformio par défaut). AVR_BIN
+# permet d'imposer un autre répertoire.
+# -------------------------------------------------------------------------
+
+set -e
+
+cd "$(dirname "$0")/.."
+
+PIO_HOME=${PLATFORMIO_CORE_DIR:-$HOME/.platformio}
+
+# Commande pio : PATH, puis environnement Python de PlatformIO.
+if command -v pio >/dev/null 2>&1; then
+    PIO=pio
+elif [ -x "$PIO_HOME/penv/bin/pio" ]; then
+    PIO=$PIO_HOME/penv/bin/pio
+else
+    echo "run.sh: pio not found (install PlatformIO Core)" >&2
+    exit 1
+fi
+
+# Outils binutils AVR : AVR_BIN, PATH, puis chaîne de compilation de PlatformIO.
+avr_tool() {
+    if [ -n "$AVR_BIN" ]; then
+        echo "$AVR_BIN/$1"
+    elif command -v "$1" >/dev/null 2>&1; then
+        echo "$1"
+    else
+        echo "$PIO_HOME/packages/toolchain-atmelavr/bin/$1"
+    fi
+}
+
+WAVEFORM=${1:-bench/waveforms/bouncy.txt}
+[ $# -gt 0 ] && shift
+ENVS=${*:-bench led-chaser}
+
+"$PIO" run -e bench
+make -s -C bench
+
+# La chaîne de compilation n'est installée qu'après la première compilation.
+AVR_SIZE=$(avr_tool avr-size)
+AVR_NM=$(avr_tool avr-nm)
+
+for tool in "$AVR_SIZE" "$AVR_NM"; do
+    if ! command -v "$tool" >/dev/null 2>&1; then
+        echo "run.sh: $tool not found (set AVR_BIN to the avr-gcc bin directory)" >&2
+        exit 1
+    fi
+done
+
+echo
+bench/cycles .pio/build/bench/firmware.elf "$WAVEFORM"
+
+for env in $ENVS; do
+
+    ELF=.pio/build/$env/firmware.elf
+
+    [ -f "$ELF" ] || "$PIO" run -e "$env"
+
+    echo
+    echo "== $env"
+    "$AVR_SIZE" -C --mcu=atmega328p "$ELF" | grep -E 'Program|Data'
+
+done
+
+# Taille du code de chaque méthode de debouncing, et des méthodes mesurées.
+echo
+echo "== code size (bytes)"
+"$AVR_NM" --size-sort -C -S .pio/build/bench/firmware.elf \
+    | grep -E '_debounce|Button::read|Led::light' \
+    | while read -r address size type name; do printf '%6d  %s\n' "0x$size" "$name"; done
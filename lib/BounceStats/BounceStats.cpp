@@ -0,0 +1,190 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe BounceStats
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe BounceStats avant de les définir.
+ */
+#include "BounceStats.h"
+
+void BounceStats::Metrics::reset() {
+
+    bounces.reset();
+    settle_us.reset();
+    gap_us.reset();
+
+    bounces_hist.reset();
+    settle_hist.reset();
+    gap_hist.reset();
+
+}
+
+void BounceStats::Metrics::add(const uint32_t bounces, const uint32_t settle_us, const uint32_t gap_us) {
+
+    this->bounces.add(bounces);
+    this->settle_us.add(settle_us);
+    this->gap_us.add(gap_us);
+
+    bounces_hist.add(bounces);
+    settle_hist.add(settle_us);
+    gap_hist.add(gap_us);
+
+}
+
+BounceStats::BounceStats(const uint32_t quiet_us) : _quiet_us(quiet_us), _level(0) {
+    reset();
+}
+
+void BounceStats::reset() {
+
+    _press.reset();
+    _release.reset();
+
+    _glitches = 0;
+    _active   = false;
+
+}
+
+bool BounceStats::sample(const uint32_t now_us, const uint8_t input) {
+
+    if (input != _level) {
+
+        if (!_active) {
+
+            // Première transition : ouverture d'une salve.
+            _active      = true;
+            _start_level = _level;
+            _edges       = 0;
+            _first_us    = now_us;
+            _gap_us      = 0;
+
+        } else if (now_us - _last_us > _gap_us) {
+
+            _gap_us = now_us - _last_us;
+
+        }
+
+        _edges++;
+        _last_us = now_us;
+        _level   = input;
+
+        return false;
+
+    }
+
+    if (!_active || now_us - _last_us < _quiet_us) return false;
+
+    // Le signal est stable depuis assez longtemps : la salve est refermée.
+    _active = false;
+
+    if (_level == _start_level) {
+        _glitches++;
+    } else {
+        (_level ? _press : _release).add(_edges - 1, _last_us - _first_us, _gap_us);
+    }
+
+    return true;
+
+}
+
+const BounceStats::Metrics &BounceStats::press() const {
+    return _press;
+}
+
+const BounceStats::Metrics &BounceStats::release() const {
+    return _release;
+}
+
+uint32_t BounceStats::glitches() const {
+    return _glitches;
+}
+
+BounceStats::Profile BounceStats::profile() const {
+
+    Profile profile;
+
+    profile.press_bounces     = _press.bounces;
+    profile.press_settle_us   = _press.settle_us;
+    profile.press_gap_us      = _press.gap_us;
+    profile.release_bounces   = _release.bounces;
+    profile.release_settle_us = _release.settle_us;
+    profile.release_gap_us    = _release.gap_us;
+    profile.glitches          = _glitches;
+
+    return profile;
+
+}
+
+void BounceStats::restore(const Profile &profile) {
+
+    reset();
+
+    _press.bounces     = profile.press_bounces;
+    _press.settle_us   = profile.press_settle_us;
+    _press.gap_us      = profile.press_gap_us;
+    _release.bounces   = profile.release_bounces;
+    _release.settle_us = profile.release_settle_us;
+    _release.gap_us    = profile.release_gap_us;
+    _glitches          = profile.glitches;
+
+}
+
+void BounceStats::_report(Print &out, const __FlashStringHelper *name, const RunningStat &stat, const Log2Histogram &hist) {
+
+    out.print(name);
+    out.print(F(" n="));
+    out.print(stat.count());
+    out.print(F(" avg="));
+    out.print(stat.mean(), 1);
+    out.print(F(" sd="));
+    out.print(stat.stddev(), 1);
+    out.print(F(" min="));
+    out.print(stat.min());
+    out.print(F(" max="));
+    out.print(stat.max());
+    out.print(F(" |"));
+
+    for (uint8_t bin=0; bin<Log2Histogram::BINS; bin++) {
+
+        uint16_t count = hist.count(bin);
+        if (!count) continue;
+
+        out.print(' ');
+        out.print(bin);
+        out.print(':');
+        out.print(count);
+
+    }
+
+    out.println();
+
+}
+
+void BounceStats::report(Print &out) const {
+
+    const Metrics *metrics[] = { &_press, &_release };
+
+    for (uint8_t i=0; i<2; i++) {
+
+        const Metrics &m = *metrics[i];
+
+        out.println(i ? F("[release]") : F("[press]"));
+        _report(out, F("bounces"), m.bounces,   m.bounces_hist);
+        _report(out, F("settle "), m.settle_us, m.settle_hist);
+        _report(out, F("gap    "), m.gap_us,    m.gap_hist);
+
+    }
+
+    out.print(F("glitches="));
+    out.println(_glitches);
+
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la caractérisation statistique
+ * des rebonds d'un bouton, appui après appui
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe BounceStats
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "RunningStat.h"
+#include "Log2Histogram.h"
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe BounceStats.
+ *
+ * @note Le signal brut du bouton est échantillonné aussi souvent que possible.
+ *       Chaque changement d'état ouvre (ou prolonge) une "salve" de rebonds,
+ *       qui se referme lorsque le signal est resté stable pendant `quiet_us`
+ *       microsecondes. La salve est alors caractérisée par :
+ *
+ *           - le nombre de rebonds (transitions au-delà de la première),
+ *           - la durée de stabilisation (de la première à la dernière transition),
+ *           - le plus long intervalle entre deux transitions successives.
+ *
+ *       Ces trois grandeurs alimentent une moyenne et une variance glissantes,
+ *       ainsi qu'un histogramme logarithmique, séparément pour les appuis
+ *       (salves qui se stabilisent au niveau `HIGH`) et pour les relâchements.
+ *       Une salve qui se stabilise au niveau de départ est un simple parasite :
+ *       elle est seulement dénombrée.
+ *
+ *       Aucun échantillon n'est conservé : la mémoire occupée est la même
+ *       après dix appuis ou après dix mille.
+ */
+class BounceStats {
+
+    public:
+
+        /**
+         * @brief Statistiques d'un type de salve (appui ou relâchement).
+         */
+        struct Metrics {
+
+            RunningStat   bounces;      // Nombre de rebonds.
+            RunningStat   settle_us;    // Durée de stabilisation.
+            RunningStat   gap_us;       // Plus long intervalle entre deux transitions.
+
+            Log2Histogram bounces_hist;
+            Log2Histogram settle_hist;
+            Log2Histogram gap_hist;
+
+            void reset();
+            void add(const uint32_t bounces, const uint32_t settle_us, const uint32_t gap_us);
+
+        };
+
+        /**
+         * @brief Résumé persistant des statistiques (sans les histogrammes).
+         *
+         * @note C'est ce résumé qui peut être sauvegardé en EEPROM (voir la
+         *       classe RecordLog) pour retrouver les statistiques d'un bouton
+         *       après une réinitialisation de la carte.
+         */
+        struct Profile {
+
+            RunningStat press_bounces;
+            RunningStat press_settle_us;
+            RunningStat press_gap_us;
+            RunningStat release_bounces;
+            RunningStat release_settle_us;
+            RunningStat release_gap_us;
+            uint32_t    glitches;
+
+        };
+
+    private:
+
+        /**
+         * @brief Durée de stabilité qui referme une salve (exprimée en microsecondes).
+         */
+        uint32_t _quiet_us;
+
+        /**
+         * @brief Statistiques des appuis.
+         */
+        Metrics _press;
+
+        /**
+         * @brief Statistiques des relâchements.
+         */
+        Metrics _release;
+
+        /**
+         * @brief Nombre de parasites (salves sans changement d'état final).
+         */
+        uint32_t _glitches;
+
+        /**
+         * @brief Dernier niveau observé.
+         */
+        uint8_t _level;
+
+        /**
+         * @brief Niveau stable avant l'ouverture de la salve en cours.
+         */
+        uint8_t _start_level;
+
+        /**
+         * @brief Indique si une salve est en cours.
+         */
+        bool _active;
+
+        /**
+         * @brief Nombre de transitions de la salve en cours.
+         */
+        uint16_t _edges;
+
+        /**
+         * @brief Date de la première transition de la salve en cours.
+         */
+        uint32_t _first_us;
+
+        /**
+         * @brief Date de la dernière transition de la salve en cours.
+         */
+        uint32_t _last_us;
+
+        /**
+         * @brief Plus long intervalle entre deux transitions de la salve en cours.
+         */
+        uint32_t _gap_us;
+
+        /**
+         * @brief Affichage des statistiques d'une grandeur.
+         */
+        static void _report(Print &out, const __FlashStringHelper *name, const RunningStat &stat, const Log2Histogram &hist);
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param quiet_us Durée de stabilité qui referme une salve (exprimée en microsecondes).
+         */
+        BounceStats(const uint32_t quiet_us);
+
+        /**
+         * @brief Oubli de toutes les salves.
+         */
+        void reset();
+
+        /**
+         * @brief Prise en compte d'un échantillon du signal brut.
+         *
+         * @param now_us Date de l'échantillon (exprimée en microsecondes).
+         * @param input  Niveau logique du signal brut.
+         *
+         * @return true si une salve vient de se refermer.
+         */
+        bool sample(const uint32_t now_us, const uint8_t input);
+
+        /**
+         * @brief Statistiques des appuis.
+         */
+        const Metrics &press() const;
+
+        /**
+         * @brief Statistiques des relâchements.
+         */
+        const Metrics &release() const;
+
+        /**
+         * @brief Nombre de parasites.
+         */
+        uint32_t glitches() const;
+
+        /**
+         * @brief Résumé persistant des statistiques.
+         */
+        Profile profile() const;
+
+        /**
+         * @brief Restauration des statistiques à partir d'un résumé.
+         *
+         * @param profile Résumé des statistiques.
+         *
+         * @note Les histogrammes, qui ne font pas partie du résumé, sont remis à zéro.
+         */
+        void restore(const Profile &profile);
+
+        /**
+         * @brief Affichage d'un résumé compact des statistiques.
+         *
+         * @param out Flux de sortie (Serial, par exemple).
+         *
+         * @note Pour chaque grandeur : effectif, moyenne, écart-type, minimum,
+         *       maximum, puis les classes non vides de l'histogramme sous la
+         *       forme `classe:effectif`.
+         */
+        void report(Print &out) const;
+
+};
\ No newline at end of file
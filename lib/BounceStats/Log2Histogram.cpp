@@ -0,0 +1,47 @@
+/*
+ * ------------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ------------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ------------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe Log2Histogram
+ * ------------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe Log2Histogram avant de les définir.
+ */
+#include "Log2Histogram.h"
+
+Log2Histogram::Log2Histogram() {
+    reset();
+}
+
+void Log2Histogram::reset() {
+    memset(_bins, 0, sizeof(_bins));
+}
+
+void Log2Histogram::add(const uint32_t value) {
+
+    uint16_t &bin = _bins[binOf(value)];
+
+    if (bin != 0xffff) bin++;
+
+}
+
+uint16_t Log2Histogram::count(const uint8_t bin) const {
+    return _bins[bin];
+}
+
+uint8_t Log2Histogram::binOf(const uint32_t value) {
+
+    // Indice du bit de poids fort, plus un.
+    uint8_t bin = 0;
+    for (uint32_t v = value; v && bin < BINS - 1; v >>= 1) bin++;
+
+    return bin;
+
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la répartition d'une série de
+ * mesures en classes de largeur croissante (échelle logarithmique)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Log2Histogram
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe Log2Histogram.
+ *
+ * @note La classe 0 reçoit les mesures nulles, et la classe k (de 1 à 14)
+ *       les mesures comprises dans l'intervalle [2^(k-1), 2^k[. La dernière
+ *       classe reçoit toutes les mesures supérieures ou égales à 2^14 (16384).
+ *
+ *       Exprimées en microsecondes, les classes couvrent ainsi aussi bien
+ *       les rebonds d'une microseconde que ceux de plusieurs millisecondes,
+ *       avec seulement 16 compteurs.
+ */
+class Log2Histogram {
+
+    public:
+
+        /**
+         * @brief Nombre de classes.
+         */
+        static const uint8_t BINS = 16;
+
+    private:
+
+        /**
+         * @brief Effectif de chaque classe.
+         *
+         * @note Les compteurs saturent à 65535 au lieu de déborder.
+         */
+        uint16_t _bins[BINS];
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         */
+        Log2Histogram();
+
+        /**
+         * @brief Remise à zéro de toutes les classes.
+         */
+        void reset();
+
+        /**
+         * @brief Prise en compte d'une nouvelle mesure.
+         *
+         * @param value Valeur de la mesure.
+         */
+        void add(const uint32_t value);
+
+        /**
+         * @brief Effectif d'une classe.
+         *
+         * @param bin Indice de la classe.
+         */
+        uint16_t count(const uint8_t bin) const;
+
+        /**
+         * @brief Indice de la classe d'une mesure.
+         *
+         * @param value Valeur de la mesure.
+         */
+        static uint8_t binOf(const uint32_t value);
+
+};
\ No newline at end of file
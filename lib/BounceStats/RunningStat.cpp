@@ -0,0 +1,68 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe RunningStat
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe RunningStat avant de les définir.
+ */
+#include "RunningStat.h"
+
+RunningStat::RunningStat() {
+    reset();
+}
+
+void RunningStat::reset() {
+    _count = 0;
+    _mean  = 0;
+    _m2    = 0;
+    _min   = 0;
+    _max   = 0;
+}
+
+void RunningStat::add(const uint32_t value) {
+
+    if (!_count || value < _min) _min = value;
+    if (value > _max) _max = value;
+
+    _count++;
+
+    // Méthode de Welford : l'écart à l'ancienne moyenne et l'écart à la
+    // nouvelle moyenne mettent à jour la somme des carrés des écarts.
+    float delta = value - _mean;
+    _mean += delta / _count;
+    _m2   += delta * (value - _mean);
+
+}
+
+uint32_t RunningStat::count() const {
+    return _count;
+}
+
+float RunningStat::mean() const {
+    return _mean;
+}
+
+float RunningStat::variance() const {
+    return _count > 1 ? _m2 / (_count - 1) : 0;
+}
+
+float RunningStat::stddev() const {
+    return sqrt(variance());
+}
+
+uint32_t RunningStat::min() const {
+    return _min;
+}
+
+uint32_t RunningStat::max() const {
+    return _max;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour le calcul incrémental de la
+ * moyenne et de la variance d'une série de mesures
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe RunningStat
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe RunningStat.
+ *
+ * @note Les mesures ne sont pas conservées : chacune d'elles met à jour la
+ *       moyenne et la somme des carrés des écarts à la moyenne, selon la
+ *       méthode de B. P. Welford. Contrairement au calcul naïf (somme des
+ *       carrés moins carré de la somme), elle reste précise en simple
+ *       précision, même après des milliers de mesures.
+ *
+ *       Chaque instance n'occupe que 20 octets, quel que soit le nombre de
+ *       mesures.
+ */
+class RunningStat {
+
+    private:
+
+        /**
+         * @brief Nombre de mesures.
+         */
+        uint32_t _count;
+
+        /**
+         * @brief Moyenne des mesures.
+         */
+        float _mean;
+
+        /**
+         * @brief Somme des carrés des écarts à la moyenne.
+         */
+        float _m2;
+
+        /**
+         * @brief Plus petite mesure.
+         */
+        uint32_t _min;
+
+        /**
+         * @brief Plus grande mesure.
+         */
+        uint32_t _max;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         */
+        RunningStat();
+
+        /**
+         * @brief Oubli de toutes les mesures.
+         */
+        void reset();
+
+        /**
+         * @brief Prise en compte d'une nouvelle mesure.
+         *
+         * @param value Valeur de la mesure.
+         */
+        void add(const uint32_t value);
+
+        /**
+         * @brief Nombre de mesures.
+         */
+        uint32_t count() const;
+
+        /**
+         * @brief Moyenne des mesures.
+         */
+        float mean() const;
+
+        /**
+         * @brief Variance (non biaisée) des mesures.
+         */
+        float variance() const;
+
+        /**
+         * @brief Écart-type des mesures.
+         */
+        float stddev() const;
+
+        /**
+         * @brief Plus petite mesure (0 s'il n'y en a aucune).
+         */
+        uint32_t min() const;
+
+        /**
+         * @brief Plus grande mesure.
+         */
+        uint32_t max() const;
+
+};
\ No newline at end of file
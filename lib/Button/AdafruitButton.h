@@ -64,7 +64,7 @@ class AdafruitButton : public Button {
          *       à partir du signal lu à l'itération (n), il faut avoir mémorisé la valeur
          *       qu'il avait à l'itération (n-1).
          */
-        uint8_t _last_input;
+        uint8_t _last_input = 0;
 
         /**
          * @brief Origine temporelle absolue de la fenêtre de stabilisation (exprimée en millisecondes).
@@ -75,7 +75,7 @@ class AdafruitButton : public Button {
          *       écoulée depuis la dernière mesure stabilisée, il faut avoir mémorisé à
          *       quel moment cette lecture a été faite.
          */
-        uint32_t _last_debounce_ms;
+        uint32_t _last_debounce_ms = 0;
 
     protected:
 
@@ -16,15 +16,23 @@
  */
 #include "Button.h"
 
-Button::Button(const uint8_t pin) {
-    pinMode(_pin = pin, INPUT);
+#ifdef BUTTON_TRACE
+#include "ButtonTrace.h"
+#endif
+
+void Button::configure(PinSetup &pins) const {
+    if (_pin != NO_PIN) pins.input(_pin);
 }
 
 void Button::_update() {
 
     switch (_state) {
         case _State::free:
-            if (_output) _state = _State::pressed;
+        case _State::released:
+            if (_output) {
+                _state = _State::pressed;
+                if (_presses < 255) _presses++;
+            } else _state = _State::free;
             break;
         case _State::pressed:
             if (_output) {
@@ -35,16 +43,34 @@ void Button::_update() {
         case _State::held:
             if (!_output) _state = _State::released;
             break;
-        case _State::released:
-            _state = _State::free;
-            break;
     }
 
 }
 
 void Button::read() {
-    _debounce(digitalRead(_pin));
+    read(digitalRead(_pin));
+}
+
+void Button::read(const uint8_t input) {
+
+#ifdef BUTTON_TRACE
+    _State state = _state;
+#endif
+
+    _debounce(input);
     _update();
+
+#ifdef BUTTON_TRACE
+    // Seuls les changements sont tracés : un bouton au repos, ou maintenu
+    // enfoncé, ne produit aucune trace.
+    uint8_t level = input ? 1 : 0;
+
+    if (level != _traced_input || _state != state) {
+        _traced_input = level;
+        buttonTrace({ this, (uint32_t) micros(), level, _output, _state });
+    }
+#endif
+
 }
 
 bool Button::isPressed() {
@@ -55,10 +81,23 @@ bool Button::isReleased() {
     return _state == _State::released;
 }
 
+bool Button::isFree() {
+    return _state == _State::free;
+}
+
 bool Button::isHeld() {
     return _state == _State::held;
 }
 
 bool Button::wasHeldFor(const uint16_t delay_ms) {
     return isHeld() && (millis() - _held_start_ms >= delay_ms);
+}
+
+uint8_t Button::takePresses() {
+
+    uint8_t presses = _presses;
+    _presses = 0;
+
+    return presses;
+
 }
\ No newline at end of file
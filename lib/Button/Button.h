@@ -19,6 +19,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include <PinSetup.h>
 
 /**
  * @brief Définition de la classe abstraite Button.
@@ -88,6 +89,22 @@ class Button {
          */
         uint32_t _held_start_ms;
 
+        /**
+         * @brief Nombre d'appuis enregistrés depuis le dernier appel de takePresses().
+         *
+         * @note Ce compteur sature à 255.
+         */
+        uint8_t _presses;
+
+#ifdef BUTTON_TRACE
+
+        /**
+         * @brief Dernier signal d'entrée tracé (voir ButtonTrace.h).
+         */
+        uint8_t _traced_input = 0;
+
+#endif
+
         /**
          * @brief Mise à jour de l'état du bouton.
          * 
@@ -97,6 +114,13 @@ class Button {
          *       le bouton (free, pressed, held, released).
          * 
          *       Cette méthode est précisément chargée de cette interprétation.
+         *
+         *       Chaque lecture fait évoluer l'état du bouton en fonction du seul
+         *       niveau de sortie, y compris depuis les états fugaces "pressed"
+         *       et "released" : un nouvel appui peut ainsi être enregistré dès
+         *       la lecture qui suit un relâchement. Il suffit donc que la sortie
+         *       reste une lecture au niveau haut, puis une lecture au niveau
+         *       bas, pour qu'aucun appui ne soit perdu.
          */
         void _update();
 
@@ -126,6 +150,11 @@ class Button {
     
     public:
 
+        /**
+         * @brief Broche d'un bouton virtuel.
+         */
+        static const uint8_t NO_PIN = 0xff;
+
         /**
          * @brief Déclaration du constructeur.
          * 
@@ -133,8 +162,33 @@ class Button {
          * 
          * @note Le constructeur attend un argument qui permet de préciser
          *       quelle sera la broche de lecture du bouton.
+         *
+         *       Il est évalué à la compilation (constexpr) et ne touche à
+         *       aucun registre : la broche n'est configurée qu'au démarrage
+         *       du programme, dans setup(), par configure().
+         */
+        constexpr Button(const uint8_t pin)
+            : _pin(pin), _state(free), _held_start_ms(0), _presses(0), _output(0) {}
+
+        /**
+         * @brief Déclaration du constructeur d'un bouton "virtuel".
+         *
+         * @note Un bouton virtuel n'est relié à aucune broche de la carte :
+         *       son signal d'entrée est lu par ailleurs (sur un expandeur de
+         *       ports, un clavier, etc.) puis transmis à la méthode read(input).
          */
-        Button(const uint8_t pin);
+        constexpr Button() : Button(NO_PIN) {}
+
+        /**
+         * @brief Déclare la broche de lecture du bouton, en entrée.
+         *
+         * @param pins Configuration des broches, appliquée par PinSetup::apply().
+         *
+         * @note Le bouton est câblé avec une résistance de rappel externe :
+         *       la résistance de tirage interne n'est pas activée. Un bouton
+         *       virtuel ne déclare aucune broche.
+         */
+        void configure(PinSetup &pins) const;
 
         /**
          * @brief Lecture de l'état du bouton.
@@ -150,9 +204,25 @@ class Button {
          *       La méthode read() se charge d'orchestrer toute cette procédure de
          *       lecture et d'interprétation des signaux pour finalement déterminer
          *       l'état du bouton.
+         *
+         *       Lorsque le symbole BUTTON_TRACE est défini, chaque changement du
+         *       signal d'entrée ou de l'état du bouton est transmis à la fonction
+         *       buttonTrace() (voir ButtonTrace.h).
          */
         void read();
 
+        /**
+         * @brief Lecture de l'état du bouton à partir d'un signal d'entrée lu par ailleurs.
+         *
+         * @param input Niveau logique du signal d'entrée brut.
+         *
+         * @note Cette méthode effectue exactement le même traitement que read(),
+         *       mais le signal d'entrée lui est directement fourni, au lieu d'être
+         *       lu par la fonction digitalRead(). C'est ainsi qu'on lit un bouton
+         *       virtuel.
+         */
+        void read(const uint8_t input);
+
         /**
          * @brief Détermine si le bouton vient d'être enfoncé.
          * 
@@ -175,6 +245,16 @@ class Button {
          */
         bool isReleased();
         
+        /**
+         * @brief Détermine si le bouton est au repos.
+         *
+         * @return true  si le bouton est au repos,
+         *         false sinon.
+         *
+         * @note Cet état est prolongé tant que le bouton n'est pas enfoncé.
+         */
+        bool isFree();
+
         /**
          * @brief Détermine si le bouton est maintenu enfoncé.
          * 
@@ -196,4 +276,27 @@ class Button {
          */
         bool wasHeldFor(const uint16_t delay_ms);
 
+        /**
+         * @brief Nombre d'appuis enregistrés depuis le dernier appel de cette méthode.
+         *
+         * @return Le nombre d'appuis (au plus 255), remis à zéro par l'appel.
+         *
+         * @note isPressed() n'est vrai que durant une seule lecture : si le
+         *       programme principal ne consulte pas le bouton après chaque
+         *       lecture, il peut manquer des appuis. Ce compteur permet de
+         *       les récupérer tous, à son rythme.
+         *
+         *       La cadence maximale des appuis dépend de la fréquence des
+         *       lectures et du nombre de lectures nécessaires au déparasitage
+         *       de chaque niveau (N lectures) :
+         *
+         *           cadence maximale = fréquence des lectures / (2 x N)
+         *
+         *       Avec une lecture toutes les 100 µs et un seuil de 16 lectures
+         *       (KuhnButton), on enregistre ainsi jusqu'à 312 appuis par seconde.
+         *       L'interprétation de la sortie, elle, suit jusqu'à un appui
+         *       toutes les deux lectures.
+         */
+        uint8_t takePresses();
+
 };
\ No newline at end of file
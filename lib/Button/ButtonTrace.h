@@ -0,0 +1,185 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition des traces émises par la méthode Button::read() lorsque le
+ * symbole BUTTON_TRACE est défini, et d'un tampon pour les recueillir
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe ButtonTraceRing
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+class Button;
+
+/**
+ * @brief Trace d'une lecture de bouton.
+ *
+ * @note L'état du bouton est codé comme dans la classe Button :
+ *
+ *           0 : free, 1 : pressed, 2 : held, 3 : released
+ */
+struct ButtonTrace {
+    const Button *button;  // Bouton lu.
+    uint32_t time_us;      // Date de la lecture (exprimée en microsecondes).
+    uint8_t  input;        // Signal d'entrée brut (0 ou 1).
+    uint8_t  output;       // Signal de sortie déparasité.
+    uint8_t  state;        // État du bouton après la lecture.
+};
+
+#ifdef BUTTON_TRACE
+
+/**
+ * @brief Destinataire des traces, défini par le programme principal.
+ *
+ * @param trace Trace de la lecture.
+ *
+ * @note Lorsque le symbole BUTTON_TRACE est défini (pour tout le projet,
+ *       par les options de l'environnement PlatformIO), Button::read()
+ *       appelle cette fonction chaque fois que le signal d'entrée ou l'état
+ *       d'un bouton change, quelle que soit la méthode de déparasitage.
+ *       Le programme la définit à sa guise : dépôt dans un ButtonTraceRing,
+ *       écriture sur la liaison série, ou dans un fichier sur un ordinateur.
+ *
+ *       Elle est appelée dans le contexte de la lecture (éventuellement une
+ *       routine d'interruption) : elle doit donc être brève.
+ *
+ *       Sans le symbole BUTTON_TRACE, les appels disparaissent et la
+ *       fonction n'a pas à être définie : le firmware ne paie rien.
+ */
+void buttonTrace(const ButtonTrace &trace);
+
+#endif
+
+/**
+ * @brief Définition de la classe ButtonTraceRing.
+ *
+ * @tparam SIZE Nombre de traces conservées (puissance de 2, de 1 à 128).
+ *
+ * @note Tampon circulaire de traces, à un seul producteur (buttonTrace())
+ *       et un seul consommateur (la boucle principale, qui restitue les
+ *       traces à son rythme). Lorsque le tampon est plein, les nouvelles
+ *       traces sont perdues, et comptées : les plus anciennes, qui portent
+ *       le début de l'événement observé, sont conservées.
+ *
+ *       Chaque trace occupe 9 octets.
+ */
+template <uint8_t SIZE>
+class ButtonTraceRing {
+
+    static_assert(SIZE >= 1 && SIZE <= 128 && !(SIZE & (SIZE - 1)), "trace ring size must be a power of 2, up to 128");
+
+    private:
+
+        /**
+         * @brief Traces du tampon.
+         */
+        ButtonTrace _traces[SIZE];
+
+        /**
+         * @brief Indice d'écriture (modifié par le producteur seulement).
+         */
+        volatile uint8_t _head;
+
+        /**
+         * @brief Indice de lecture (modifié par le consommateur seulement).
+         */
+        volatile uint8_t _tail;
+
+        /**
+         * @brief Nombre de traces perdues (plafonné à 255).
+         */
+        volatile uint8_t _lost;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         */
+        ButtonTraceRing() : _head(0), _tail(0), _lost(0) {}
+
+        /**
+         * @brief Dépose une trace (producteur).
+         *
+         * @return false si le tampon est plein (la trace est perdue).
+         */
+        bool push(const ButtonTrace &trace) {
+
+            uint8_t head = _head;
+
+            if ((uint8_t) (head - _tail) == SIZE) {
+                if (_lost < 0xff) _lost++;
+                return false;
+            }
+
+            _traces[head & (SIZE - 1)] = trace;
+
+            // La trace est recopiée avant que l'indice ne la publie.
+            asm volatile("" ::: "memory");
+            _head = head + 1;
+
+            return true;
+
+        }
+
+        /**
+         * @brief Extrait la trace la plus ancienne (consommateur).
+         *
+         * @param trace Trace extraite.
+         *
+         * @return false si le tampon est vide.
+         */
+        bool pop(ButtonTrace &trace) {
+
+            uint8_t tail = _tail;
+
+            if (tail == _head) return false;
+
+            asm volatile("" ::: "memory");
+            trace = _traces[tail & (SIZE - 1)];
+            asm volatile("" ::: "memory");
+
+            _tail = tail + 1;
+
+            return true;
+
+        }
+
+        /**
+         * @brief Nombre de traces en attente.
+         */
+        uint8_t size() const {
+            return (uint8_t) (_head - _tail);
+        }
+
+        /**
+         * @brief Nombre de traces perdues depuis le dernier appel de cette méthode.
+         */
+        uint8_t takeLost() {
+
+            uint8_t lost;
+
+            // Le producteur peut incrémenter le compteur entre sa lecture et
+            // sa remise à zéro : l'échange est fait interruptions masquées.
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                lost  = _lost;
+                _lost = 0;
+            }
+
+            return lost;
+
+        }
+
+};
\ No newline at end of file
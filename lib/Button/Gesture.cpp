@@ -0,0 +1,115 @@
+/*
+ * ------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe Gesture
+ * ------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe Gesture avant de les définir.
+ */
+#include "Gesture.h"
+
+Gesture::Gesture(
+    Button &button,
+    const uint16_t long_press_ms,
+    const uint16_t double_click_ms,
+    const uint16_t repeat_start_ms,
+    const uint16_t repeat_min_ms
+)
+: _button(button)
+, _long_press_ms(long_press_ms)
+, _double_click_ms(double_click_ms)
+, _repeat_start_ms(repeat_start_ms)
+, _repeat_min_ms(repeat_min_ms)
+, _state(_State::idle)
+, _clicks(0)
+, _start_ms(0)
+, _interval_ms(repeat_start_ms)
+, _repeats(0) {}
+
+GestureEvent Gesture::update() {
+    return update(millis());
+}
+
+GestureEvent Gesture::update(const uint16_t now_ms) {
+
+    uint16_t elapsed_ms = now_ms - _start_ms;
+
+    switch (_state) {
+
+        case _State::idle:
+        case _State::waiting:
+
+            if (_button.isPressed()) {
+                _clicks++;
+                _state    = _State::down;
+                _start_ms = now_ms;
+            } else if (_state == _State::waiting && elapsed_ms >= _double_click_ms) {
+                _clicks = 0;
+                _state  = _State::idle;
+                return GestureEvent::click;
+            }
+            break;
+
+        case _State::down:
+
+            if (_button.isReleased()) {
+                if (elapsed_ms >= _long_press_ms) {
+                    // Relâché juste après l'émission d'un clic en attente
+                    // (voir ci-dessous) : l'appui long n'est pas perdu.
+                    _clicks = 0;
+                    _state  = _State::idle;
+                    return GestureEvent::longPress;
+                }
+                if (_clicks == 2) {
+                    _clicks = 0;
+                    _state  = _State::idle;
+                    return GestureEvent::doubleClick;
+                }
+                _state    = _State::waiting;
+                _start_ms = now_ms;
+            } else if (elapsed_ms >= _long_press_ms) {
+                if (_clicks == 2) {
+                    // Un clic suivi d'un appui long : le clic en attente est
+                    // émis d'abord, l'appui long à l'appel suivant.
+                    _clicks = 1;
+                    return GestureEvent::click;
+                }
+                _clicks      = 0;
+                _repeats     = 0;
+                _state       = _State::repeating;
+                _start_ms    = now_ms;
+                _interval_ms = _repeat_start_ms;
+                return GestureEvent::longPress;
+            }
+            break;
+
+        case _State::repeating:
+
+            if (_button.isReleased()) {
+                _state = _State::idle;
+            } else if (elapsed_ms >= _interval_ms) {
+                _repeats++;
+                _start_ms     = now_ms;
+                _interval_ms -= _interval_ms >> 2;
+                if (_interval_ms < _repeat_min_ms) _interval_ms = _repeat_min_ms;
+                return GestureEvent::repeat;
+            }
+            break;
+
+    }
+
+    return GestureEvent::none;
+
+}
+
+uint16_t Gesture::repeats() const {
+    return _repeats;
+}
\ No newline at end of file
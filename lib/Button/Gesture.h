@@ -0,0 +1,158 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la reconnaissance des gestes
+ * effectués sur un bouton (clic, double clic, appui long, répétition)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Gesture
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Button.h"
+#include <Arduino.h>
+
+/**
+ * @brief Gestes reconnus sur un bouton.
+ */
+enum class GestureEvent : uint8_t { none, click, doubleClick, longPress, repeat };
+
+/**
+ * @brief Définition de la classe Gesture.
+ *
+ * @note Un objet Gesture observe un bouton déjà lu par ailleurs (la méthode
+ *       update() doit être appelée juste après read()) et traduit la suite
+ *       de ses états en gestes :
+ *
+ *           - clic        : appui bref, non suivi d'un second appui dans
+ *                           le délai de double clic,
+ *           - double clic : deux appuis brefs dans le délai de double clic,
+ *           - appui long  : bouton maintenu enfoncé pendant le délai
+ *                           d'appui long,
+ *           - répétition  : émise tant que le bouton reste enfoncé après un
+ *                           appui long, à un rythme qui s'accélère.
+ *
+ *       Un clic n'est émis qu'à l'expiration du délai de double clic : c'est
+ *       le prix à payer pour distinguer les deux gestes. Un clic suivi, dans
+ *       ce délai, d'un appui long produit un clic, puis un appui long.
+ *
+ *       L'intervalle entre deux répétitions commence à `repeat_start_ms`,
+ *       puis diminue d'un quart à chaque répétition, jusqu'à `repeat_min_ms` :
+ *
+ *           200, 150, 113, 85, 64, 48, 36, 27, 21, 20, 20... ms
+ *
+ *       Chaque appel de update() coûte une seule lecture de millis() et
+ *       quelques comparaisons, quel que soit le geste en cours. Les dates
+ *       sont mémorisées sur 16 bits : les délais ne doivent pas dépasser
+ *       65 secondes.
+ */
+class Gesture {
+
+    private:
+
+        /**
+         * @brief Définition des étapes de la reconnaissance d'un geste.
+         */
+        enum _State : uint8_t { idle, down, waiting, repeating };
+
+        /**
+         * @brief Bouton observé.
+         */
+        Button &_button;
+
+        /**
+         * @brief Délai d'appui long (exprimé en millisecondes).
+         */
+        uint16_t _long_press_ms;
+
+        /**
+         * @brief Délai de double clic (exprimé en millisecondes).
+         */
+        uint16_t _double_click_ms;
+
+        /**
+         * @brief Intervalle initial entre deux répétitions (exprimé en millisecondes).
+         */
+        uint16_t _repeat_start_ms;
+
+        /**
+         * @brief Intervalle minimal entre deux répétitions (exprimé en millisecondes).
+         */
+        uint16_t _repeat_min_ms;
+
+        /**
+         * @brief Étape en cours.
+         */
+        _State _state;
+
+        /**
+         * @brief Nombre d'appuis du geste en cours.
+         */
+        uint8_t _clicks;
+
+        /**
+         * @brief Date du début de l'étape en cours, ou de la dernière répétition.
+         */
+        uint16_t _start_ms;
+
+        /**
+         * @brief Intervalle courant entre deux répétitions (exprimé en millisecondes).
+         */
+        uint16_t _interval_ms;
+
+        /**
+         * @brief Nombre de répétitions émises depuis le dernier appui long.
+         */
+        uint16_t _repeats;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param button          Bouton observé.
+         * @param long_press_ms   Délai d'appui long.
+         * @param double_click_ms Délai de double clic.
+         * @param repeat_start_ms Intervalle initial entre deux répétitions.
+         * @param repeat_min_ms   Intervalle minimal entre deux répétitions.
+         */
+        Gesture(
+            Button &button,
+            const uint16_t long_press_ms   = 500,
+            const uint16_t double_click_ms = 250,
+            const uint16_t repeat_start_ms = 200,
+            const uint16_t repeat_min_ms   = 20
+        );
+
+        /**
+         * @brief Reconnaissance des gestes, après la lecture du bouton.
+         *
+         * @return Le geste qui vient d'être reconnu, ou GestureEvent::none.
+         */
+        GestureEvent update();
+
+        /**
+         * @brief Reconnaissance des gestes, à une date fournie par l'appelant.
+         *
+         * @param now_ms Date courante (exprimée en millisecondes).
+         *
+         * @return Le geste qui vient d'être reconnu, ou GestureEvent::none.
+         */
+        GestureEvent update(const uint16_t now_ms);
+
+        /**
+         * @brief Nombre de répétitions émises depuis le dernier appui long.
+         */
+        uint16_t repeats() const;
+
+};
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la lecture d'un bouton avec un
+ * filtre passe-bas numérique suivi d'un trigger de Schmitt
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe IirButton
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Button.h"
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe IirButton.
+ *
+ * @tparam SHIFT Constante de temps du filtre (2^SHIFT échantillons), de 1 à 6.
+ * @tparam UPPER Seuil de basculement de la sortie à 1.
+ * @tparam LOWER Seuil de basculement de la sortie à 0.
+ *
+ * @note C'est la transposition numérique du classique filtre RC suivi d'un
+ *       trigger de Schmitt. Le signal d'entrée (0 ou 255) est lissé par un
+ *       filtre passe-bas du premier ordre, à réponse impulsionnelle infinie
+ *       (IIR), calculé en virgule fixe sur un octet :
+ *
+ *           y = y + (x - y) / 2^SHIFT
+ *
+ *       La division se réduit à un décalage. La sortie passe à 1 lorsque y
+ *       atteint le seuil UPPER, et ne revient à 0 que lorsque y redescend au
+ *       seuil LOWER : l'écart entre les deux seuils (hystérésis) empêche la
+ *       sortie d'osciller lorsque y hésite autour d'un seuil.
+ *
+ *       Chaque échantillon discordant n'écarte y que d'une fraction de sa
+ *       distance à la cible : un parasite isolé est absorbé, alors qu'un
+ *       signal durablement inversé finit par franchir le seuil.
+ *
+ *       Du fait de la troncature, y ne dépasse jamais 256 - 2^SHIFT, et ne
+ *       descend jamais sous 2^SHIFT - 1 : les seuils doivent être compris
+ *       entre ces deux bornes.
+ */
+template <uint8_t SHIFT = 3, uint8_t UPPER = 192, uint8_t LOWER = 64>
+class IirButton : public Button {
+
+    static_assert(SHIFT >= 1 && SHIFT <= 6, "filter time constant must be 2 to 64 samples");
+    static_assert(LOWER < UPPER, "Schmitt trigger thresholds are inverted");
+    static_assert(UPPER <= 256 - (1 << SHIFT) && LOWER >= (1 << SHIFT), "thresholds are out of reach of the filter");
+
+    private:
+
+        /**
+         * @brief État du filtre (0 à 255).
+         */
+        uint8_t _y = 0;
+
+    protected:
+
+        /**
+         * @brief Déparasitage du signal électronique provenant du bouton.
+         *
+         * @param input Niveau logique du signal d'entrée brut (lu directement).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode _debounce() déclarée par le modèle parent Button.
+         */
+        void _debounce(const uint8_t input) override {
+
+            if (input) _y += (uint8_t) (255 - _y) >> SHIFT;
+            else       _y -= _y >> SHIFT;
+
+                 if (_y >= UPPER) _output = 1;
+            else if (_y <= LOWER) _output = 0;
+
+        }
+
+    public:
+
+        /**
+         * @brief Propage le constructeur défini par le modèle parent Button.
+         */
+        using Button::Button;
+
+};
\ No newline at end of file
@@ -70,7 +70,7 @@ class KuhnButton : public Button {
          *       le signal d'entrée doit être maintenu dans un état logique (0 ou 1)
          *       constant pour que la sortie passe à cet état par effet de seuil.
          */
-        uint8_t _integrator;
+        uint8_t _integrator = 0;
 
     protected:
 
@@ -0,0 +1,141 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la lecture d'un bouton avec une
+ * méthode de debouncing "au premier front" suivie d'une période d'inhibition
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe LeadingEdgeButton
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Button.h"
+#include <Arduino.h>
+
+/**
+ * @brief Politiques de déparasitage d'un changement d'état.
+ *
+ * @note leading  : le changement est pris en compte dès le premier front, puis
+ *                  le signal d'entrée est ignoré pendant N échantillons,
+ *       trailing : le changement n'est pris en compte qu'une fois que le signal
+ *                  d'entrée a conservé le nouvel état pendant N échantillons.
+ */
+enum class EdgePolicy : uint8_t { leading, trailing };
+
+/**
+ * @brief Définition de la classe LeadingEdgeButton.
+ *
+ * @tparam PRESS           Politique appliquée à l'appui.
+ * @tparam PRESS_SAMPLES   Nombre d'échantillons associé à la politique d'appui.
+ * @tparam RELEASE         Politique appliquée au relâchement.
+ * @tparam RELEASE_SAMPLES Nombre d'échantillons associé à la politique de relâchement.
+ * @tparam GLITCH_FILTER   Si true, un front n'est pris en compte par la politique
+ *                         `leading` que s'il est confirmé par l'échantillon suivant.
+ *
+ * @note Les algorithmes de Kuhn et d'Adafruit attendent que les rebonds soient
+ *       terminés pour signaler l'appui : le signal de sortie est en retard d'au
+ *       moins 16 échantillons (KuhnButton) ou de `_DEBOUNCE_DELAY_MS`
+ *       (AdafruitButton) sur le premier front.
+ *
+ *       Or un bouton au repos ne produit pas de front : le premier front est
+ *       donc forcément le début d'un appui. La politique `leading` signale
+ *       l'appui dès ce premier front, soit avec un retard d'un seul
+ *       échantillon, puis ignore le signal pendant toute la durée des rebonds
+ *       (période d'inhibition, ou "lockout").
+ *
+ *       Les politiques de l'appui et du relâchement sont indépendantes : on
+ *       peut par exemple réagir immédiatement à l'appui, mais n'accepter le
+ *       relâchement qu'une fois le signal stabilisé.
+ *
+ *       La politique `leading` est sensible aux parasites : une impulsion
+ *       isolée d'un seul échantillon suffit à provoquer un appui. Le filtre
+ *       optionnel exige que le front soit confirmé par l'échantillon suivant,
+ *       au prix d'un échantillon de retard supplémentaire.
+ */
+template <EdgePolicy PRESS = EdgePolicy::leading, uint8_t PRESS_SAMPLES = 16,
+          EdgePolicy RELEASE = EdgePolicy::leading, uint8_t RELEASE_SAMPLES = 16,
+          bool GLITCH_FILTER = false>
+class LeadingEdgeButton : public Button {
+
+    private:
+
+        /**
+         * @brief Nombre d'échantillons restant à ignorer (politique `leading`).
+         */
+        uint8_t _lockout = 0;
+
+        /**
+         * @brief Nombre d'échantillons consécutifs dans le nouvel état (politique `trailing`).
+         */
+        uint8_t _stable = 0;
+
+        /**
+         * @brief Niveau logique de l'échantillon précédent (filtre de parasites).
+         */
+        uint8_t _last_input = 0;
+
+    protected:
+
+        /**
+         * @brief Déparasitage du signal électronique provenant du bouton.
+         *
+         * @param input Niveau logique du signal d'entrée brut (lu directement).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode _debounce() déclarée par le modèle parent Button.
+         */
+        void _debounce(const uint8_t input) override {
+
+            uint8_t last = _last_input;
+            _last_input  = input;
+
+            // Période d'inhibition : le signal d'entrée est ignoré.
+            if (_lockout) {
+                _lockout--;
+                return;
+            }
+
+            if (input == _output) {
+                _stable = 0;
+                return;
+            }
+
+            // Le signal d'entrée diffère du signal de sortie : c'est un appui
+            // si la sortie est au repos, un relâchement sinon.
+            EdgePolicy policy  = _output ? RELEASE : PRESS;
+            uint8_t    samples = _output ? RELEASE_SAMPLES : PRESS_SAMPLES;
+
+            if (policy == EdgePolicy::leading) {
+
+                if (GLITCH_FILTER && last != input) return;
+
+                _output  = input;
+                _lockout = samples;
+
+            } else if (++_stable >= samples) {
+
+                _output = input;
+                _stable = 0;
+
+            }
+
+        }
+
+    public:
+
+        /**
+         * @brief Propage le constructeur défini par le modèle parent Button.
+         */
+        using Button::Button;
+
+};
\ No newline at end of file
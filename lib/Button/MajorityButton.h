@@ -0,0 +1,92 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la lecture d'un bouton par un
+ * vote à la majorité sur les derniers échantillons
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe MajorityButton
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Button.h"
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe MajorityButton.
+ *
+ * @tparam SAMPLES Nombre d'échantillons qui votent (impair, de 3 à 15).
+ *
+ * @note La sortie prend l'état majoritaire parmi les SAMPLES derniers
+ *       échantillons du signal d'entrée. Ceux-ci sont mémorisés dans un
+ *       registre à décalage, et le nombre d'échantillons à 1 est tenu à jour
+ *       au fil de l'eau : l'échantillon qui entre l'incrémente, celui qui
+ *       sort le décrémente. Le vote ne demande donc jamais de recompter.
+ *
+ *       Le retard est d'environ SAMPLES / 2 échantillons, et le vote tolère
+ *       jusqu'à SAMPLES / 2 échantillons parasités dans la fenêtre. En
+ *       revanche, un rebond plus long que la demi-fenêtre fait basculer la
+ *       sortie : la fenêtre doit donc couvrir la durée des rebonds.
+ */
+template <uint8_t SAMPLES = 5>
+class MajorityButton : public Button {
+
+    static_assert(SAMPLES >= 3 && SAMPLES <= 15 && (SAMPLES & 0x1), "majority vote needs an odd number of 3 to 15 samples");
+
+    private:
+
+        /**
+         * @brief Rang, dans le registre, de l'échantillon qui sort de la fenêtre.
+         */
+        static const uint16_t _OLDEST = 1 << (SAMPLES - 1);
+
+        /**
+         * @brief Registre des derniers échantillons.
+         */
+        uint16_t _history = 0;
+
+        /**
+         * @brief Nombre d'échantillons à 1 dans le registre.
+         */
+        uint8_t _ones = 0;
+
+    protected:
+
+        /**
+         * @brief Déparasitage du signal électronique provenant du bouton.
+         *
+         * @param input Niveau logique du signal d'entrée brut (lu directement).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode _debounce() déclarée par le modèle parent Button.
+         */
+        void _debounce(const uint8_t input) override {
+
+            if (_history & _OLDEST) _ones--;
+
+            _history = ((_history << 1) & ((_OLDEST << 1) - 1)) | (input & 0x1);
+
+            if (input) _ones++;
+
+            _output = _ones > SAMPLES / 2;
+
+        }
+
+    public:
+
+        /**
+         * @brief Propage le constructeur défini par le modèle parent Button.
+         */
+        using Button::Button;
+
+};
\ No newline at end of file
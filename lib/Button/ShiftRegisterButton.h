@@ -0,0 +1,96 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la lecture d'un bouton avec la
+ * méthode de debouncing par registre à décalage de Jack G. Ganssle
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe ShiftRegisterButton
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Button.h"
+#include <Arduino.h>
+
+/**
+ * @brief Type du registre à décalage : un octet suffit jusqu'à 8 échantillons.
+ */
+template <bool WIDE> struct ShiftRegisterType { typedef uint8_t  type; };
+template <>          struct ShiftRegisterType<true> { typedef uint16_t type; };
+
+/**
+ * @brief Définition de la classe ShiftRegisterButton.
+ *
+ * @tparam BITS Nombre d'échantillons consécutifs qui doivent concorder (de 1 à 16).
+ *
+ * @note Les derniers échantillons du signal d'entrée sont mémorisés dans un
+ *       registre à décalage : chaque nouvel échantillon y entre par la droite
+ *       et le plus ancien en sort par la gauche. La sortie ne change d'état
+ *       que lorsque les BITS derniers échantillons sont tous à 1, ou tous à 0.
+ *
+ *       Le résultat est proche de celui de l'algorithme de Kuhn, mais un seul
+ *       échantillon discordant suffit à relancer l'attente, là où l'intégrateur
+ *       de Kuhn ne recule que d'un cran. Le traitement se réduit à un décalage
+ *       et deux comparaisons.
+ *
+ * @see http://www.ganssle.com/debouncing-pt2.htm
+ */
+template <uint8_t BITS = 8>
+class ShiftRegisterButton : public Button {
+
+    static_assert(BITS >= 1 && BITS <= 16, "shift register holds 1 to 16 samples");
+
+    private:
+
+        /**
+         * @brief Type du registre, le plus petit possible.
+         */
+        typedef typename ShiftRegisterType<(BITS > 8)>::type _Register;
+
+        /**
+         * @brief Masque des BITS derniers échantillons.
+         */
+        static const _Register _MASK = (_Register) ((1UL << BITS) - 1);
+
+        /**
+         * @brief Registre des derniers échantillons.
+         */
+        _Register _history = 0;
+
+    protected:
+
+        /**
+         * @brief Déparasitage du signal électronique provenant du bouton.
+         *
+         * @param input Niveau logique du signal d'entrée brut (lu directement).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode _debounce() déclarée par le modèle parent Button.
+         */
+        void _debounce(const uint8_t input) override {
+
+            _history = ((_history << 1) | (input & 0x1)) & _MASK;
+
+                 if (_history == _MASK) _output = 1;
+            else if (!_history)         _output = 0;
+
+        }
+
+    public:
+
+        /**
+         * @brief Propage le constructeur défini par le modèle parent Button.
+         */
+        using Button::Button;
+
+};
\ No newline at end of file
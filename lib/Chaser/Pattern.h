@@ -0,0 +1,63 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition du format des motifs d'animation du chenillard, stockés en
+ * mémoire Flash (PROGMEM)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la structure Pattern
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Description d'un motif d'animation (pattern).
+ *
+ * @note Un motif est une séquence d'images (frames) précalculées, jouées
+ *       les unes à la suite des autres. Chaque image est décrite dans la
+ *       table `frames` par un enregistrement de `width + 1` octets :
+ *
+ *           +---------+-----+-----------+----------+
+ *           | octet 0 | ... | width - 1 |  width   |
+ *           +---------+-----+-----------+----------+
+ *           |   LEDs (un bit par LED)   |  durée   |
+ *           +---------------------------+----------+
+ *
+ *       La durée d'affichage de chaque image est exprimée en nombre de
+ *       "tops" d'horloge du séquenceur, de sorte qu'on peut accélérer ou
+ *       ralentir l'animation sans toucher aux tables.
+ *
+ *       Lorsque la dernière image a été jouée, la lecture reprend à l'image
+ *       d'indice `loop` (le point de bouclage) : les images qui précèdent ne
+ *       sont donc jouées qu'une seule fois, en guise d'introduction.
+ *
+ *       La table des images, comme la description du motif elle-même,
+ *       doivent être déclarées avec l'attribut PROGMEM pour résider en
+ *       mémoire Flash et ne pas encombrer les 2 Ko de mémoire vive :
+ *
+ *           const uint8_t MY_FRAMES[] PROGMEM = {
+ *               0b10000001, 10,
+ *               0b01000010, 10,
+ *               0b00100100, 10,
+ *               0b00011000, 20
+ *           };
+ *
+ *           const Pattern MY_PATTERN PROGMEM = { MY_FRAMES, 4, 1, 0 };
+ */
+struct Pattern {
+    const uint8_t *frames; // Table des images (en mémoire Flash).
+    uint16_t       length; // Nombre d'images.
+    uint8_t        width;  // Nombre d'octets par image (hors durée).
+    uint16_t       loop;   // Indice de l'image de bouclage.
+};
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Fichier de définition des tables des motifs prédéfinis
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les motifs prédéfinis
+ *       avant de les définir.
+ */
+#include "Patterns.h"
+
+// -----------------------------------------------------------------------------
+// Balayage bidirectionnel
+// -----------------------------------------------------------------------------
+
+const uint8_t PING_PONG_FRAMES[] PROGMEM = {
+    0b00000001, 8,
+    0b00000010, 8,
+    0b00000100, 8,
+    0b00001000, 8,
+    0b00010000, 8,
+    0b00100000, 8,
+    0b01000000, 8,
+    0b10000000, 8,
+    0b01000000, 8,
+    0b00100000, 8,
+    0b00010000, 8,
+    0b00001000, 8,
+    0b00000100, 8,
+    0b00000010, 8
+};
+
+const Pattern PING_PONG PROGMEM = { PING_PONG_FRAMES, 14, 1, 0 };
+
+// -----------------------------------------------------------------------------
+// Balayage unidirectionnel
+// -----------------------------------------------------------------------------
+
+const uint8_t WRAP_FRAMES[] PROGMEM = {
+    0b00000001, 8,
+    0b00000010, 8,
+    0b00000100, 8,
+    0b00001000, 8,
+    0b00010000, 8,
+    0b00100000, 8,
+    0b01000000, 8,
+    0b10000000, 8
+};
+
+const Pattern WRAP PROGMEM = { WRAP_FRAMES, 8, 1, 0 };
+
+// -----------------------------------------------------------------------------
+// K 2000
+// -----------------------------------------------------------------------------
+
+// La traînée se résorbe à chaque extrémité, où l'on marque une pause.
+// La première image n'est jouée qu'une seule fois : la boucle reprend à
+// l'image d'indice 1, puisque la dernière image lui est identique.
+const uint8_t KNIGHT_RIDER_FRAMES[] PROGMEM = {
+    0b00000001,  6,
+    0b00000011,  6,
+    0b00000111,  6,
+    0b00001110,  6,
+    0b00011100,  6,
+    0b00111000,  6,
+    0b01110000,  6,
+    0b11100000,  6,
+    0b11000000,  6,
+    0b10000000, 18,
+    0b11000000,  6,
+    0b11100000,  6,
+    0b01110000,  6,
+    0b00111000,  6,
+    0b00011100,  6,
+    0b00001110,  6,
+    0b00000111,  6,
+    0b00000011,  6,
+    0b00000001, 18
+};
+
+const Pattern KNIGHT_RIDER PROGMEM = { KNIGHT_RIDER_FRAMES, 19, 1, 1 };
+
+// -----------------------------------------------------------------------------
+// Compteur binaire
+// -----------------------------------------------------------------------------
+
+// Plutôt que d'écrire les 256 images à la main, on laisse le préprocesseur
+// les générer : chaque macro produit 4 fois plus d'images que la précédente.
+#define BINARY_1(n)   (n), 4,
+#define BINARY_4(n)   BINARY_1(n)  BINARY_1((n) +  1) BINARY_1((n) +  2) BINARY_1((n) +  3)
+#define BINARY_16(n)  BINARY_4(n)  BINARY_4((n) +  4) BINARY_4((n) +  8) BINARY_4((n) + 12)
+#define BINARY_64(n)  BINARY_16(n) BINARY_16((n) + 16) BINARY_16((n) + 32) BINARY_16((n) + 48)
+
+const uint8_t BINARY_COUNTER_FRAMES[] PROGMEM = {
+    BINARY_64(0) BINARY_64(64) BINARY_64(128) BINARY_64(192)
+};
+
+const Pattern BINARY_COUNTER PROGMEM = { BINARY_COUNTER_FRAMES, 256, 1, 0 };
\ No newline at end of file
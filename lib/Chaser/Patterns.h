@@ -0,0 +1,43 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Bibliothèque de motifs d'animation prédéfinis pour une rampe de 8 LEDs
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de déclaration des motifs prédéfinis
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Pattern.h"
+
+/**
+ * @brief Balayage bidirectionnel (aller-retour) d'une LED unique.
+ *
+ * @note C'est l'animation de l'exercice 09, mais jouée de façon autonome.
+ */
+extern const Pattern PING_PONG PROGMEM;
+
+/**
+ * @brief Balayage unidirectionnel d'une LED unique, qui reboucle au début.
+ */
+extern const Pattern WRAP PROGMEM;
+
+/**
+ * @brief Balayage bidirectionnel d'une LED suivie d'une traînée (K 2000).
+ */
+extern const Pattern KNIGHT_RIDER PROGMEM;
+
+/**
+ * @brief Compteur binaire de 0 à 255, comme avec la fonction ledWrite().
+ */
+extern const Pattern BINARY_COUNTER PROGMEM;
\ No newline at end of file
@@ -0,0 +1,83 @@
+/*
+ * ---------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ---------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ---------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe Sequencer
+ * ---------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe Sequencer avant de les définir.
+ */
+#include "Sequencer.h"
+
+Sequencer::Sequencer(LedBank &bank, const uint8_t tick_ms)
+    : _bank(bank), _frames(nullptr), _length(0), _tick_ms(tick_ms) {}
+
+void Sequencer::play(const Pattern *pattern) {
+
+    // Seule la description du motif est lue ici : les images resteront
+    // en mémoire Flash et seront lues au fur et à mesure.
+    _frames = (const uint8_t *) pgm_read_ptr(&pattern->frames);
+    _length = pgm_read_word(&pattern->length);
+    _width  = pgm_read_byte(&pattern->width);
+    _loop   = pgm_read_word(&pattern->loop);
+    _index  = 0;
+
+    // La première image est affichée dès le prochain top.
+    _remaining    = 1;
+    _last_tick_ms = millis();
+
+}
+
+void Sequencer::setTick(const uint8_t tick_ms) {
+    _tick_ms = tick_ms;
+}
+
+uint8_t Sequencer::tick() const {
+    return _tick_ms;
+}
+
+uint8_t Sequencer::next(uint8_t *frame) {
+
+    uint8_t size  = _bank.frameSize();
+    if (size > _MAX_FRAME_SIZE) size = _MAX_FRAME_SIZE;
+
+    uint8_t width = _width < size ? _width : size;
+
+    // Adresse de l'enregistrement de l'image en mémoire Flash.
+    const uint8_t *record = _frames + _index * (_width + 1);
+
+    // Les LEDs qui dépassent de la largeur du motif restent éteintes.
+    memcpy_P(frame, record, width);
+    memset(frame + width, 0, size - width);
+
+    if (++_index == _length) _index = _loop;
+
+    return pgm_read_byte(record + _width);
+
+}
+
+void Sequencer::update() {
+
+    if (!_length) return;
+
+    uint32_t now = millis();
+
+    if (now - _last_tick_ms >= _tick_ms) {
+
+        _last_tick_ms += _tick_ms;
+
+        if (!--_remaining) {
+            _remaining = next(_frame);
+            _bank.write(_frame);
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un séquenceur qui joue de façon autonome des motifs
+ * d'animation stockés en mémoire Flash sur une rampe de LEDs
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Sequencer
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Pattern.h"
+#include <LedBank.h>
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe Sequencer.
+ *
+ * @note Le séquenceur lit les images d'un motif directement en mémoire
+ *       Flash, une à une, au moment où elles doivent être affichées : les
+ *       tables ne sont jamais recopiées en mémoire vive. Seule l'image
+ *       courante occupe un petit tampon de quelques octets.
+ *
+ *       Le temps est découpé en "tops" d'horloge de période `tick_ms`. À
+ *       chaque top, le séquenceur décompte la durée de l'image courante et,
+ *       lorsqu'elle est écoulée, charge l'image suivante et l'envoie d'un
+ *       seul bloc sur la rampe de LEDs. Le travail effectué à chaque top
+ *       est donc constant, quel que soit le motif joué.
+ *
+ *       Il suffit d'appeler la méthode update() aussi souvent que possible
+ *       dans la boucle principale : elle ne bloque jamais, ce qui laisse le
+ *       temps de lire le bouton pour changer de motif ou de vitesse.
+ *
+ *       Le séquenceur peut piloter une rampe de 64 LEDs au plus, et la durée
+ *       de chaque image doit être d'au moins un top.
+ */
+class Sequencer {
+
+    private:
+
+        /**
+         * @brief Taille maximale d'une image (en octets), soit 64 LEDs.
+         */
+        static const uint8_t _MAX_FRAME_SIZE = 8;
+
+        /**
+         * @brief Rampe de LEDs sur laquelle les images sont affichées.
+         */
+        LedBank &_bank;
+
+        /**
+         * @brief Table des images du motif courant (en mémoire Flash).
+         */
+        const uint8_t *_frames;
+
+        /**
+         * @brief Nombre d'images du motif courant.
+         */
+        uint16_t _length;
+
+        /**
+         * @brief Nombre d'octets par image du motif courant.
+         */
+        uint8_t _width;
+
+        /**
+         * @brief Indice de l'image de bouclage du motif courant.
+         */
+        uint16_t _loop;
+
+        /**
+         * @brief Indice de la prochaine image à jouer.
+         */
+        uint16_t _index;
+
+        /**
+         * @brief Nombre de tops restant avant de passer à l'image suivante.
+         */
+        uint8_t _remaining;
+
+        /**
+         * @brief Période des tops d'horloge (exprimée en millisecondes).
+         */
+        uint8_t _tick_ms;
+
+        /**
+         * @brief Date du dernier top d'horloge (exprimée en millisecondes).
+         */
+        uint32_t _last_tick_ms;
+
+        /**
+         * @brief Image courante.
+         */
+        uint8_t _frame[_MAX_FRAME_SIZE];
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param bank    Rampe de LEDs sur laquelle les images sont affichées.
+         * @param tick_ms Période des tops d'horloge (exprimée en millisecondes).
+         */
+        Sequencer(LedBank &bank, const uint8_t tick_ms);
+
+        /**
+         * @brief Démarre la lecture d'un motif depuis sa première image.
+         *
+         * @param pattern Adresse du motif (en mémoire Flash).
+         */
+        void play(const Pattern *pattern);
+
+        /**
+         * @brief Modifie la vitesse de l'animation.
+         *
+         * @param tick_ms Nouvelle période des tops d'horloge (exprimée en millisecondes).
+         *
+         * @note Le changement prend effet au prochain top, sans interrompre
+         *       l'image en cours.
+         */
+        void setTick(const uint8_t tick_ms);
+
+        /**
+         * @brief Période courante des tops d'horloge (exprimée en millisecondes).
+         */
+        uint8_t tick() const;
+
+        /**
+         * @brief Charge l'image suivante du motif.
+         *
+         * @param frame Tampon recevant l'image (au moins `bank.frameSize()` octets).
+         *
+         * @return Durée d'affichage de l'image (exprimée en nombre de tops).
+         *
+         * @note Cette méthode n'affiche rien : elle permet de préparer les
+         *       images à l'avance lorsque l'affichage est cadencé par une
+         *       autre horloge que celle de la méthode update().
+         */
+        uint8_t next(uint8_t *frame);
+
+        /**
+         * @brief Fait progresser l'animation.
+         *
+         * @note Cette méthode est non bloquante et traite au plus un top
+         *       d'horloge à chaque appel.
+         */
+        void update();
+
+};
\ No newline at end of file
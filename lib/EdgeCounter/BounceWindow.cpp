@@ -0,0 +1,60 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe BounceWindow
+ * -----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe BounceWindow avant de les définir.
+ */
+#include "BounceWindow.h"
+
+BounceWindow::BounceWindow(const uint16_t window_ms)
+    : _window_ms(window_ms), _start_ms(0), _up(0), _down(0) {
+    _start.rising = 0;
+    _start.level  = 0;
+}
+
+void BounceWindow::reset(const uint32_t now_ms, const EdgeCounter::Snapshot &snapshot) {
+    _start    = snapshot;
+    _start_ms = now_ms;
+}
+
+bool BounceWindow::update(const uint32_t now_ms, const EdgeCounter::Snapshot &snapshot) {
+
+    // La différence est calculée modulo 65536, ce qui reste juste lorsque
+    // le compteur a débordé entre les deux relevés.
+    uint16_t up = snapshot.rising - _start.rising;
+
+    // Aucune transition : on repousse l'ouverture de la fenêtre.
+    if (!up && snapshot.level == _start.level) {
+        _start_ms = now_ms;
+        return false;
+    }
+
+    if (now_ms - _start_ms <= _window_ms) return false;
+
+    // Fronts montants - fronts descendants = variation du niveau logique.
+    _up   = up;
+    _down = up - (int8_t) (snapshot.level - _start.level);
+
+    reset(now_ms, snapshot);
+
+    return true;
+
+}
+
+uint16_t BounceWindow::up() const {
+    return _up;
+}
+
+uint16_t BounceWindow::down() const {
+    return _down;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour le découpage du comptage des
+ * transitions logiques du bouton en fenêtres de durée fixe
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe BounceWindow
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "EdgeCounter.h"
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe BounceWindow.
+ *
+ * @note La fenêtre de comptage s'ouvre à la première transition observée
+ *       et se referme `window_ms` millisecondes plus tard : les transitions
+ *       survenues entre-temps (le rebond complet d'un appui ou d'un
+ *       relâchement) sont alors dénombrées en une seule fois. Tant qu'aucune
+ *       transition n'est observée, l'ouverture de la fenêtre est repoussée.
+ *
+ *       Cette classe ne touche à aucun registre : elle reçoit les relevés du
+ *       compteur et la date courante, et peut donc être vérifiée avec des
+ *       relevés fictifs.
+ */
+class BounceWindow {
+
+    private:
+
+        /**
+         * @brief Durée de la fenêtre de comptage (exprimée en millisecondes).
+         */
+        uint16_t _window_ms;
+
+        /**
+         * @brief Relevé du compteur à l'ouverture de la fenêtre.
+         */
+        EdgeCounter::Snapshot _start;
+
+        /**
+         * @brief Date d'ouverture de la fenêtre.
+         */
+        uint32_t _start_ms;
+
+        /**
+         * @brief Nombre de passages à l'état `HIGH` dans la dernière fenêtre.
+         */
+        uint16_t _up;
+
+        /**
+         * @brief Nombre de passages à l'état `LOW` dans la dernière fenêtre.
+         */
+        uint16_t _down;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param window_ms Durée de la fenêtre de comptage (exprimée en millisecondes).
+         */
+        BounceWindow(const uint16_t window_ms);
+
+        /**
+         * @brief Réinitialisation de la fenêtre à partir d'un relevé du compteur.
+         *
+         * @param now_ms   Date courante.
+         * @param snapshot Relevé du compteur.
+         */
+        void reset(const uint32_t now_ms, const EdgeCounter::Snapshot &snapshot);
+
+        /**
+         * @brief Mise à jour de la fenêtre à partir d'un nouveau relevé du compteur.
+         *
+         * @param now_ms   Date courante.
+         * @param snapshot Relevé du compteur.
+         *
+         * @return true si la fenêtre vient de se refermer : les décomptes
+         *         up() et down() sont alors disponibles.
+         */
+        bool update(const uint32_t now_ms, const EdgeCounter::Snapshot &snapshot);
+
+        /**
+         * @brief Nombre de passages à l'état `HIGH` dans la dernière fenêtre refermée.
+         */
+        uint16_t up() const;
+
+        /**
+         * @brief Nombre de passages à l'état `LOW` dans la dernière fenêtre refermée.
+         */
+        uint16_t down() const;
+
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe EdgeCounter
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe EdgeCounter avant de les définir.
+ */
+#include "EdgeCounter.h"
+#include <util/atomic.h>
+
+/**
+ * @brief Lecture atomique du compteur du Timer1.
+ *
+ * @note La lecture d'un registre 16 bits passe par un registre temporaire
+ *       partagé, qu'une routine d'interruption pourrait modifier entre la
+ *       lecture de l'octet de poids faible et celle de l'octet de poids fort.
+ */
+static uint16_t readCounter() {
+
+    uint16_t count;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        count = TCNT1;
+    }
+
+    return count;
+
+}
+
+void EdgeCounter::begin() {
+
+    // Entrée T1, sans résistance de tirage (le bouton est muni de la sienne).
+    DDRD  &= ~_BV(PD5);
+    PORTD &= ~_BV(PD5);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+
+        // Mode normal, aucune interruption, horloge externe sur T1 (front montant).
+        TIMSK1 = 0;
+        TCCR1A = 0;
+        TCNT1  = 0;
+        TCCR1B = _BV(CS12) | _BV(CS11) | _BV(CS10);
+
+    }
+
+}
+
+void EdgeCounter::end() {
+    TCCR1B = 0;
+}
+
+EdgeCounter::Snapshot EdgeCounter::snapshot() const {
+
+    Snapshot snapshot;
+    uint16_t check;
+
+    do {
+
+        snapshot.rising = readCounter();
+        snapshot.level  = (PIND >> PD5) & 0x1;
+        check           = readCounter();
+
+    } while (check != snapshot.rising);
+
+    return snapshot;
+
+}
\ No newline at end of file
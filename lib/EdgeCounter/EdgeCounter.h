@@ -0,0 +1,84 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour le comptage matériel des
+ * fronts montants du signal appliqué sur l'entrée T1 (broche D5)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe EdgeCounter
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe EdgeCounter.
+ *
+ * @note Lorsque les transitions du bouton sont détectées en comparant
+ *       digitalRead() au dernier état connu, deux rebonds survenus au cours
+ *       d'une même itération de la boucle principale passent inaperçus.
+ *
+ *       Ici, le bouton est relié à l'entrée d'horloge externe T1 (broche D5)
+ *       du Timer1 : c'est le compteur du Timer1 lui-même qui s'incrémente à
+ *       chaque front montant, sans aucune intervention du processeur. Seuls
+ *       les fronts séparés de moins de 2,5 cycles d'horloge environ (160 ns)
+ *       échappent encore au comptage, puisque l'entrée T1 est échantillonnée
+ *       par l'horloge système.
+ *
+ *       Le compteur ne dénombre que les fronts montants. Les fronts descendants
+ *       s'en déduisent, puisque le niveau logique de la broche n'évolue que par
+ *       transitions alternées : sur un intervalle donné, le nombre de fronts
+ *       montants moins le nombre de fronts descendants est égal à la variation
+ *       du niveau logique (-1, 0 ou +1).
+ *
+ *       Le compteur n'est jamais remis à zéro : on relève sa valeur (avec
+ *       le niveau de la broche) au début et à la fin de chaque intervalle,
+ *       et on en fait la différence. Une remise à zéro perdrait les fronts
+ *       survenus entre la lecture et l'écriture du compteur.
+ *
+ *       Le Timer1 est alors entièrement réservé au comptage (les sorties PWM
+ *       des broches D9 et D10 ne sont plus disponibles, et la classe FrameClock
+ *       ne peut pas être utilisée en même temps).
+ */
+class EdgeCounter {
+
+    public:
+
+        /**
+         * @brief Relevé instantané du compteur et du niveau de la broche.
+         */
+        struct Snapshot {
+            uint16_t rising;  // Nombre de fronts montants depuis begin() (modulo 65536).
+            uint8_t  level;   // Niveau logique de la broche T1.
+        };
+
+        /**
+         * @brief Démarrage du comptage des fronts montants sur la broche D5.
+         */
+        void begin();
+
+        /**
+         * @brief Arrêt du comptage.
+         */
+        void end();
+
+        /**
+         * @brief Relevé cohérent du compteur et du niveau de la broche.
+         *
+         * @note Le compteur est lu avant et après le niveau de la broche : si
+         *       un front montant survient entre les deux lectures, le relevé
+         *       est recommencé.
+         */
+        Snapshot snapshot() const;
+
+};
\ No newline at end of file
@@ -0,0 +1,53 @@
+/*
+ * ---------------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ---------------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ---------------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe ExpanderButtons
+ * ---------------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe ExpanderButtons avant de les définir.
+ */
+#include "ExpanderButtons.h"
+
+void ExpanderButtons::configure(PinSetup &pins) const {
+    pins.input(_int_pin, true);
+}
+
+void ExpanderButtons::begin(const uint16_t mask) {
+
+    _chip.write16(Mcp23017::IODIRA,   mask); // Broches des boutons en entrée.
+    _chip.write16(Mcp23017::GPPUA,    mask); // Résistances de rappel activées.
+    _chip.write16(Mcp23017::IPOLA,    mask); // Polarité inversée : bouton enfoncé = 1.
+    _chip.write16(Mcp23017::INTCONA,  0);    // Interruption sur tout changement d'état...
+    _chip.write16(Mcp23017::GPINTENA, mask); // ... de chacune des broches des boutons.
+
+    // Première lecture, qui acquitte une éventuelle interruption en attente.
+    uint8_t data[2];
+    _chip.read(Mcp23017::GPIOA, data, 2);
+    _inputs = data[0] | data[1] << 8;
+
+}
+
+bool ExpanderButtons::sample() {
+
+    // Aucun changement signalé : la dernière lecture est toujours valable.
+    if (digitalRead(_int_pin)) return false;
+
+    uint8_t data[2];
+    _chip.read(Mcp23017::GPIOA, data, 2);
+    _inputs = data[0] | data[1] << 8;
+
+    return true;
+
+}
+
+uint8_t ExpanderButtons::input(const uint8_t pin) const {
+    return (_inputs >> pin) & 0x1;
+}
\ No newline at end of file
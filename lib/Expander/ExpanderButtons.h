@@ -0,0 +1,116 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la lecture groupée de boutons
+ * (16 au plus) reliés aux ports d'un expandeur MCP23017
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe ExpanderButtons
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Mcp23017.h"
+#include <Arduino.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Définition de la classe ExpanderButtons.
+ *
+ * @note Les boutons sont reliés entre les broches de l'expandeur et la
+ *       masse : les résistances de rappel internes (pull-up) de l'expandeur
+ *       sont activées, et la polarité des entrées est inversée par le
+ *       registre IPOLx, de sorte qu'un bouton enfoncé est lu au niveau
+ *       logique 1, comme sur notre montage avec résistance pull-down.
+ *
+ *       Les deux ports sont lus en une seule transaction. Mieux encore : la
+ *       sortie d'interruption de l'expandeur (INTA, en drain ouvert) est
+ *       reliée à une broche de la carte, et passe au niveau bas dès qu'une
+ *       entrée change d'état. Tant qu'elle reste au niveau haut, les entrées
+ *       n'ont pas changé depuis la dernière lecture, qui reste donc valable :
+ *       aucune transaction n'est nécessaire. La lecture des ports acquitte
+ *       l'interruption.
+ *
+ *       Les signaux d'entrée ainsi échantillonnés sont ensuite confiés à des
+ *       boutons virtuels qui se chargent du déparasitage :
+ *
+ *           inputs.sample();
+ *           for (uint8_t i=0; i<NUM_BUTTONS; i++) button[i].read(inputs.input(i));
+ */
+class ExpanderButtons {
+
+    private:
+
+        /**
+         * @brief Expandeur auquel les boutons sont reliés.
+         */
+        Mcp23017 &_chip;
+
+        /**
+         * @brief Broche de la carte reliée à la sortie d'interruption INTA de l'expandeur.
+         */
+        uint8_t _int_pin;
+
+        /**
+         * @brief Dernière valeur lue des entrées (port A sur l'octet de poids faible).
+         */
+        uint16_t _inputs;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param chip    Expandeur auquel les boutons sont reliés.
+         * @param int_pin Broche de la carte reliée à la sortie INTA de l'expandeur.
+         *
+         * @note Le constructeur est évalué à la compilation (constexpr) et ne
+         *       touche à aucun registre.
+         */
+        constexpr ExpanderButtons(Mcp23017 &chip, const uint8_t int_pin)
+            : _chip(chip), _int_pin(int_pin), _inputs(0) {}
+
+        /**
+         * @brief Déclare la broche reliée à INTA en entrée, avec sa résistance de tirage.
+         *
+         * @param pins Configuration des broches, appliquée par PinSetup::apply().
+         *
+         * @note La sortie INTA est en drain ouvert : il lui faut une résistance de rappel.
+         */
+        void configure(PinSetup &pins) const;
+
+        /**
+         * @brief Configuration des broches des boutons en entrée.
+         *
+         * @param mask Masque des broches de l'expandeur reliées à des boutons
+         *             (port A sur l'octet de poids faible).
+         *
+         * @note L'expandeur doit avoir été initialisé au préalable par Mcp23017::begin().
+         */
+        void begin(const uint16_t mask);
+
+        /**
+         * @brief Échantillonnage des entrées.
+         *
+         * @return true  si les entrées ont été lues sur le bus,
+         *         false si elles n'ont pas changé depuis la dernière lecture.
+         */
+        bool sample();
+
+        /**
+         * @brief Niveau logique du signal d'entrée d'un bouton.
+         *
+         * @param pin Indice de la broche de l'expandeur (de 0 à 15).
+         */
+        uint8_t input(const uint8_t pin) const;
+
+};
\ No newline at end of file
@@ -0,0 +1,37 @@
+/*
+ * ---------------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ---------------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ---------------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe ExpanderLedBank
+ * ---------------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe ExpanderLedBank avant de les définir.
+ */
+#include "ExpanderLedBank.h"
+
+void ExpanderLedBank::begin() {
+
+    // Toutes les LEDs éteintes, puis les broches des LEDs en sortie
+    // (un bit à 0 dans IODIRx configure la broche en sortie).
+    uint16_t mask = _size == 16 ? 0xFFFF : (1u << _size) - 1;
+
+    _chip.write16(Mcp23017::OLATA, _latch = 0);
+    _chip.write16(Mcp23017::IODIRA, ~mask);
+
+}
+
+void ExpanderLedBank::write(const uint8_t *frame) {
+
+    uint16_t latch = frame[0];
+    if (_size > 8) latch |= frame[1] << 8;
+
+    if (latch != _latch) _chip.write16(Mcp23017::OLATA, _latch = latch);
+
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la commande d'une rampe de
+ * LEDs (16 au plus) reliées aux ports d'un expandeur MCP23017
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe ExpanderLedBank
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Mcp23017.h"
+#include <LedBank.h>
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe ExpanderLedBank.
+ *
+ * @note Les LEDs 0 à 7 sont reliées au port A (GPA0 à GPA7) et les LEDs
+ *       8 à 15 au port B (GPB0 à GPB7) de l'expandeur.
+ *
+ *       Chaque image est transmise en une seule transaction, qui écrit les
+ *       registres OLATA et OLATB à la suite. Et si l'image est identique à
+ *       celle qui est déjà affichée, aucune transaction n'a lieu.
+ */
+class ExpanderLedBank : public LedBank {
+
+    private:
+
+        /**
+         * @brief Expandeur auquel les LEDs sont reliées.
+         */
+        Mcp23017 &_chip;
+
+        /**
+         * @brief Image affichée (port A sur l'octet de poids faible).
+         */
+        uint16_t _latch;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param chip Expandeur auquel les LEDs sont reliées.
+         * @param size Nombre de LEDs (16 au plus).
+         */
+        constexpr ExpanderLedBank(Mcp23017 &chip, const uint8_t size)
+            : LedBank(size > 16 ? 16 : size), _chip(chip), _latch(0) {}
+
+        /**
+         * @brief Configuration des broches de l'expandeur en sortie.
+         *
+         * @note L'expandeur doit avoir été initialisé au préalable par Mcp23017::begin().
+         */
+        void begin();
+
+        /**
+         * @brief Affichage d'une image sur la rampe de LEDs.
+         *
+         * @param frame Image à afficher (un bit par LED).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode write() déclarée par le modèle parent LedBank.
+         */
+        void write(const uint8_t *frame) override;
+
+};
\ No newline at end of file
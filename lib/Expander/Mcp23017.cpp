@@ -0,0 +1,64 @@
+/*
+ * --------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * --------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * --------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe Mcp23017
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe Mcp23017 avant de les définir.
+ */
+#include "Mcp23017.h"
+
+void Mcp23017::begin() {
+
+    Wire.begin();
+    Wire.setClock(400000);
+
+    // IOCON : MIRROR = 1 (INTA et INTB reliées), ODR = 1 (drain ouvert),
+    // SEQOP = 0 (adressage séquentiel), BANK = 0 (registres entrelacés).
+    uint8_t iocon = 0x44;
+    write(IOCON, &iocon, 1);
+
+}
+
+void Mcp23017::write(const uint8_t reg, const uint8_t *data, const uint8_t n) {
+
+    Wire.beginTransmission(_address);
+    Wire.write(reg);
+    for (uint8_t i=0; i<n; i++) Wire.write(data[i]);
+    Wire.endTransmission();
+
+    _transactions++;
+
+}
+
+void Mcp23017::write16(const uint8_t reg, const uint16_t value) {
+
+    uint8_t data[] = { (uint8_t) value, (uint8_t) (value >> 8) };
+    write(reg, data, 2);
+
+}
+
+void Mcp23017::read(const uint8_t reg, uint8_t *data, const uint8_t n) {
+
+    Wire.beginTransmission(_address);
+    Wire.write(reg);
+    Wire.endTransmission(false);
+
+    Wire.requestFrom(_address, n);
+    for (uint8_t i=0; i<n; i++) data[i] = Wire.read();
+
+    _transactions++;
+
+}
+
+uint32_t Mcp23017::transactions() const {
+    return _transactions;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour l'accès à un expandeur de
+ * ports MCP23017 sur le bus I2C
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Mcp23017
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/**
+ * @brief Définition de la classe Mcp23017.
+ *
+ * @note Le MCP23017 fournit 16 broches d'entrée/sortie supplémentaires,
+ *       réparties sur deux ports de 8 bits (A et B), commandées par le bus
+ *       I2C (broches A4/SDA et A5/SCL de la Nano).
+ *
+ *       Chaque transaction sur le bus coûte cher : à 400 kHz, l'adresse du
+ *       composant et le numéro de registre prennent déjà une cinquantaine de
+ *       microsecondes. Traduire naïvement chaque appel à Led::light() ou à
+ *       Button::read() par une transaction serait donc désastreux.
+ *
+ *       Le composant est configuré en mode "séquentiel" : après le numéro du
+ *       premier registre, les octets lus ou écrits concernent les registres
+ *       suivants. Les deux ports sont ainsi lus ou écrits en une seule
+ *       transaction (une "rafale").
+ *
+ *       Le nombre de transactions effectuées est comptabilisé, ce qui permet
+ *       de mesurer le coût réel d'une image ou d'une lecture des boutons.
+ */
+class Mcp23017 {
+
+    public:
+
+        /**
+         * @brief Adresses des registres (configuration IOCON.BANK = 0).
+         *
+         * @note Les registres des ports A et B sont entrelacés : le registre
+         *       du port B suit immédiatement celui du port A.
+         */
+        enum Register : uint8_t {
+            IODIRA   = 0x00,
+            IPOLA    = 0x02,
+            GPINTENA = 0x04,
+            DEFVALA  = 0x06,
+            INTCONA  = 0x08,
+            IOCON    = 0x0A,
+            GPPUA    = 0x0C,
+            INTFA    = 0x0E,
+            INTCAPA  = 0x10,
+            GPIOA    = 0x12,
+            OLATA    = 0x14
+        };
+
+    private:
+
+        /**
+         * @brief Adresse du composant sur le bus I2C (de 0x20 à 0x27).
+         */
+        uint8_t _address;
+
+        /**
+         * @brief Nombre de transactions effectuées sur le bus.
+         */
+        uint32_t _transactions;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param address Adresse du composant sur le bus I2C (de 0x20 à 0x27).
+         */
+        constexpr Mcp23017(const uint8_t address) : _address(address), _transactions(0) {}
+
+        /**
+         * @brief Initialisation du bus I2C et du composant.
+         *
+         * @note Le bus est cadencé à 400 kHz. La sortie d'interruption INTA
+         *       est configurée en drain ouvert (active au niveau bas) et reflète
+         *       les changements des deux ports (INTA et INTB sont reliées).
+         */
+        void begin();
+
+        /**
+         * @brief Écriture de registres consécutifs en une seule transaction.
+         *
+         * @param reg  Adresse du premier registre.
+         * @param data Valeurs à écrire.
+         * @param n    Nombre de registres à écrire.
+         */
+        void write(const uint8_t reg, const uint8_t *data, const uint8_t n);
+
+        /**
+         * @brief Écriture d'une valeur sur 16 bits dans les registres des ports A et B.
+         *
+         * @param reg   Adresse du registre du port A.
+         * @param value Valeur à écrire sur 16 bits (port A sur l'octet de poids faible).
+         */
+        void write16(const uint8_t reg, const uint16_t value);
+
+        /**
+         * @brief Lecture de registres consécutifs en une seule transaction.
+         *
+         * @param reg  Adresse du premier registre.
+         * @param data Valeurs lues.
+         * @param n    Nombre de registres à lire.
+         *
+         * @note Le numéro de registre et la lecture sont enchaînés par une
+         *       condition de redémarrage (repeated start), sans libérer le bus.
+         */
+        void read(const uint8_t reg, uint8_t *data, const uint8_t n);
+
+        /**
+         * @brief Nombre de transactions effectuées sur le bus depuis le démarrage.
+         */
+        uint32_t transactions() const;
+
+};
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe FrameClock
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe FrameClock avant de les définir.
+ */
+#include "FrameClock.h"
+#include <util/atomic.h>
+
+/**
+ * @brief Horloge associée à la routine d'interruption du Timer1.
+ *
+ * @note Il n'existe qu'un seul Timer1, donc une seule horloge active à la fois.
+ */
+static FrameClock *active_clock = nullptr;
+
+ISR(TIMER1_COMPA_vect) {
+    active_clock->tick();
+}
+
+FrameClock::FrameClock(LedBank &bank)
+    : _bank(bank), _ready(false), _countdown(0), _late(0) {
+    resetStats();
+}
+
+void FrameClock::begin(const uint16_t tick_us) {
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+
+        active_clock = this;
+
+        // Mode CTC : le compteur repart de zéro dès qu'il atteint OCR1A.
+        // Avec un prédiviseur de 8, le compteur avance toutes les 0,5 µs.
+        TCCR1A = 0;
+        TCCR1B = _BV(WGM12) | _BV(CS11);
+        OCR1A  = (tick_us << 1) - 1;
+        TCNT1  = 0;
+
+        TIFR1  = _BV(OCF1A);
+        TIMSK1 = _BV(OCIE1A);
+
+    }
+
+}
+
+void FrameClock::end() {
+    TIMSK1 = 0;
+    TCCR1B = 0;
+}
+
+bool FrameClock::needsFrame() const {
+    return !_ready;
+}
+
+void FrameClock::queue(const uint8_t *frame, const uint8_t duration) {
+
+    uint8_t size = _bank.frameSize();
+    if (size > _MAX_FRAME_SIZE) size = _MAX_FRAME_SIZE;
+
+    memcpy(_frame, frame, size);
+    _duration = duration;
+
+    // Le drapeau n'est levé qu'une fois l'image et sa durée entièrement
+    // recopiées : _frame et _duration ne sont pas volatiles, la barrière
+    // interdit au compilateur de reporter leur écriture après celle de _ready.
+    asm volatile("" ::: "memory");
+    _ready = true;
+
+}
+
+FrameClock::Stats FrameClock::stats() const {
+
+    Stats stats;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        stats.frames           = _frames;
+        stats.missed           = _missed;
+        stats.worst_latency_us = _worst_latency > 0x1FFFF ? 0xFFFF : _worst_latency >> 1;
+    }
+
+    return stats;
+
+}
+
+void FrameClock::resetStats() {
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        _frames        = 0;
+        _missed        = 0;
+        _worst_latency = 0;
+    }
+
+}
+
+void FrameClock::tick() {
+
+    // L'image affichée n'est pas encore arrivée à échéance.
+    if (_countdown && --_countdown) return;
+
+    // L'échéance est atteinte, mais l'image suivante n'est pas prête :
+    // on la comptabilise une seule fois, et on réessaiera au prochain top.
+    if (!_ready) {
+        if (_frames && !_late) _missed++;
+        if (_late < 0xFF) _late++;
+        return;
+    }
+
+    _bank.write(_frame);
+
+    // Le retard est mesuré entre l'échéance initiale de l'image et le moment
+    // où elle a effectivement été appliquée : le compteur du Timer1 donne le
+    // temps écoulé depuis le dernier top.
+    uint32_t latency = (uint32_t) _late * (OCR1A + 1) + TCNT1;
+    if (_frames && latency > _worst_latency) _worst_latency = latency;
+
+    _frames++;
+    _late      = 0;
+    _countdown = _duration;
+
+    // Le tampon est rendu à la boucle principale.
+    _ready = false;
+
+}
\ No newline at end of file
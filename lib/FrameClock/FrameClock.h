@@ -0,0 +1,181 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'une horloge d'affichage cadencée par le Timer1, qui applique
+ * les images du chenillard à échéance fixe, indépendamment de loop()
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe FrameClock
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <LedBank.h>
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe FrameClock.
+ *
+ * @note Lorsque l'animation est cadencée par millis() dans la boucle
+ *       principale, chaque image est affichée "dès que possible" après son
+ *       échéance : un Serial.print() ou une rafale de digitalWrite() suffit
+ *       à retarder l'image suivante, et le balayage saccade.
+ *
+ *       Ici, c'est le Timer1, configuré en mode CTC (Clear Timer on Compare
+ *       match), qui produit les tops d'horloge. À chaque top, une routine
+ *       d'interruption décompte la durée de l'image affichée et, lorsqu'elle
+ *       est écoulée, applique aussitôt l'image suivante sur la rampe de LEDs.
+ *
+ *       La boucle principale n'a plus qu'à préparer l'image suivante à
+ *       l'avance (double tampon) : tant qu'elle la fournit avant l'échéance,
+ *       l'image est appliquée exactement à l'heure, quelle que soit la charge
+ *       de la boucle. Si l'image n'est pas prête à temps, l'échéance est
+ *       comptée comme manquée et l'image est appliquée au top suivant.
+ *
+ *       Le Timer1 est alors entièrement réservé à l'horloge (les sorties PWM
+ *       des broches D9 et D10 ne sont plus disponibles). Il est cadencé avec
+ *       un prédiviseur de 8, soit une résolution de 0,5 µs et une période de
+ *       top maximale de 32 ms.
+ */
+class FrameClock {
+
+    public:
+
+        /**
+         * @brief Statistiques de fonctionnement de l'horloge.
+         */
+        struct Stats {
+            uint32_t frames;            // Nombre d'images appliquées.
+            uint16_t missed;            // Nombre d'échéances manquées (image non prête).
+            uint16_t worst_latency_us;  // Pire retard constaté entre une échéance et l'application de l'image.
+        };
+
+    private:
+
+        /**
+         * @brief Taille maximale d'une image (en octets), soit 64 LEDs.
+         */
+        static const uint8_t _MAX_FRAME_SIZE = 8;
+
+        /**
+         * @brief Rampe de LEDs sur laquelle les images sont appliquées.
+         */
+        LedBank &_bank;
+
+        /**
+         * @brief Prochaine image à appliquer (préparée par la boucle principale).
+         */
+        uint8_t _frame[_MAX_FRAME_SIZE];
+
+        /**
+         * @brief Durée d'affichage de la prochaine image (exprimée en nombre de tops).
+         */
+        uint8_t _duration;
+
+        /**
+         * @brief Indique si la prochaine image est prête à être appliquée.
+         *
+         * @note Tant que ce drapeau est levé, seule la routine d'interruption
+         *       accède au tampon `_frame`. Dès qu'il est baissé, le tampon
+         *       appartient à la boucle principale.
+         */
+        volatile bool _ready;
+
+        /**
+         * @brief Nombre de tops restant avant l'échéance de l'image affichée.
+         */
+        uint8_t _countdown;
+
+        /**
+         * @brief Nombre de tops écoulés depuis une échéance manquée.
+         */
+        uint8_t _late;
+
+        /**
+         * @brief Nombre d'images appliquées.
+         */
+        uint32_t _frames;
+
+        /**
+         * @brief Nombre d'échéances manquées.
+         */
+        uint16_t _missed;
+
+        /**
+         * @brief Pire latence constatée (exprimée en périodes du Timer1, soit 0,5 µs).
+         */
+        uint32_t _worst_latency;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param bank Rampe de LEDs sur laquelle les images sont appliquées.
+         */
+        FrameClock(LedBank &bank);
+
+        /**
+         * @brief Démarrage de l'horloge.
+         *
+         * @param tick_us Période des tops d'horloge (exprimée en microsecondes, 32767 au plus).
+         *
+         * @note Cette méthode doit être appelée dans setup(), puisque le
+         *       framework Arduino reconfigure le Timer1 avant d'exécuter setup().
+         *       Elle peut être rappelée à tout moment pour changer de période.
+         */
+        void begin(const uint16_t tick_us);
+
+        /**
+         * @brief Arrêt de l'horloge.
+         */
+        void end();
+
+        /**
+         * @brief Détermine si l'horloge attend la prochaine image.
+         *
+         * @return true  si la boucle principale peut préparer l'image suivante,
+         *         false si l'image suivante est déjà prête.
+         */
+        bool needsFrame() const;
+
+        /**
+         * @brief Fournit la prochaine image à appliquer.
+         *
+         * @param frame    Image à appliquer (`bank.frameSize()` octets).
+         * @param duration Durée d'affichage de l'image (exprimée en nombre de tops).
+         *
+         * @note L'image est recopiée : le tampon de l'appelant peut être
+         *       réutilisé dès le retour de la méthode. Il ne faut appeler
+         *       cette méthode que lorsque needsFrame() est vrai.
+         */
+        void queue(const uint8_t *frame, const uint8_t duration);
+
+        /**
+         * @brief Lecture des statistiques de fonctionnement.
+         */
+        Stats stats() const;
+
+        /**
+         * @brief Remise à zéro des statistiques de fonctionnement.
+         */
+        void resetStats();
+
+        /**
+         * @brief Traitement d'un top d'horloge.
+         *
+         * @note Cette méthode est appelée par la routine d'interruption du
+         *       Timer1 : elle ne doit pas être appelée directement.
+         */
+        void tick();
+
+};
\ No newline at end of file
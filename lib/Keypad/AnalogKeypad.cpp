@@ -0,0 +1,83 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe AnalogKeypad
+ * -----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe AnalogKeypad avant de les définir.
+ */
+#include "AnalogKeypad.h"
+#include <util/atomic.h>
+
+/**
+ * @brief Clavier associé à la routine d'interruption du convertisseur.
+ *
+ * @note Il n'existe qu'un seul convertisseur, donc un seul clavier actif à la fois.
+ */
+static AnalogKeypad *active_keypad = nullptr;
+
+ISR(ADC_vect) {
+    active_keypad->sample(ADC);
+}
+
+AnalogKeypad::AnalogKeypad(const uint8_t channel, const uint16_t *limits, const uint8_t count)
+    : _channel(channel & 0x7), _limits(limits), _count(count), _value(1023) {}
+
+void AnalogKeypad::begin() {
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+
+        active_keypad = this;
+
+        // Tension de référence AVcc, résultat aligné à droite.
+        ADMUX  = _BV(REFS0) | _channel;
+
+        // Déclenchement automatique en mode libre.
+        ADCSRB = 0;
+
+        // L'étage d'entrée numérique de la broche est désactivé : il
+        // consommerait inutilement avec une tension intermédiaire. A6 et A7
+        // n'en ont pas (les bits 6 et 7 de DIDR0 sont réservés).
+        if (_channel < 6) DIDR0 |= _BV(_channel);
+
+        // Activation du convertisseur, de son interruption et du déclenchement
+        // automatique, prédiviseur de 128, puis lancement de la première conversion.
+        ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADATE) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+
+    }
+
+}
+
+void AnalogKeypad::end() {
+    ADCSRA = 0;
+    if (_channel < 6) DIDR0 &= ~_BV(_channel);
+}
+
+uint16_t AnalogKeypad::value() const {
+
+    uint16_t value;
+
+    // Une lecture sur 16 bits n'est pas atomique sur un processeur 8 bits.
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        value = _value;
+    }
+
+    return value;
+
+}
+
+uint8_t AnalogKeypad::key() const {
+    return decode(value(), _limits, _count);
+}
+
+void AnalogKeypad::sample(const uint16_t value) {
+    _value = value;
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la lecture d'un clavier de
+ * boutons montés sur une échelle de résistances (une seule entrée analogique)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe AnalogKeypad
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe AnalogKeypad.
+ *
+ * @note Les boutons sont reliés à une échelle de résistances (diviseurs de
+ *       tension) : chaque bouton enfoncé impose une tension différente sur
+ *       une même entrée analogique. Il suffit alors de déterminer dans quelle
+ *       bande de tension se situe la mesure pour savoir quel bouton est
+ *       enfoncé. On lit ainsi jusqu'à une dizaine de boutons sur une seule
+ *       broche, mais un seul bouton à la fois (si plusieurs boutons sont
+ *       enfoncés, seul celui de plus faible tension est reconnu).
+ *
+ *       Les bandes sont décrites par leurs bornes supérieures, rangées dans
+ *       l'ordre croissant : le bouton k est reconnu lorsque la mesure est
+ *       inférieure à limits[k] (et supérieure ou égale à limits[k - 1]).
+ *       Au-delà de la dernière borne, aucun bouton n'est enfoncé. Le plus
+ *       simple est de placer chaque borne à mi-chemin entre les mesures
+ *       nominales de deux boutons voisins.
+ *
+ *       La fonction analogRead() bloque le programme pendant toute la durée
+ *       d'une conversion (environ 112 µs). Ici, le convertisseur analogique-
+ *       numérique (ADC) fonctionne en mode libre (free-running) : il enchaîne
+ *       les conversions de lui-même, et une routine d'interruption mémorise
+ *       chaque résultat. La boucle principale n'a plus qu'à lire la dernière
+ *       mesure, sans jamais attendre.
+ *
+ *       Le convertisseur est alors entièrement réservé au clavier : la
+ *       fonction analogRead() ne doit plus être utilisée.
+ *
+ *       Les boutons décodés ne sont pas déparasités ici : chacun d'eux doit
+ *       être lu par un bouton virtuel (KuhnButton ou AdafruitButton), qui se
+ *       charge du déparasitage et de l'interprétation de son état, exactement
+ *       comme pour un bouton relié à une broche numérique :
+ *
+ *           uint8_t key = keypad.key();
+ *           for (uint8_t k=0; k<count; k++) button[k].read(key == k);
+ *
+ *       Les mesures transitoires, lorsque la tension passe d'une bande à
+ *       l'autre, sont ainsi filtrées comme de simples rebonds.
+ */
+class AnalogKeypad {
+
+    private:
+
+        /**
+         * @brief Canal d'entrée analogique (0 pour A0, 1 pour A1, etc.)
+         */
+        uint8_t _channel;
+
+        /**
+         * @brief Bornes supérieures des bandes de tension de chaque bouton.
+         */
+        const uint16_t *_limits;
+
+        /**
+         * @brief Nombre de boutons du clavier.
+         */
+        uint8_t _count;
+
+        /**
+         * @brief Dernière mesure effectuée par le convertisseur.
+         *
+         * @note Cet attribut est modifié par la routine d'interruption du
+         *       convertisseur, d'où le mot clef `volatile`.
+         */
+        volatile uint16_t _value;
+
+    public:
+
+        /**
+         * @brief Valeur renvoyée par key() lorsqu'aucun bouton n'est enfoncé.
+         */
+        static const uint8_t NO_KEY = 0xff;
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param channel Canal d'entrée analogique (0 pour A0, 1 pour A1, etc.)
+         * @param limits  Bornes supérieures des bandes de tension, dans l'ordre croissant.
+         * @param count   Nombre de boutons du clavier.
+         */
+        AnalogKeypad(const uint8_t channel, const uint16_t *limits, const uint8_t count);
+
+        /**
+         * @brief Démarrage des conversions en mode libre.
+         *
+         * @note Avec un prédiviseur de 128, le convertisseur est cadencé à 125 kHz
+         *       et effectue une conversion toutes les 104 µs (13 cycles).
+         */
+        void begin();
+
+        /**
+         * @brief Arrêt des conversions.
+         */
+        void end();
+
+        /**
+         * @brief Dernière mesure effectuée par le convertisseur (0 à 1023).
+         */
+        uint16_t value() const;
+
+        /**
+         * @brief Indice du bouton enfoncé, ou NO_KEY si aucun ne l'est.
+         */
+        uint8_t key() const;
+
+        /**
+         * @brief Mémorise le résultat d'une conversion.
+         *
+         * @note Cette méthode est appelée par la routine d'interruption du
+         *       convertisseur et ne doit pas être appelée directement.
+         */
+        void sample(const uint16_t value);
+
+        /**
+         * @brief Décodage d'une mesure.
+         *
+         * @param value  Mesure délivrée par le convertisseur (0 à 1023).
+         * @param limits Bornes supérieures des bandes de tension, dans l'ordre croissant.
+         * @param count  Nombre de boutons.
+         *
+         * @return Indice du bouton correspondant à la mesure, ou NO_KEY.
+         *
+         * @note Cette fonction ne dépend d'aucun registre : elle est définie
+         *       ici, hors de AnalogKeypad.cpp et de sa routine
+         *       d'interruption, pour être vérifiée sur un ordinateur avec
+         *       des mesures fictives.
+         */
+        static uint8_t decode(const uint16_t value, const uint16_t *limits, const uint8_t count) {
+
+            for (uint8_t k=0; k<count; k++) {
+                if (value < limits[k]) return k;
+            }
+
+            return NO_KEY;
+
+        }
+
+};
\ No newline at end of file
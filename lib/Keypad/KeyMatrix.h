@@ -0,0 +1,459 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la lecture d'un clavier
+ * matriciel (jusqu'à 8 lignes et 8 colonnes, soit 64 touches)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe KeyMatrix
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <PinSetup.h>
+#include <util/atomic.h>
+
+/**
+ * @brief Définition de la classe KeyMatrix.
+ *
+ * @tparam ROWS Nombre de lignes (de 1 à 8).
+ * @tparam COLS Nombre de colonnes (de 1 à 8).
+ * @tparam B    Modèle de bouton utilisé pour déparasiter chaque touche
+ *              (KuhnButton ou AdafruitButton).
+ *
+ * @note Les touches sont câblées à l'intersection d'une ligne et d'une
+ *       colonne : ROWS + COLS broches suffisent pour lire ROWS x COLS touches.
+ *       La touche de la ligne r et de la colonne c porte l'indice r x COLS + c.
+ *
+ *       Les colonnes sont configurées en entrée, avec leur résistance de
+ *       tirage. Les lignes sont en haute impédance, sauf la ligne "active",
+ *       portée au niveau bas : une touche enfoncée sur cette ligne tire sa
+ *       colonne au niveau bas.
+ *
+ *       Le balayage est effectué par la routine d'interruption du Timer2, à
+ *       raison d'une ligne par top d'horloge : les colonnes de la ligne active
+ *       sont lues (elle est active depuis le top précédent, ses niveaux sont
+ *       donc stabilisés), puis la ligne suivante est activée. Le coût de la
+ *       routine est constant : COLS lectures de broches et deux écritures,
+ *       quel que soit le nombre de touches enfoncées. Elle doit être déclarée
+ *       dans le programme principal :
+ *
+ *           ISR(TIMER2_COMPA_vect) { keypad.scan(); }
+ *
+ *       Les balayages complets sont conservés dans une petite file (les
+ *       _FRAMES - 1 derniers). La boucle principale appelle update(), qui
+ *       les traite tous, dans l'ordre : chaque touche est lue par un bouton
+ *       virtuel de type B, qui se charge du déparasitage et de
+ *       l'interprétation de son état (free, pressed, held, released). Le
+ *       déparasitage suit ainsi la cadence du balayage, même lorsque la
+ *       boucle principale est plus lente qu'un balayage complet. Les appuis
+ *       et les relâchements sont en outre déposés dans une file
+ *       d'événements.
+ *
+ *       Sans diode sur chaque touche, trois touches enfoncées aux sommets
+ *       d'un rectangle font apparaître la quatrième (touche "fantôme") : le
+ *       courant passe de l'une à l'autre. Ce cas est détecté dès que deux
+ *       lignes partagent au moins deux colonnes enfoncées. Le balayage est
+ *       alors ignoré et les touches conservent leur état précédent, tant
+ *       que la configuration reste ambiguë.
+ *
+ *       Attention : chaque bouton virtuel occupe une dizaine d'octets de
+ *       mémoire vive (640 octets pour 64 touches), et la file des
+ *       balayages _FRAMES x ROWS octets.
+ */
+template <uint8_t ROWS, uint8_t COLS, class B>
+class KeyMatrix {
+
+    static_assert(ROWS >= 1 && ROWS <= 8 && COLS >= 1 && COLS <= 8, "key matrix is limited to 8 rows and 8 columns");
+
+    public:
+
+        /**
+         * @brief Nombre de touches du clavier.
+         */
+        static const uint8_t SIZE = ROWS * COLS;
+
+        /**
+         * @brief Événement émis lors de l'appui ou du relâchement d'une touche.
+         */
+        struct Event {
+            uint8_t key = 0;       // Indice de la touche.
+            bool pressed = false;  // true pour un appui, false pour un relâchement.
+        };
+
+    private:
+
+        /**
+         * @brief Capacité de la file d'événements (puissance de 2).
+         */
+        static const uint8_t _QUEUE_SIZE = 16;
+
+        /**
+         * @brief Capacité de la file des balayages (puissance de 2), dont
+         *        un emplacement est toujours en cours de remplissage.
+         */
+        static const uint8_t _FRAMES = 4;
+
+        /**
+         * @brief Broches des lignes et des colonnes.
+         */
+        const uint8_t *_row_pins, *_col_pins;
+
+        /**
+         * @brief Registres de direction (DDRx) des lignes.
+         */
+        volatile uint8_t *_row_ddr[ROWS];
+
+        /**
+         * @brief Masques de bit des lignes.
+         */
+        uint8_t _row_mask[ROWS];
+
+        /**
+         * @brief Registres d'entrée (PINx) des colonnes.
+         */
+        volatile uint8_t *_col_in[COLS];
+
+        /**
+         * @brief Masques de bit des colonnes.
+         */
+        uint8_t _col_mask[COLS];
+
+        /**
+         * @brief Ligne active.
+         */
+        volatile uint8_t _row;
+
+        /**
+         * @brief File des balayages : colonnes enfoncées de chaque ligne,
+         *        relevées par la routine d'interruption.
+         *
+         * @note Le balayage n occupe l'emplacement n % _FRAMES.
+         */
+        volatile uint8_t _frames[_FRAMES][ROWS];
+
+        /**
+         * @brief Nombre de balayages complets effectués (modulo 256).
+         */
+        volatile uint8_t _scans;
+
+        /**
+         * @brief Nombre de balayages complets déjà traités par update().
+         */
+        uint8_t _processed;
+
+        /**
+         * @brief Dernier balayage retenu (non ambigu).
+         */
+        uint8_t _state[ROWS];
+
+        /**
+         * @brief Indique si le dernier balayage a été ignoré (touches fantômes).
+         */
+        bool _ghost;
+
+        /**
+         * @brief Boutons virtuels associés aux touches.
+         */
+        B _keys[SIZE];
+
+        /**
+         * @brief File d'événements (tampon circulaire).
+         */
+        Event _queue[_QUEUE_SIZE];
+
+        /**
+         * @brief Indices de lecture et d'écriture de la file.
+         */
+        uint8_t _head, _tail;
+
+        /**
+         * @brief Dépose un événement dans la file (ignoré si la file est pleine).
+         */
+        void _push(const uint8_t key, const bool pressed) {
+
+            if ((uint8_t) (_head - _tail) == _QUEUE_SIZE) return;
+
+            Event &event = _queue[_head++ & (_QUEUE_SIZE - 1)];
+            event.key     = key;
+            event.pressed = pressed;
+
+        }
+
+        /**
+         * @brief Lecture d'un balayage complet par les boutons virtuels.
+         *
+         * @param raw Colonnes enfoncées de chaque ligne.
+         */
+        void _process(const uint8_t *raw) {
+
+            _ghost = isAmbiguous(raw);
+
+            if (!_ghost) memcpy(_state, raw, ROWS);
+
+            uint8_t i = 0;
+
+            for (uint8_t r=0; r<ROWS; r++) {
+
+                uint8_t columns = _state[r];
+
+                for (uint8_t c=0; c<COLS; c++, i++, columns >>= 1) {
+
+                    B &key = _keys[i];
+                    key.read(columns & 0x1);
+
+                    if (key.isPressed())  _push(i, true);
+                    if (key.isReleased()) _push(i, false);
+
+                }
+
+            }
+
+        }
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param row_pins Broches des lignes (ROWS broches).
+         * @param col_pins Broches des colonnes (COLS broches).
+         *
+         * @note Le constructeur est évalué à la compilation (constexpr) : il
+         *       ne fait que mémoriser les broches, que configure() déclare
+         *       ensuite dans setup().
+         */
+        constexpr KeyMatrix(const uint8_t *row_pins, const uint8_t *col_pins)
+            : _row_pins(row_pins), _col_pins(col_pins), _row_ddr(), _row_mask(), _col_in(), _col_mask(),
+              _row(0), _frames(), _scans(0), _processed(0), _state(), _ghost(false), _keys(), _queue(), _head(0), _tail(0) {}
+
+        /**
+         * @brief Déclare les broches du clavier : lignes en haute impédance, colonnes en entrée avec tirage.
+         *
+         * @param pins Configuration des broches, appliquée par PinSetup::apply().
+         *
+         * @note Elle doit être appelée avant begin().
+         */
+        void configure(PinSetup &pins) {
+
+            for (uint8_t r=0; r<ROWS; r++) {
+
+                // Une ligne inactive est en haute impédance. Son bit PORTx reste
+                // à 0 : il suffit de la passer en sortie pour l'activer.
+                pins.input(_row_pins[r]);
+
+                _row_ddr[r]  = portModeRegister(digitalPinToPort(_row_pins[r]));
+                _row_mask[r] = digitalPinToBitMask(_row_pins[r]);
+
+            }
+
+            for (uint8_t c=0; c<COLS; c++) {
+
+                pins.input(_col_pins[c], true);
+
+                _col_in[c]   = portInputRegister(digitalPinToPort(_col_pins[c]));
+                _col_mask[c] = digitalPinToBitMask(_col_pins[c]);
+
+            }
+
+        }
+
+        /**
+         * @brief Démarrage du balayage par le Timer2.
+         *
+         * @param tick_us Période de balayage d'une ligne (de 4 à 1024 µs).
+         *
+         * @note Le Timer2 est configuré en mode CTC, avec un prédiviseur de 64
+         *       (résolution de 4 µs). Un balayage complet dure ROWS x tick_us :
+         *       c'est la période d'échantillonnage de chaque touche, dont il
+         *       faut tenir compte pour régler le seuil de KuhnButton.
+         */
+        void begin(const uint16_t tick_us) {
+
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+
+                *_row_ddr[_row] |= _row_mask[_row];
+
+#ifndef HOST_TEST
+                TCCR2A = _BV(WGM21);
+                TCCR2B = _BV(CS22);
+                OCR2A  = (tick_us >> 2) - 1;
+                TCNT2  = 0;
+                TIFR2  = _BV(OCF2A);
+                TIMSK2 = _BV(OCIE2A);
+#endif
+
+            }
+
+        }
+
+        /**
+         * @brief Arrêt du balayage : toutes les lignes repassent en haute impédance.
+         */
+        void end() {
+
+#ifndef HOST_TEST
+            TIMSK2 = 0;
+#endif
+            for (uint8_t r=0; r<ROWS; r++) *_row_ddr[r] &= ~_row_mask[r];
+
+        }
+
+        /**
+         * @brief Lecture de la ligne active et activation de la ligne suivante.
+         *
+         * @note Cette méthode doit être appelée par la routine d'interruption
+         *       du Timer2, et uniquement par elle.
+         */
+        void scan() {
+
+            uint8_t columns = 0;
+            uint8_t bit     = 1;
+
+            for (uint8_t c=0; c<COLS; c++, bit <<= 1) {
+                if (!(*_col_in[c] & _col_mask[c])) columns |= bit;
+            }
+
+            *_row_ddr[_row] &= ~_row_mask[_row];
+            store(columns);
+            *_row_ddr[_row] |= _row_mask[_row];
+
+        }
+
+        /**
+         * @brief Enregistre les colonnes enfoncées de la ligne active, et passe à la ligne suivante.
+         *
+         * @param columns Colonnes enfoncées (un bit par colonne).
+         *
+         * @note Cette méthode est appelée par scan(). Elle ne touche à aucun
+         *       registre : elle permet de simuler un clavier.
+         */
+        void store(const uint8_t columns) {
+
+            _frames[_scans & (_FRAMES - 1)][_row] = columns;
+
+            if (++_row == ROWS) {
+                _row = 0;
+                _scans++;
+            }
+
+        }
+
+        /**
+         * @brief Ligne active.
+         */
+        uint8_t row() const {
+            return _row;
+        }
+
+        /**
+         * @brief Traitement des balayages complets en attente, dans l'ordre.
+         *
+         * @return true si au moins un nouveau balayage complet a été traité.
+         *
+         * @note Seuls les _FRAMES - 1 derniers balayages sont conservés : si
+         *       la boucle principale tarde davantage, les plus anciens sont
+         *       perdus.
+         */
+        bool update() {
+
+            bool    processed = false;
+            uint8_t raw[ROWS];
+
+            for (;;) {
+
+                bool pending;
+
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+
+                    // Les balayages trop anciens ont été écrasés : on repart
+                    // du plus ancien encore disponible.
+                    if ((uint8_t) (_scans - _processed) >= _FRAMES) _processed = _scans - (_FRAMES - 1);
+
+                    pending = _scans != _processed;
+
+                    if (pending) {
+                        volatile uint8_t *frame = _frames[_processed++ & (_FRAMES - 1)];
+                        for (uint8_t r=0; r<ROWS; r++) raw[r] = frame[r];
+                    }
+
+                }
+
+                if (!pending) return processed;
+
+                _process(raw);
+                processed = true;
+
+            }
+
+        }
+
+        /**
+         * @brief Extrait l'événement le plus ancien de la file.
+         *
+         * @param event Événement extrait.
+         *
+         * @return false si la file est vide.
+         */
+        bool nextEvent(Event &event) {
+
+            if (_head == _tail) return false;
+
+            event = _queue[_tail++ & (_QUEUE_SIZE - 1)];
+
+            return true;
+
+        }
+
+        /**
+         * @brief Bouton virtuel associé à une touche.
+         *
+         * @param index Indice de la touche.
+         */
+        B &key(const uint8_t index) {
+            return _keys[index];
+        }
+
+        /**
+         * @brief Indique si le dernier balayage a été ignoré à cause de touches fantômes.
+         */
+        bool isGhosting() const {
+            return _ghost;
+        }
+
+        /**
+         * @brief Détermine si un balayage est ambigu (touches fantômes possibles).
+         *
+         * @param raw Colonnes enfoncées de chaque ligne.
+         *
+         * @return true si deux lignes partagent au moins deux colonnes enfoncées.
+         */
+        static bool isAmbiguous(const uint8_t *raw) {
+
+            for (uint8_t r=0; r<ROWS; r++) {
+                for (uint8_t s=r+1; s<ROWS; s++) {
+
+                    uint8_t shared = raw[r] & raw[s];
+
+                    // Au moins deux bits à 1 : on efface le bit de poids faible
+                    // et on vérifie qu'il en reste un.
+                    if (shared & (shared - 1)) return true;
+
+                }
+            }
+
+            return false;
+
+        }
+
+};
\ No newline at end of file
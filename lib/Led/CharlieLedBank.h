@@ -0,0 +1,327 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la commande d'une rampe de
+ * LEDs multiplexées selon la technique du charlieplexing
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe CharlieLedBank
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "LedBank.h"
+#include <Arduino.h>
+
+// -----------------------------------------------------------------------------
+// Correspondance entre les LEDs et les broches, calculée à la compilation
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Indice de la broche reliée à l'anode de la LED `led` (parmi `n` broches).
+ *
+ * @note Les LEDs sont regroupées par anode : les n-1 premières LEDs ont
+ *       leur anode sur la broche 0, les n-1 suivantes sur la broche 1, etc.
+ */
+constexpr uint8_t charlieAnode(const uint8_t n, const uint8_t led) {
+    return led / (n - 1);
+}
+
+/**
+ * @brief Indice de la broche reliée à la cathode de la LED `led` (parmi `n` broches).
+ *
+ * @note Pour une anode donnée, les cathodes parcourent toutes les autres
+ *       broches dans l'ordre croissant, en sautant celle de l'anode.
+ */
+constexpr uint8_t charlieCathode(const uint8_t n, const uint8_t led) {
+    return led % (n - 1) < charlieAnode(n, led) ? led % (n - 1) : led % (n - 1) + 1;
+}
+
+/**
+ * @brief Vérifie que les LEDs `i` à `n(n-1)-1` sont correctement câblées.
+ *
+ * @note Chaque LED doit relier deux broches distinctes, et deux LEDs
+ *       consécutives d'une même anode doivent avoir des cathodes croissantes,
+ *       ce qui garantit qu'aucun couple (anode, cathode) n'est utilisé deux fois.
+ */
+constexpr bool charlieCheck(const uint8_t n, const uint8_t i) {
+    return i >= n * (n - 1) ? true
+         : charlieAnode(n, i) != charlieCathode(n, i)
+        && charlieAnode(n, i) < n
+        && charlieCathode(n, i) < n
+        && (i % (n - 1) == 0 || charlieCathode(n, i - 1) < charlieCathode(n, i))
+        && charlieCheck(n, i + 1);
+}
+
+static_assert(charlieCheck(2, 0) && charlieCheck(3, 0) && charlieCheck(4, 0) &&
+              charlieCheck(5, 0) && charlieCheck(6, 0), "charlieplexing table is inconsistent");
+
+static_assert(charlieAnode(5,  0) == 0 && charlieCathode(5,  0) == 1 &&
+              charlieAnode(5,  3) == 0 && charlieCathode(5,  3) == 4 &&
+              charlieAnode(5,  4) == 1 && charlieCathode(5,  4) == 0 &&
+              charlieAnode(5,  5) == 1 && charlieCathode(5,  5) == 2 &&
+              charlieAnode(5, 19) == 4 && charlieCathode(5, 19) == 3, "charlieplexing mapping is wrong");
+
+/**
+ * @brief Séquence d'indices 0, 1, ..., K-1 connue à la compilation.
+ *
+ * @note Elle permet de générer une table constante en appliquant une fonction
+ *       `constexpr` à chacun des indices.
+ */
+template <uint8_t... I> struct CharlieIndices {};
+
+template <uint8_t K, uint8_t... I>
+struct CharlieMakeIndices : CharlieMakeIndices<K - 1, K - 1, I...> {};
+
+template <uint8_t... I>
+struct CharlieMakeIndices<0, I...> { typedef CharlieIndices<I...> type; };
+
+/**
+ * @brief Table de correspondance des LEDs, stockée en mémoire Flash.
+ *
+ * @note Chaque octet code l'anode (quartet de poids fort) et la cathode
+ *       (quartet de poids faible) d'une LED.
+ */
+template <uint8_t N, class S> struct CharlieTable;
+
+template <uint8_t N, uint8_t... I>
+struct CharlieTable<N, CharlieIndices<I...>> {
+    static const uint8_t pins[sizeof...(I)];
+};
+
+template <uint8_t N, uint8_t... I>
+const uint8_t CharlieTable<N, CharlieIndices<I...>>::pins[sizeof...(I)] PROGMEM = {
+    (uint8_t) (charlieAnode(N, I) << 4 | charlieCathode(N, I))...
+};
+
+// -----------------------------------------------------------------------------
+// Rampe de LEDs multiplexées
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Définition de la classe CharlieLedBank.
+ *
+ * @tparam N Nombre de broches (de 2 à 6), qui commandent N x (N-1) LEDs.
+ *
+ * @note Le charlieplexing exploite les trois états d'une broche (niveau
+ *       haut, niveau bas, haute impédance) : entre chaque paire de broches,
+ *       on câble deux LEDs tête-bêche. Avec 5 broches, on commande ainsi
+ *       20 LEDs, là où le câblage direct n'en commanderait que 5.
+ *
+ *       Les N broches doivent être les N premiers bits d'un même port, par
+ *       exemple A0 à A4 (PORTC), de sorte que chaque configuration des
+ *       broches s'applique en une seule écriture des registres DDRx et PORTx.
+ *
+ *       Les LEDs ne peuvent pas être allumées toutes en même temps : la rampe
+ *       est balayée anode par anode ("slot" par "slot") par la routine
+ *       d'interruption du Timer2. Pour chaque slot, l'anode est portée au
+ *       niveau haut, les cathodes des LEDs allumées au niveau bas, et toutes
+ *       les autres broches restent en haute impédance.
+ *
+ *       Les masques DDRx et PORTx de chaque slot sont précalculés par la
+ *       méthode write() : la routine d'interruption se contente de les
+ *       appliquer, en un temps court et constant. Elle doit être déclarée
+ *       dans le programme principal :
+ *
+ *           ISR(TIMER2_COMPA_vect) { leds.refresh(); }
+ */
+template <uint8_t N>
+class CharlieLedBank : public LedBank {
+
+    static_assert(N >= 2 && N <= 6, "charlieplexing needs 2 to 6 pins");
+
+    private:
+
+        /**
+         * @brief Masque de toutes les broches de la rampe dans le port.
+         */
+        static const uint8_t _ALL = (1 << N) - 1;
+
+        /**
+         * @brief Table de correspondance des LEDs, générée à la compilation.
+         */
+        typedef CharlieTable<N, typename CharlieMakeIndices<N * (N - 1)>::type> _Table;
+
+        /**
+         * @brief Registre de direction (DDRx) du port des broches.
+         */
+        volatile uint8_t &_ddr;
+
+        /**
+         * @brief Registre de sortie (PORTx) du port des broches.
+         */
+        volatile uint8_t &_port;
+
+        /**
+         * @brief Masques DDRx des slots, en deux exemplaires (double tampon).
+         *
+         * @note La routine d'interruption lit l'un des exemplaires pendant que
+         *       la méthode write() prépare l'autre.
+         */
+        uint8_t _ddr_mask[2][N];
+
+        /**
+         * @brief Exemplaire des masques lu par la routine d'interruption.
+         */
+        uint8_t * volatile _front;
+
+        /**
+         * @brief Slot en cours d'affichage.
+         */
+        uint8_t _slot;
+
+        /**
+         * @brief Masque de l'anode du slot en cours d'affichage.
+         *
+         * @note Il est mis à jour par décalage, pour éviter un décalage
+         *       variable (donc une boucle) dans la routine d'interruption.
+         */
+        uint8_t _anode;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param ddr  Registre de direction du port des broches (par exemple DDRC).
+         * @param port Registre de sortie du port des broches (par exemple PORTC).
+         *
+         * @note Le constructeur ne touche pas aux registres : les broches ne
+         *       passent en haute impédance qu'au démarrage du balayage.
+         */
+        CharlieLedBank(volatile uint8_t &ddr, volatile uint8_t &port)
+            : LedBank(N * (N - 1)), _ddr(ddr), _port(port), _ddr_mask(), _front(_ddr_mask[0]), _slot(0), _anode(1) {}
+
+        /**
+         * @brief Démarrage du balayage des slots par le Timer2.
+         *
+         * @param refresh_hz Fréquence de rafraîchissement de la rampe complète.
+         *
+         * @note Le Timer2 est configuré en mode CTC, avec un prédiviseur de 256
+         *       (62,5 kHz) : la fréquence des slots (N x refresh_hz) est
+         *       ramenée entre 245 Hz et 62,5 kHz (voir ocrFor()).
+         */
+        void begin(const uint16_t refresh_hz) {
+
+            // Toutes les broches en haute impédance.
+            _ddr  &= ~_ALL;
+            _port &= ~_ALL;
+
+#ifndef HOST_TEST
+            TCCR2A = _BV(WGM21);
+            TCCR2B = _BV(CS22) | _BV(CS21);
+            OCR2A  = ocrFor(refresh_hz);
+            TCNT2  = 0;
+            TIMSK2 = _BV(OCIE2A);
+#endif
+
+        }
+
+        /**
+         * @brief Valeur du registre OCR2A pour une fréquence de rafraîchissement donnée.
+         *
+         * @param refresh_hz Fréquence de rafraîchissement de la rampe complète.
+         *
+         * @note OCR2A n'a que 8 bits : une fréquence trop basse est ramenée à
+         *       la fréquence minimale (245 Hz / N), une fréquence trop haute à
+         *       la fréquence maximale (62,5 kHz / N), au lieu de déborder.
+         */
+        static uint8_t ocrFor(const uint16_t refresh_hz) {
+
+            uint32_t slot_hz = (uint32_t) refresh_hz * N;
+            uint32_t top     = slot_hz ? F_CPU / 256 / slot_hz : 256;
+
+            if (top < 1)   top = 1;
+            if (top > 256) top = 256;
+
+            return top - 1;
+
+        }
+
+        /**
+         * @brief Arrêt du balayage : toutes les LEDs sont éteintes.
+         */
+        void end() {
+
+#ifndef HOST_TEST
+            TIMSK2 = 0;
+#endif
+            _ddr  &= ~_ALL;
+            _port &= ~_ALL;
+
+        }
+
+        /**
+         * @brief Affichage d'une image sur la rampe de LEDs.
+         *
+         * @param frame Image à afficher (un bit par LED).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode write() déclarée par le modèle parent LedBank.
+         *
+         *       L'image est traduite en masques DDRx, un par slot, dans
+         *       l'exemplaire qui n'est pas en cours d'affichage. Les deux
+         *       exemplaires sont ensuite permutés en une seule opération.
+         */
+        void write(const uint8_t *frame) override {
+
+            uint8_t *back = _front == _ddr_mask[0] ? _ddr_mask[1] : _ddr_mask[0];
+
+            memset(back, 0, N);
+
+            uint8_t byte = 0;
+            for (uint8_t i=0; i<_size; i++) {
+
+                if (!(i & 0x7)) byte = *frame++;
+
+                if (byte & 0x1) {
+                    uint8_t pins = pgm_read_byte(&_Table::pins[i]);
+                    back[pins >> 4] |= _BV(pins >> 4) | _BV(pins & 0xF);
+                }
+
+                byte >>= 1;
+
+            }
+
+            uint8_t sreg = SREG;
+            cli();
+            _front = back;
+            SREG = sreg;
+
+        }
+
+        /**
+         * @brief Affichage du slot suivant.
+         *
+         * @note Cette méthode doit être appelée par la routine d'interruption
+         *       du Timer2, et uniquement par elle.
+         */
+        void refresh() {
+
+            _anode <<= 1;
+
+            if (++_slot == N) {
+                _slot  = 0;
+                _anode = 1;
+            }
+
+            // On passe d'abord toutes les broches en haute impédance pour
+            // éviter qu'une LED du slot précédent ne s'allume fugitivement,
+            // puis on porte l'anode du slot au niveau haut et on configure
+            // en sortie l'anode et les cathodes des LEDs allumées.
+            _ddr  &= ~_ALL;
+            _port  = (_port & ~_ALL) | _anode;
+            _ddr  |= _front[_slot];
+
+        }
+
+};
\ No newline at end of file
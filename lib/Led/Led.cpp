@@ -16,8 +16,8 @@
  */
 #include "Led.h"
 
-Led::Led(const uint8_t pin) {
-    pinMode(_pin = pin, OUTPUT);
+void Led::configure(PinSetup &pins) const {
+    pins.output(_pin, LOW);
 }
 
 void Led::light(const bool state) {
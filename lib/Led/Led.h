@@ -19,12 +19,17 @@
 #pragma once
 
 #include <Arduino.h>
+#include <PinSetup.h>
 
 /**
  * @brief Définition de la classe LED.
  * 
  * @note Cette classe définit un modèle générique qui va nous permettre
  *       de commander chacune des LEDs du chenillard.
+ *
+ *       La construction d'une LED ne touche à aucun registre : la broche de
+ *       commande n'est configurée qu'au démarrage du programme, dans setup(),
+ *       par configure() et PinSetup::apply().
  */
 class Led {
 
@@ -52,8 +57,18 @@ class Led {
          * 
          * @note Le constructeur attend un argument qui permet de préciser
          *       quelle sera la broche de commande de la LED.
+         *
+         *       Il est évalué à la compilation (constexpr) : une LED globale
+         *       est déjà construite au démarrage du microcontrôleur.
          */
-        Led(const uint8_t pin);
+        constexpr Led(const uint8_t pin) : _pin(pin), _state(false) {}
+
+        /**
+         * @brief Déclare la broche de commande de la LED, en sortie, LED éteinte.
+         *
+         * @param pins Configuration des broches, appliquée par PinSetup::apply().
+         */
+        void configure(PinSetup &pins) const;
 
         /**
          * @brief Allume ou éteint la LED.
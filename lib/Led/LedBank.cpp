@@ -0,0 +1,25 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe LedBank
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe LedBank avant de les définir.
+ */
+#include "LedBank.h"
+
+uint8_t LedBank::size() const {
+    return _size;
+}
+
+uint8_t LedBank::frameSize() const {
+    return (_size + 7) >> 3;
+}
\ No newline at end of file
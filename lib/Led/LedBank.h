@@ -0,0 +1,86 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet abstrait pour la commande d'une
+ * rampe de LEDs (banc de LEDs) image par image
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe LedBank
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe abstraite LedBank.
+ *
+ * @note Là où la classe Led commande une LED à la fois, un banc de LEDs
+ *       reçoit d'un seul coup une "image" (frame) décrivant l'état de
+ *       toutes les LEDs de la rampe.
+ *
+ *       Une image est une séquence d'octets dans laquelle chaque bit
+ *       représente une LED :
+ *
+ *           - le bit i de l'octet 0 commande la LED d'indice i    (0 à 7)
+ *           - le bit i de l'octet 1 commande la LED d'indice 8+i  (8 à 15)
+ *           - etc.
+ *
+ *       C'est exactement la convention adoptée par la fonction ledWrite()
+ *       des premiers exercices : pour une rampe de 8 LEDs, l'image tient
+ *       dans un seul octet.
+ *
+ *       Comme la classe Button, ce modèle est abstrait : la manière de
+ *       transmettre l'image aux LEDs (broches de la carte, registres à
+ *       décalage, etc.) sera précisée par les classes dérivées, qui
+ *       devront définir la méthode write().
+ */
+class LedBank {
+
+    protected:
+
+        /**
+         * @brief Nombre de LEDs de la rampe.
+         */
+        uint8_t _size;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param size Nombre de LEDs de la rampe.
+         */
+        constexpr LedBank(const uint8_t size) : _size(size) {}
+
+        /**
+         * @brief Nombre de LEDs de la rampe.
+         */
+        uint8_t size() const;
+
+        /**
+         * @brief Nombre d'octets nécessaires pour coder une image de la rampe.
+         */
+        uint8_t frameSize() const;
+
+        /**
+         * @brief Affichage d'une image sur la rampe de LEDs.
+         *
+         * @param frame Image à afficher (`frameSize()` octets).
+         *
+         * @note L'image est appliquée d'un seul bloc à toute la rampe, et
+         *       le temps d'exécution de cette méthode ne doit dépendre que
+         *       du nombre de LEDs, et pas du contenu de l'image.
+         */
+        virtual void write(const uint8_t *frame) = 0;
+
+};
\ No newline at end of file
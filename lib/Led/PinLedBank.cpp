@@ -0,0 +1,71 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe PinLedBank
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe PinLedBank avant de les définir.
+ */
+#include "PinLedBank.h"
+
+void PinLedBank::configure(PinSetup &pins) {
+
+    _ports = 0;
+
+    for (uint8_t i=0; i<_size; i++) {
+
+        pins.output(_pins[i], LOW);
+
+        volatile uint8_t *out = portOutputRegister(digitalPinToPort(_pins[i]));
+
+        // On recherche si le port de la LED a déjà été recensé...
+        uint8_t slot = 0;
+        while (slot < _ports && _out[slot] != out) slot++;
+
+        // ... sinon on l'ajoute à la liste des ports commandés par la rampe.
+        if (slot == _ports) {
+            _out[_ports]       = out;
+            _port_mask[_ports] = 0;
+            _ports++;
+        }
+
+        _slot[i]          = slot;
+        _mask[i]          = digitalPinToBitMask(_pins[i]);
+        _port_mask[slot] |= _mask[i];
+
+    }
+
+}
+
+void PinLedBank::write(const uint8_t *frame) {
+
+    uint8_t bits[_MAX_PORTS] = { 0 };
+
+    // Composition des nouvelles valeurs des ports, LED par LED.
+    // Le nombre d'itérations ne dépend que de la taille de la rampe.
+    uint8_t byte = 0;
+    for (uint8_t i=0; i<_size; i++) {
+        if (!(i & 0x7)) byte = *frame++;
+        if (byte & 0x1) bits[_slot[i]] |= _mask[i];
+        byte >>= 1;
+    }
+
+    // Écriture de chaque port en une seule fois, à l'abri des interruptions
+    // pour qu'une routine d'interruption qui modifierait un autre bit du même
+    // port ne soit pas écrasée par notre lecture-modification-écriture.
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t p=0; p<_ports; p++) {
+        *_out[p] = (*_out[p] & ~_port_mask[p]) | bits[p];
+    }
+    SREG = sreg;
+
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la commande d'une rampe de
+ * LEDs reliées directement aux broches numériques de la carte Arduino
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe PinLedBank
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "LedBank.h"
+#include <Arduino.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Définition de la classe PinLedBank.
+ *
+ * @note Cette classe définit un modèle "concret" dérivé du modèle abstrait
+ *       défini par la classe LedBank, pour les LEDs câblées une par une sur
+ *       les broches de la carte (D5 à D12 sur notre montage).
+ *
+ *       Plutôt que d'appeler digitalWrite() pour chaque LED, ce qui impose
+ *       de retrouver à chaque fois le port et le bit associés à la broche,
+ *       on détermine une fois pour toutes, dans configure(), le port
+ *       (registre PORTx) et le masque de bit de chaque LED. Une image est
+ *       alors appliquée en composant la nouvelle valeur de chaque port, puis
+ *       en écrivant chaque port une seule fois.
+ *
+ *       Sur une Nano, les broches D5 à D12 se répartissent sur deux ports
+ *       (PORTD et PORTB) : l'affichage d'une image se résume donc à deux
+ *       écritures dans les registres, et les LEDs d'un même port changent
+ *       d'état simultanément.
+ */
+class PinLedBank : public LedBank {
+
+    private:
+
+        /**
+         * @brief Nombre maximal de LEDs gérées par la rampe.
+         */
+        static const uint8_t _MAX_LEDS = 16;
+
+        /**
+         * @brief Nombre maximal de ports distincts (PORTB, PORTC et PORTD sur l'ATmega328).
+         */
+        static const uint8_t _MAX_PORTS = 3;
+
+        /**
+         * @brief Broches de commande des LEDs, dans l'ordre de la rampe.
+         */
+        const uint8_t *_pins;
+
+        /**
+         * @brief Nombre de ports effectivement utilisés par la rampe.
+         */
+        uint8_t _ports;
+
+        /**
+         * @brief Registres de sortie (PORTx) des ports utilisés par la rampe.
+         */
+        volatile uint8_t *_out[_MAX_PORTS];
+
+        /**
+         * @brief Masque des bits de chaque port commandés par la rampe.
+         *
+         * @note Les autres bits du port (bouton, liaison série, etc.) ne
+         *       doivent surtout pas être modifiés lors de l'écriture d'une image.
+         */
+        uint8_t _port_mask[_MAX_PORTS];
+
+        /**
+         * @brief Indice (dans `_out`) du port de chaque LED.
+         */
+        uint8_t _slot[_MAX_LEDS];
+
+        /**
+         * @brief Masque de bit de chaque LED dans son port.
+         */
+        uint8_t _mask[_MAX_LEDS];
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param pins Broches de commande des LEDs, dans l'ordre de la rampe.
+         * @param size Nombre de LEDs (au plus 16).
+         *
+         * @note Le constructeur est évalué à la compilation (constexpr) : il
+         *       ne fait que mémoriser les broches, que configure() déclare
+         *       ensuite dans setup().
+         */
+        constexpr PinLedBank(const uint8_t *pins, const uint8_t size)
+            : LedBank(size > _MAX_LEDS ? _MAX_LEDS : size), _pins(pins), _ports(0),
+              _out(), _port_mask(), _slot(), _mask() {}
+
+        /**
+         * @brief Déclare les broches des LEDs, en sortie, LEDs éteintes.
+         *
+         * @param pins Configuration des broches, appliquée par PinSetup::apply().
+         *
+         * @note Les ports et les masques de bit des LEDs sont déterminés ici :
+         *       write() n'a aucun effet tant que configure() n'a pas été appelée.
+         */
+        void configure(PinSetup &pins);
+
+        /**
+         * @brief Affichage d'une image sur la rampe de LEDs.
+         *
+         * @param frame Image à afficher (un bit par LED).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode write() déclarée par le modèle parent LedBank.
+         */
+        void write(const uint8_t *frame) override;
+
+};
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe PixelStrip
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe PixelStrip avant de les définir.
+ */
+#include "PixelStrip.h"
+
+#if F_CPU != 16000000UL
+#error "PixelStrip transmit routine is cycle-counted for a 16 MHz clock"
+#endif
+
+void PixelStrip::configure(PinSetup &pins) {
+
+    pins.output(_pin, LOW);
+
+    _out  = portOutputRegister(digitalPinToPort(_pin));
+    _mask = digitalPinToBitMask(_pin);
+
+}
+
+uint16_t PixelStrip::count() const {
+    return _count;
+}
+
+void PixelStrip::setPixel(const uint16_t index, const uint8_t red, const uint8_t green, const uint8_t blue) {
+
+    if (index >= _count) return;
+
+    uint8_t *pixel = &_pixels[index * 3];
+
+    pixel[0] = green;
+    pixel[1] = red;
+    pixel[2] = blue;
+
+    _dirty = true;
+
+}
+
+void PixelStrip::clear() {
+    memset(_pixels, 0, _count * 3);
+    _dirty = true;
+}
+
+bool PixelStrip::isDirty() const {
+    return _dirty;
+}
+
+#ifndef HOST_TEST
+
+inline void PixelStrip::_transmit(volatile uint8_t *out, uint8_t hi, uint8_t lo, const uint8_t *ptr, uint16_t bytes) {
+
+    uint8_t byte, bit, next;
+
+    // Chaque bit dure exactement 20 cycles (1,25 µs). Le nombre de cycles
+    // de chaque instruction est indiqué en commentaire, ainsi que la date
+    // (en cycles) de son exécution dans la période du bit.
+    asm volatile(
+        "ld   %[byte], %a[ptr]+    \n\t" // 2       premier octet
+        "ldi  %[bit], 8            \n\t" // 1
+        "1:                        \n\t"
+        "st   %a[out], %[hi]       \n\t" // 2  t0   front montant
+        "mov  %[next], %[lo]       \n\t" // 1  t2
+        "sbrc %[byte], 7           \n\t" // 1  t3   (2 si le bit vaut 0)
+        "mov  %[next], %[hi]       \n\t" // 1  t4   (sauté si le bit vaut 0)
+        "nop                       \n\t" // 1  t5
+        "st   %a[out], %[next]     \n\t" // 2  t6   front descendant d'un bit à 0
+        "lsl  %[byte]              \n\t" // 1  t8
+        "nop                       \n\t" // 1  t9
+        "nop                       \n\t" // 1  t10
+        "nop                       \n\t" // 1  t11
+        "nop                       \n\t" // 1  t12
+        "st   %a[out], %[lo]       \n\t" // 2  t13  front descendant d'un bit à 1
+        "dec  %[bit]               \n\t" // 1  t15
+        "nop                       \n\t" // 1  t16
+        "nop                       \n\t" // 1  t17
+        "brne 1b                   \n\t" // 2  t18  bit suivant (1 cycle en fin d'octet)
+        "sbiw %[bytes], 1          \n\t" // 2       fin d'octet : le niveau bas du dernier
+        "breq 2f                   \n\t" // 1       bit est prolongé de 7 cycles, ce qui
+        "ld   %[byte], %a[ptr]+    \n\t" // 2       reste dans les tolérances ; l'octet
+        "ldi  %[bit], 8            \n\t" // 1       suivant n'est pas lu après le dernier
+        "rjmp 1b                   \n\t" // 2       octet du tampon
+        "2:                        \n\t"
+        : [ptr]   "+x" (ptr),
+          [bytes] "+w" (bytes),
+          [byte]  "=&r" (byte),
+          [bit]   "=&d" (bit),
+          [next]  "=&r" (next)
+        : [out]   "z" (out),
+          [hi]    "r" (hi),
+          [lo]    "r" (lo)
+        : "memory"
+    );
+
+}
+
+#endif
+
+bool PixelStrip::show() {
+
+    if (!_dirty || !_count || !_out) return false;
+
+    uint8_t sreg = SREG;
+    cli();
+
+    // Niveaux du port avec la broche de données au niveau haut ou bas,
+    // calculés une fois pour toutes pour n'avoir plus qu'à les écrire.
+    uint8_t hi = *_out |  _mask;
+    uint8_t lo = *_out & ~_mask;
+
+    _transmit(_out, hi, lo, _pixels, _count * 3);
+
+    SREG = sreg;
+
+    _dirty = false;
+
+    return true;
+
+}
+
+uint16_t PixelStrip::transmitTimeUs() const {
+    return ((uint32_t) _count * 3 * _CYCLES_PER_BYTE + (F_CPU / 1000000UL) - 1) / (F_CPU / 1000000UL);
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la commande d'un ruban de LEDs
+ * adressables WS2812 (NeoPixel) sur une seule broche
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe PixelStrip
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Définition de la classe PixelStrip.
+ *
+ * @note Chaque LED (pixel) d'un ruban WS2812 intègre son propre contrôleur.
+ *       Les pixels sont chaînés et reçoivent leurs couleurs sur une seule
+ *       broche, sous la forme d'un train de bits à 800 kHz : chaque bit dure
+ *       1,25 µs, et c'est la durée de l'impulsion haute qui code sa valeur :
+ *
+ *           bit 0 : 0,375 µs au niveau haut (6 cycles d'horloge à 16 MHz)
+ *           bit 1 : 0,8125 µs au niveau haut (13 cycles)
+ *
+ *       Chaque pixel reçoit 3 octets, dans l'ordre vert, rouge, bleu (GRB),
+ *       bit de poids fort en tête. Le premier pixel conserve les 24 premiers
+ *       bits et transmet les suivants au pixel suivant. Un silence d'au moins
+ *       50 µs (280 µs pour les versions récentes) verrouille les couleurs.
+ *
+ *       Ces durées sont bien trop courtes pour digitalWrite() : la routine de
+ *       transmission est écrite en assembleur, au cycle près, pour une carte
+ *       cadencée à 16 MHz. Les interruptions doivent être désactivées pendant
+ *       toute la transmission, soit environ 10,4 µs par octet (1,88 ms pour
+ *       60 pixels). Au-delà de 63 pixels, la transmission dépasse 2 ms et
+ *       millis() prend du retard à chaque image.
+ *
+ *       Le tampon d'image est fourni par le programme principal (3 octets par
+ *       pixel, déjà dans l'ordre GRB) et n'est retransmis que s'il a été
+ *       modifié depuis la dernière transmission. Un tampon global est nul au
+ *       démarrage : tous les pixels sont éteints.
+ */
+class PixelStrip {
+
+    private:
+
+        /**
+         * @brief Nombre de cycles d'horloge nécessaires à la transmission d'un octet.
+         */
+        static const uint8_t _CYCLES_PER_BYTE = 167;
+
+        /**
+         * @brief Broche de données du ruban.
+         */
+        uint8_t _pin;
+
+        /**
+         * @brief Registre de sortie (PORTx) de la broche de données.
+         */
+        volatile uint8_t *_out;
+
+        /**
+         * @brief Masque de bit de la broche de données.
+         */
+        uint8_t _mask;
+
+        /**
+         * @brief Tampon d'image (3 octets par pixel, dans l'ordre GRB).
+         */
+        uint8_t *_pixels;
+
+        /**
+         * @brief Nombre de pixels du ruban.
+         */
+        uint16_t _count;
+
+        /**
+         * @brief Indique si l'image a été modifiée depuis la dernière transmission.
+         */
+        bool _dirty;
+
+        /**
+         * @brief Transmission des octets du tampon, bit de poids fort en tête.
+         *
+         * @param out   Registre de sortie de la broche de données.
+         * @param hi    Valeur du registre avec la broche au niveau haut.
+         * @param lo    Valeur du registre avec la broche au niveau bas.
+         * @param ptr   Premier octet à transmettre.
+         * @param bytes Nombre d'octets à transmettre (au moins 1).
+         *
+         * @note Routine en assembleur, comptée au cycle près, appelée
+         *       interruptions désactivées. Les tests sur ordinateur (symbole
+         *       HOST_TEST) la définissent eux-mêmes pour observer les octets.
+         */
+        static void _transmit(volatile uint8_t *out, uint8_t hi, uint8_t lo, const uint8_t *ptr, uint16_t bytes);
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param pin    Broche de données du ruban.
+         * @param pixels Tampon d'image (3 x `count` octets).
+         * @param count  Nombre de pixels du ruban.
+         *
+         * @note Le constructeur est évalué à la compilation (constexpr) et ne
+         *       touche à aucun registre.
+         */
+        constexpr PixelStrip(const uint8_t pin, uint8_t *pixels, const uint16_t count)
+            : _pin(pin), _out(nullptr), _mask(0), _pixels(pixels), _count(count), _dirty(true) {}
+
+        /**
+         * @brief Déclare la broche de données, en sortie au niveau bas.
+         *
+         * @param pins Configuration des broches, appliquée par PinSetup::apply().
+         *
+         * @note show() n'a aucun effet tant que configure() n'a pas été appelée.
+         */
+        void configure(PinSetup &pins);
+
+        /**
+         * @brief Nombre de pixels du ruban.
+         */
+        uint16_t count() const;
+
+        /**
+         * @brief Modifie la couleur d'un pixel.
+         *
+         * @param index Indice du pixel.
+         * @param red   Composante rouge (0 à 255).
+         * @param green Composante verte (0 à 255).
+         * @param blue  Composante bleue (0 à 255).
+         */
+        void setPixel(const uint16_t index, const uint8_t red, const uint8_t green, const uint8_t blue);
+
+        /**
+         * @brief Éteint tous les pixels.
+         */
+        void clear();
+
+        /**
+         * @brief Détermine si l'image a été modifiée depuis la dernière transmission.
+         */
+        bool isDirty() const;
+
+        /**
+         * @brief Transmission de l'image au ruban, si elle a été modifiée.
+         *
+         * @return true si l'image a été transmise.
+         *
+         * @note Cette méthode est bloquante, interruptions désactivées, pendant
+         *       transmitTimeUs() microsecondes. Il faut au moins 280 µs entre
+         *       deux transmissions pour que le ruban verrouille les couleurs.
+         */
+        bool show();
+
+        /**
+         * @brief Durée de transmission d'une image complète (exprimée en microsecondes).
+         */
+        uint16_t transmitTimeUs() const;
+
+};
\ No newline at end of file
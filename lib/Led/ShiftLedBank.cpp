@@ -0,0 +1,94 @@
+/*
+ * ------------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ------------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ------------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe ShiftLedBank
+ * ------------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe ShiftLedBank avant de les définir.
+ */
+#include "ShiftLedBank.h"
+
+void ShiftLedBank::configure(PinSetup &pins) {
+
+    pins.output(_latch_pin, LOW);
+
+    // MOSI (D11), SCK (D13) et SS (D10) en sortie.
+    pins.output(MOSI);
+    pins.output(SCK);
+    pins.output(SS);
+
+    _latch_out  = portOutputRegister(digitalPinToPort(_latch_pin));
+    _latch_mask = digitalPinToBitMask(_latch_pin);
+
+}
+
+void ShiftLedBank::begin() {
+
+    // SPI activé en mode maître, horloge F_CPU / 2.
+    SPCR = _BV(SPE) | _BV(MSTR);
+    SPSR = _BV(SPI2X);
+
+}
+
+#ifndef HOST_TEST
+
+inline void ShiftLedBank::_transfer(const uint8_t byte) {
+
+    // On n'attend la fin de la transmission d'un octet que pour écrire
+    // aussitôt le suivant dans le registre de données.
+    SPDR = byte;
+    while (!(SPSR & _BV(SPIF)));
+
+}
+
+inline void ShiftLedBank::_latch(const bool high) {
+
+    if (high) *_latch_out |=  _latch_mask;
+    else      *_latch_out &= ~_latch_mask;
+
+}
+
+#endif
+
+void ShiftLedBank::write(const uint8_t *frame) {
+
+    if (!_latch_out) return;
+
+    uint8_t i = frameSize();
+
+    _latch(false);
+
+    // Les octets sont transmis du dernier au premier, pour que le premier
+    // octet de l'image aboutisse dans le premier registre de la chaîne.
+    while (i--) _transfer(frame[i]);
+
+    // Le front montant sur RCLK recopie les registres à décalage
+    // sur les sorties : toutes les LEDs changent d'état en même temps.
+    _latch(true);
+
+}
+
+void ShiftLedBank::light(const uint8_t index, const bool state) {
+
+    uint8_t mask = 1 << (index & 0x7);
+
+    if (state) _frame[index >> 3] |=  mask;
+    else       _frame[index >> 3] &= ~mask;
+
+}
+
+void ShiftLedBank::toggle(const uint8_t index) {
+    _frame[index >> 3] ^= 1 << (index & 0x7);
+}
+
+void ShiftLedBank::show() {
+    write(_frame);
+}
\ No newline at end of file
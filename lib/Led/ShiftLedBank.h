@@ -0,0 +1,175 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la commande d'une rampe de
+ * LEDs au travers d'une chaîne de registres à décalage 74HC595, pilotée
+ * par le périphérique SPI matériel
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe ShiftLedBank
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "LedBank.h"
+#include <Arduino.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Définition de la classe ShiftLedBank.
+ *
+ * @note Avec une LED par broche, une Nano ne peut guère commander plus
+ *       d'une quinzaine de LEDs. Un registre à décalage 74HC595 commande
+ *       8 LEDs à partir d'une liaison série, et les registres peuvent être
+ *       chaînés les uns aux autres (sortie QH' vers l'entrée SER du suivant) :
+ *       trois broches suffisent alors pour commander 64 LEDs ou plus.
+ *
+ *       Câblage (périphérique SPI matériel de l'ATmega328) :
+ *
+ *           D11 (MOSI) --> SER   du premier registre
+ *           D13 (SCK)  --> SRCLK de tous les registres
+ *           latch      --> RCLK  de tous les registres
+ *
+ *       La broche D10 (SS) est configurée en sortie, faute de quoi le
+ *       périphérique SPI pourrait repasser en mode esclave : elle peut
+ *       servir de broche de verrouillage (latch).
+ *
+ *       Le premier registre de la chaîne (relié à la carte) commande les
+ *       LEDs 0 à 7, le suivant les LEDs 8 à 15, etc. La LED 8k+j est reliée
+ *       à la sortie Qj du registre k. Les octets qui sont transmis en premier
+ *       traversant toute la chaîne, l'image est transmise en commençant par
+ *       son dernier octet, chaque octet étant émis bit de poids fort en tête.
+ *
+ *       Les octets sont transmis les uns à la suite des autres à 8 MHz, puis
+ *       les sorties de tous les registres sont mises à jour simultanément
+ *       par une seule impulsion sur la broche de verrouillage. L'objectif de
+ *       temps de mise à jour d'une image complète de 64 LEDs (8 octets) est
+ *       de 25 µs au plus (2 µs de transmission par octet, plus le verrouillage).
+ *
+ *       Pour rester compatible avec la classe Led, la rampe conserve son
+ *       image courante et permet de commander chaque LED individuellement
+ *       avec light() et toggle(), l'image n'étant transmise qu'à l'appel de
+ *       show().
+ */
+class ShiftLedBank : public LedBank {
+
+    private:
+
+        /**
+         * @brief Nombre maximal d'octets par image, soit 128 LEDs (16 registres).
+         */
+        static const uint8_t _MAX_FRAME_SIZE = 16;
+
+        /**
+         * @brief Broche de verrouillage.
+         */
+        uint8_t _latch_pin;
+
+        /**
+         * @brief Registre de sortie (PORTx) de la broche de verrouillage.
+         */
+        volatile uint8_t *_latch_out;
+
+        /**
+         * @brief Masque de bit de la broche de verrouillage.
+         */
+        uint8_t _latch_mask;
+
+        /**
+         * @brief Image courante de la rampe.
+         */
+        uint8_t _frame[_MAX_FRAME_SIZE];
+
+        /**
+         * @brief Transmission d'un octet par le SPI, dont on attend la fin.
+         *
+         * @note Avec _latch(), c'est le seul accès de write() au matériel.
+         *       Les tests sur ordinateur (symbole HOST_TEST) définissent ces
+         *       deux méthodes eux-mêmes, pour observer les octets transmis et
+         *       les impulsions de verrouillage.
+         */
+        void _transfer(const uint8_t byte);
+
+        /**
+         * @brief Commande de la broche de verrouillage.
+         *
+         * @param high Niveau à appliquer (le front montant verrouille l'image).
+         */
+        void _latch(const bool high);
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param latch_pin Broche reliée à l'entrée de verrouillage RCLK des registres.
+         * @param size      Nombre de LEDs (multiple de 8, 128 au plus).
+         *
+         * @note Le constructeur est évalué à la compilation (constexpr) et ne
+         *       touche à aucun registre.
+         */
+        constexpr ShiftLedBank(const uint8_t latch_pin, const uint16_t size)
+            : LedBank(size > (_MAX_FRAME_SIZE << 3) ? (_MAX_FRAME_SIZE << 3) : size),
+              _latch_pin(latch_pin), _latch_out(nullptr), _latch_mask(0), _frame() {}
+
+        /**
+         * @brief Déclare les broches de la rampe en sortie : verrouillage, MOSI, SCK et SS.
+         *
+         * @param pins Configuration des broches, appliquée par PinSetup::apply().
+         *
+         * @note write() n'a aucun effet tant que configure() n'a pas été appelée.
+         */
+        void configure(PinSetup &pins);
+
+        /**
+         * @brief Initialisation du périphérique SPI.
+         *
+         * @note Le SPI est configuré en mode maître, mode 0, bit de poids fort
+         *       en tête, à la fréquence maximale (F_CPU / 2 = 8 MHz).
+         *
+         *       Les broches doivent avoir été configurées au préalable, par
+         *       configure() et PinSetup::apply().
+         */
+        void begin();
+
+        /**
+         * @brief Transmission d'une image à la chaîne de registres.
+         *
+         * @param frame Image à afficher (un bit par LED).
+         *
+         * @note Le mot clef "override" précise ici qu'il s'agit d'une redéfinition
+         *       de la méthode write() déclarée par le modèle parent LedBank.
+         *       L'image courante de la rampe n'est pas modifiée.
+         */
+        void write(const uint8_t *frame) override;
+
+        /**
+         * @brief Allume ou éteint une LED de l'image courante.
+         *
+         * @param index Indice de la LED.
+         * @param state Nouvel état logique à appliquer sur la LED.
+         */
+        void light(const uint8_t index, const bool state);
+
+        /**
+         * @brief Inverse l'état d'une LED de l'image courante.
+         *
+         * @param index Indice de la LED.
+         */
+        void toggle(const uint8_t index);
+
+        /**
+         * @brief Transmission de l'image courante à la chaîne de registres.
+         */
+        void show();
+
+};
\ No newline at end of file
@@ -0,0 +1,127 @@
+/*
+ * ------------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ------------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ------------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe MemoryMonitor
+ * ------------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe MemoryMonitor avant de les définir.
+ */
+#include "MemoryMonitor.h"
+
+/**
+ * @brief Limites de la mémoire vive, définies par l'éditeur de liens.
+ *
+ * @note __data_start marque le début des variables globales, _end leur fin.
+ *       __brkval, la fin du tas, n'est définie que si malloc() fait partie
+ *       du programme : la référence faible évite de l'y ajouter.
+ */
+extern uint8_t __data_start;
+extern uint8_t _end;
+extern uint8_t *__brkval __attribute__((weak));
+
+/**
+ * @brief Motif témoin, et conversion d'une constante en texte pour l'assembleur.
+ */
+#define _MEMORY_CANARY 0xc5
+#define _MEMORY_XSTR(x) #x
+#define _MEMORY_STR(x) _MEMORY_XSTR(x)
+
+static_assert(_MEMORY_CANARY == MemoryMonitor::CANARY, "canary pattern mismatch");
+
+/**
+ * @brief Remplissage de la mémoire libre avec le motif témoin.
+ *
+ * @note Cette fonction est placée dans la section .init3 : elle est exécutée
+ *       au démarrage, juste après l'initialisation du pointeur de pile et
+ *       avant celle des variables globales. Elle n'a ni prologue ni
+ *       épilogue (naked) : elle est simplement insérée dans la séquence de
+ *       démarrage. Elle remplit tout l'espace compris entre la fin des
+ *       variables globales (_end) et le haut de la pile (RAMEND), pile
+ *       comprise, puisque celle-ci est encore vide.
+ */
+void memory_paint() __attribute__((naked, used, section(".init3")));
+
+void memory_paint() {
+
+    // Une fonction naked ne peut contenir que de l'assembleur de base : les
+    // constantes sont donc insérées dans le texte par le préprocesseur.
+    asm volatile(
+        "ldi  r30, lo8(_end)                      \n\t"
+        "ldi  r31, hi8(_end)                      \n\t"
+        "ldi  r24, " _MEMORY_STR(_MEMORY_CANARY) "                    \n\t"
+        "ldi  r25, hi8(" _MEMORY_STR(RAMEND) ")                \n\t"
+        "rjmp 2f                                  \n\t"
+        "1:                                       \n\t"
+        "st   Z+, r24                             \n\t" // octet témoin
+        "2:                                       \n\t"
+        "cpi  r30, lo8(" _MEMORY_STR(RAMEND) ")                \n\t"
+        "cpc  r31, r25                            \n\t"
+        "brlo 1b                                  \n\t" // jusqu'à RAMEND inclus
+        "breq 1b                                  \n\t"
+    );
+
+}
+
+MemoryMonitor::MemoryMonitor(const uint16_t alarm_bytes) : _alarm_bytes(alarm_bytes) {}
+
+uint8_t *MemoryMonitor::_heapEnd() {
+    return &__brkval && __brkval ? __brkval : &_end;
+}
+
+uint16_t MemoryMonitor::dataSize() const {
+    return &_end - &__data_start;
+}
+
+uint16_t MemoryMonitor::heapSize() const {
+    return _heapEnd() - &_end;
+}
+
+uint16_t MemoryMonitor::stackSize() const {
+    return RAMEND - SP;
+}
+
+uint16_t MemoryMonitor::stackPeak() const {
+    // La pile a atteint le premier octet témoin effacé au-dessus du tas.
+    return RAMEND + 1 - (uintptr_t) (_heapEnd() + headroom());
+}
+
+uint16_t MemoryMonitor::headroom() const {
+    return countCanary(_heapEnd(), (const uint8_t *) SP);
+}
+
+bool MemoryMonitor::isLow() const {
+    return headroom() < _alarm_bytes;
+}
+
+void MemoryMonitor::report(Print &out) const {
+
+    out.print(F("ram: data "));
+    out.print(dataSize());
+    out.print(F(" heap "));
+    out.print(heapSize());
+    out.print(F(" stack "));
+    out.print(stackSize());
+    out.print('/');
+    out.print(stackPeak());
+    out.print(F(" free "));
+    out.println(headroom());
+
+}
+
+uint16_t MemoryMonitor::countCanary(const uint8_t *from, const uint8_t *to) {
+
+    const uint8_t *p = from;
+
+    while (p < to && *p == CANARY) p++;
+
+    return p - from;
+
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la surveillance de l'occupation
+ * de la mémoire vive (variables, tas et pile)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe MemoryMonitor
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe MemoryMonitor.
+ *
+ * @note Les 2 Ko de mémoire vive de l'ATmega328P sont partagés ainsi :
+ *
+ *           0x100                                                  0x8ff
+ *           | .data | .bss | tas -->          libre          <-- pile |
+ *
+ *       Les variables globales (.data et .bss) ont une taille fixe. Le tas
+ *       (malloc(), new) croît vers le haut, la pile (appels de fonctions,
+ *       variables locales, interruptions) croît vers le bas : s'ils se
+ *       rejoignent, le programme se corrompt sans prévenir.
+ *
+ *       Dès le démarrage de la carte, avant même l'initialisation des
+ *       variables globales, toute la mémoire libre est remplie d'un motif
+ *       témoin (0xc5). La pile efface ce motif à mesure qu'elle descend : il
+ *       suffit ensuite de compter les octets témoins encore intacts au-dessus
+ *       du tas pour connaître la plus grande profondeur jamais atteinte par
+ *       la pile (high-water mark), et la marge qui n'a jamais servi.
+ *
+ *       Cette mesure peut être légèrement optimiste si la pile a écrit, à
+ *       sa limite, un octet égal au motif témoin. Elle ne voit pas non plus
+ *       un tas qui aurait grossi puis rétréci.
+ *
+ *       Le remplissage est effectué dans la section .init3 : il suffit
+ *       d'incorporer ce fichier au programme pour qu'il ait lieu.
+ */
+class MemoryMonitor {
+
+    public:
+
+        /**
+         * @brief Motif témoin de la mémoire libre.
+         */
+        static const uint8_t CANARY = 0xc5;
+
+        /**
+         * @brief Nombre de caractères maximal de la ligne affichée par report().
+         */
+        static const uint8_t REPORT_SIZE = 56;
+
+    private:
+
+        /**
+         * @brief Seuil d'alerte de la marge libre (exprimé en octets).
+         */
+        uint16_t _alarm_bytes;
+
+        /**
+         * @brief Fin du tas (ou des variables globales si le tas est vide).
+         */
+        static uint8_t *_heapEnd();
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param alarm_bytes Seuil d'alerte de la marge libre (exprimé en octets).
+         */
+        MemoryMonitor(const uint16_t alarm_bytes = 128);
+
+        /**
+         * @brief Taille des variables globales (.data et .bss, exprimée en octets).
+         */
+        uint16_t dataSize() const;
+
+        /**
+         * @brief Taille du tas (exprimée en octets).
+         */
+        uint16_t heapSize() const;
+
+        /**
+         * @brief Profondeur actuelle de la pile (exprimée en octets).
+         */
+        uint16_t stackSize() const;
+
+        /**
+         * @brief Plus grande profondeur atteinte par la pile depuis le démarrage (exprimée en octets).
+         */
+        uint16_t stackPeak() const;
+
+        /**
+         * @brief Marge de mémoire qui n'a jamais servi (exprimée en octets).
+         */
+        uint16_t headroom() const;
+
+        /**
+         * @brief Détermine si la marge est passée sous le seuil d'alerte.
+         */
+        bool isLow() const;
+
+        /**
+         * @brief Affichage de l'occupation de la mémoire sur une ligne.
+         *
+         * @note Exemple : `ram: data 812 heap 0 stack 36/198 free 1002`
+         *       (la pile est donnée par sa profondeur actuelle, puis maximale).
+         */
+        void report(Print &out) const;
+
+        /**
+         * @brief Compte les octets témoins consécutifs à partir d'une adresse.
+         *
+         * @param from Première adresse examinée.
+         * @param to   Adresse qui arrête l'examen (exclue).
+         *
+         * @return Le nombre d'octets égaux à CANARY avant le premier qui diffère.
+         */
+        static uint16_t countCanary(const uint8_t *from, const uint8_t *to);
+
+};
\ No newline at end of file
@@ -0,0 +1,64 @@
+/*
+ * --------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * --------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * --------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe PinSetup
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe PinSetup avant de les définir.
+ */
+#include "PinSetup.h"
+#include <util/atomic.h>
+
+void PinSetup::_set(const uint8_t pin, const bool ddr, const bool port) {
+
+    if (pin >= NUM_DIGITAL_PINS) return;
+
+    uint8_t slot = digitalPinToPort(pin) - PB;
+    uint8_t mask = digitalPinToBitMask(pin);
+
+    if (slot >= _PORTS) return;
+
+    _mask[slot] |= mask;
+
+    if (ddr)  _ddr[slot]  |= mask; else _ddr[slot]  &= ~mask;
+    if (port) _port[slot] |= mask; else _port[slot] &= ~mask;
+
+}
+
+void PinSetup::output(const uint8_t pin, const uint8_t level) {
+    _set(pin, true, level != LOW);
+}
+
+void PinSetup::input(const uint8_t pin, const bool pullup) {
+    _set(pin, false, pullup);
+}
+
+void PinSetup::apply() const {
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+
+        for (uint8_t p=0; p<_PORTS; p++) {
+
+            uint8_t mask = _mask[p];
+
+            if (!mask) continue;
+
+            volatile uint8_t *port = portOutputRegister(PB + p);
+            volatile uint8_t *ddr  = portModeRegister(PB + p);
+
+            *port = (*port & ~mask) | _port[p];
+            *ddr  = (*ddr  & ~mask) | _ddr[p];
+
+        }
+
+    }
+
+}
\ No newline at end of file
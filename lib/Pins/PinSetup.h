@@ -0,0 +1,114 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la configuration groupée des
+ * broches numériques, à raison d'une écriture par registre
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe PinSetup
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe PinSetup.
+ *
+ * @note Les objets qui commandent des broches (Led, Button, PinLedBank,
+ *       etc.) ne touchent plus aux registres dans leur constructeur : ils
+ *       peuvent ainsi être construits à la compilation (constexpr), sans le
+ *       moindre code exécuté avant setup(), où le noyau Arduino n'est pas
+ *       encore initialisé.
+ *
+ *       Dans setup(), chaque objet déclare ses broches à un PinSetup, par sa
+ *       méthode configure(), puis apply() applique la configuration : chaque
+ *       port n'est écrit qu'une fois (un PORTx, puis un DDRx), au lieu d'un
+ *       pinMode() par broche, qui retrouve à chaque fois le port et le bit
+ *       de la broche et écrit ses registres un à un.
+ *
+ *           PinSetup pins;
+ *
+ *           for (uint8_t i=0; i<NUM_LEDS; i++) led[i].configure(pins);
+ *           button.configure(pins);
+ *
+ *           pins.apply();
+ *
+ *       Le niveau de sortie (ou la résistance de tirage) est fixé avant la
+ *       direction : une broche de sortie ne présente jamais un autre niveau
+ *       que celui qui a été demandé.
+ */
+class PinSetup {
+
+    private:
+
+        /**
+         * @brief Nombre de ports (PORTB, PORTC et PORTD sur l'ATmega328).
+         */
+        static const uint8_t _PORTS = 3;
+
+        /**
+         * @brief Bits configurés de chaque port.
+         */
+        uint8_t _mask[_PORTS];
+
+        /**
+         * @brief Valeurs des bits configurés dans les registres DDRx.
+         */
+        uint8_t _ddr[_PORTS];
+
+        /**
+         * @brief Valeurs des bits configurés dans les registres PORTx.
+         */
+        uint8_t _port[_PORTS];
+
+        /**
+         * @brief Déclare la configuration d'une broche.
+         *
+         * @param pin  Broche numérique (les broches inexistantes sont ignorées).
+         * @param ddr  Direction de la broche (true en sortie).
+         * @param port Niveau de sortie, ou résistance de tirage en entrée.
+         */
+        void _set(const uint8_t pin, const bool ddr, const bool port);
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur : aucune broche n'est configurée.
+         */
+        constexpr PinSetup() : _mask(), _ddr(), _port() {}
+
+        /**
+         * @brief Déclare une broche en sortie.
+         *
+         * @param pin   Broche numérique.
+         * @param level Niveau initial de la sortie (LOW par défaut).
+         */
+        void output(const uint8_t pin, const uint8_t level = LOW);
+
+        /**
+         * @brief Déclare une broche en entrée.
+         *
+         * @param pin    Broche numérique.
+         * @param pullup true pour activer la résistance de tirage interne.
+         */
+        void input(const uint8_t pin, const bool pullup = false);
+
+        /**
+         * @brief Application de la configuration : une écriture par registre.
+         *
+         * @note Les bits des broches qui n'ont pas été déclarées ne sont pas
+         *       modifiés. Les écritures ont lieu à l'abri des interruptions.
+         */
+        void apply() const;
+
+};
\ No newline at end of file
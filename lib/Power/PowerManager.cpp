@@ -0,0 +1,175 @@
+/*
+ * -----------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -----------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -----------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe PowerManager
+ * -----------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe PowerManager avant de les définir.
+ */
+#include "PowerManager.h"
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#include <util/atomic.h>
+
+/**
+ * @brief Compteur de millisecondes du Timer0, défini par le noyau Arduino (wiring.c).
+ */
+extern volatile unsigned long timer0_millis;
+
+/**
+ * @brief Indique si le dernier réveil est dû au chien de garde.
+ */
+static volatile bool watchdog_fired;
+
+/**
+ * @brief Routine d'interruption du chien de garde : elle signale simplement le réveil.
+ */
+ISR(WDT_vect) {
+    watchdog_fired = true;
+}
+
+PowerManager::PowerManager(const uint8_t wake_pin) {
+
+    _pcmsk     = digitalPinToPCMSK(wake_pin);
+    _pcmsk_bit = digitalPinToPCMSKbit(wake_pin);
+    _pcicr_bit = digitalPinToPCICRbit(wake_pin);
+
+}
+
+void PowerManager::begin() {
+
+    _start_ms      = millis();
+    _idle_ms       = 0;
+    _idle_us       = 0;
+    _power_down_ms = 0;
+
+    memset(_wakeups, 0, sizeof(_wakeups));
+
+}
+
+PowerState PowerManager::sleep(const bool busy, const uint32_t until_ms) {
+
+    PowerState state = decide(busy, until_ms);
+
+    switch (state) {
+        case PowerState::idle:
+            _idle();
+            break;
+        case PowerState::powerDown:
+            _powerDown(watchdogStep(until_ms));
+            break;
+        default:
+            break;
+    }
+
+    _wakeups[(uint8_t) state]++;
+
+    return state;
+
+}
+
+void PowerManager::_idle() {
+
+    uint32_t start_us = micros();
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+
+    uint32_t slept_us = micros() - start_us + _idle_us;
+
+    _idle_ms += slept_us / 1000;
+    _idle_us  = slept_us % 1000;
+
+}
+
+void PowerManager::_powerDown(const uint8_t step) {
+
+    // Les bits WDP0..WDP3 du registre WDTCSR codent la période (WDP3 est isolé).
+    uint8_t wdp = (step & 0x7) | ((step & 0x8) ? _BV(WDP3) : 0);
+
+    cli();
+
+    watchdog_fired = false;
+
+    // Chien de garde en mode interruption seule (pas de réinitialisation).
+    MCUSR &= ~_BV(WDRF);
+    WDTCSR = _BV(WDCE) | _BV(WDE);
+    WDTCSR = _BV(WDIE) | wdp;
+
+    // Réveil par un changement d'état de la broche du bouton.
+    PCIFR   = _BV(_pcicr_bit);
+    PCICR  |= _BV(_pcicr_bit);
+    *_pcmsk |= _BV(_pcmsk_bit);
+
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_bod_disable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+
+    *_pcmsk &= ~_BV(_pcmsk_bit);
+    PCICR  &= ~_BV(_pcicr_bit);
+    wdt_disable();
+
+    // Report de la durée du sommeil sur le compteur de millis().
+    uint16_t period_ms = (uint16_t) MIN_WATCHDOG_MS << step;
+    uint16_t slept_ms  = watchdog_fired ? period_ms : period_ms >> 1;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        timer0_millis += slept_ms;
+    }
+
+    _power_down_ms += slept_ms;
+
+}
+
+uint32_t PowerManager::timeIn(const PowerState state) const {
+
+    switch (state) {
+        case PowerState::idle:
+            return _idle_ms;
+        case PowerState::powerDown:
+            return _power_down_ms;
+        default:
+            return millis() - _start_ms - _idle_ms - _power_down_ms;
+    }
+
+}
+
+uint32_t PowerManager::wakeups(const PowerState state) const {
+    return _wakeups[(uint8_t) state];
+}
+
+void PowerManager::report(Print &out) const {
+
+    static const char * const NAMES[] = { "active", "idle", "power-down" };
+
+    uint32_t total_ms = millis() - _start_ms;
+
+    for (uint8_t s=0; s<3; s++) {
+
+        uint32_t ms = timeIn((PowerState) s);
+
+        out.print(NAMES[s]);
+        out.print(F(": "));
+        out.print(ms);
+        out.print(F(" ms ("));
+        out.print(total_ms >= 100 ? ms / (total_ms / 100) : 0);
+        out.print(F(" %), "));
+        out.print(_wakeups[s]);
+        out.println(F(" times"));
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la mise en sommeil du
+ * microcontrôleur entre deux sollicitations du bouton
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe PowerManager
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <avr/interrupt.h>
+
+/**
+ * @brief États d'alimentation du microcontrôleur.
+ *
+ * @note active    : le programme s'exécute,
+ *       idle      : le processeur est arrêté, les périphériques (Timer0,
+ *                   liaison série, etc.) fonctionnent toujours,
+ *       powerDown : tout est arrêté, sauf le chien de garde (watchdog) et la
+ *                   détection des changements d'état des broches.
+ */
+enum class PowerState : uint8_t { active, idle, powerDown };
+
+/**
+ * @brief Définition de la routine d'interruption qui réveille le microcontrôleur.
+ *
+ * @param pin   Broche de réveil (celle transmise au constructeur de PowerManager).
+ * @param group Groupe PCINT de la broche (0 : broches 8 à 13, 1 : A0 à A5,
+ *              2 : broches 0 à 7).
+ *
+ * @note La routine n'a rien d'autre à faire que réveiller le
+ *       microcontrôleur : c'est la boucle principale qui lira le bouton.
+ *       Seul le vecteur du groupe de la broche de réveil est défini : les
+ *       deux autres restent disponibles pour SoftwareSerial ou toute autre
+ *       bibliothèque qui surveille les changements d'état des broches. Le
+ *       groupe est vérifié à la compilation.
+ *
+ *       À invoquer une seule fois, hors de toute fonction, par exemple :
+ *
+ *           POWER_WAKE_INTERRUPT(BUTTON_PIN, 2)
+ */
+#define POWER_WAKE_INTERRUPT(pin, group)                                      \
+    static_assert(digitalPinToPCICRbit(pin) == (group),                       \
+                  "the wake pin does not belong to this PCINT group");        \
+    EMPTY_INTERRUPT(PCINT ## group ## _vect)
+
+/**
+ * @brief Définition de la classe PowerManager.
+ *
+ * @note Le programme principal appelle sleep() à la fin de chaque itération
+ *       de la boucle principale, en précisant s'il a encore du travail en
+ *       cours (un bouton en cours de déparasitage ou enfoncé, une animation,
+ *       etc.) et le délai qui le sépare de sa prochaine échéance. Le
+ *       microcontrôleur est alors placé dans le sommeil le plus profond
+ *       compatible avec cette situation :
+ *
+ *           - travail en cours, ou échéance à moins de 16 ms : mode idle.
+ *             Le Timer0 continue à compter, et son interruption réveille le
+ *             processeur toutes les millisecondes : le programme reprend
+ *             son cours à la même cadence, mais sans consommer entre deux
+ *             interruptions.
+ *
+ *           - sinon : mode power-down. Seuls un changement d'état de la
+ *             broche du bouton ou le chien de garde, réglé sur la plus longue
+ *             période qui n'excède pas l'échéance (de 16 ms à 8 s), peuvent
+ *             réveiller le microcontrôleur.
+ *
+ *       En mode power-down, l'entrée INT0 ne détecte que le niveau bas (la
+ *       détection des fronts a besoin de l'horloge des entrées-sorties, qui
+ *       est arrêtée) : elle ne convient pas à un bouton câblé avec une
+ *       résistance de tirage vers la masse. C'est donc l'interruption de
+ *       changement d'état (PCINT), asynchrone, qui réveille le
+ *       microcontrôleur. N'importe quelle broche du bouton convient, mais
+ *       le programme principal doit définir la routine d'interruption de son
+ *       groupe de broches avec la macro POWER_WAKE_INTERRUPT().
+ *
+ *       Le Timer0 est arrêté pendant le mode power-down : la durée du sommeil
+ *       est reportée sur le compteur de millis(). Au réveil par le chien de
+ *       garde, c'est la période entière (à ±10 % près, l'oscillateur du chien
+ *       de garde n'étant pas calibré). Au réveil par le bouton, la durée
+ *       écoulée n'est pas mesurable : on compte une demi-période, soit une
+ *       erreur d'au plus une demi-période.
+ *
+ *       La décision est prise par les méthodes statiques decide() et
+ *       watchdogStep(), définies dans ce fichier d'en-tête : elles ne touchent
+ *       à aucun registre et sont éprouvées sur un ordinateur (voir test/).
+ */
+class PowerManager {
+
+    public:
+
+        /**
+         * @brief Délai à transmettre lorsqu'aucune échéance n'est programmée.
+         */
+        static const uint32_t NO_DEADLINE = 0xffffffff;
+
+        /**
+         * @brief Période la plus courte du chien de garde (exprimée en millisecondes).
+         */
+        static const uint8_t MIN_WATCHDOG_MS = 16;
+
+        /**
+         * @brief Nombre de périodes du chien de garde (de 16 ms à 8 s).
+         */
+        static const uint8_t WATCHDOG_STEPS = 10;
+
+    private:
+
+        /**
+         * @brief Registre de masque PCMSKx de la broche de réveil.
+         */
+        volatile uint8_t *_pcmsk;
+
+        /**
+         * @brief Bit de la broche de réveil dans le registre PCMSKx.
+         */
+        uint8_t _pcmsk_bit;
+
+        /**
+         * @brief Bit du groupe de broches de réveil dans les registres PCICR et PCIFR.
+         */
+        uint8_t _pcicr_bit;
+
+        /**
+         * @brief Date de démarrage (exprimée en millisecondes).
+         */
+        uint32_t _start_ms;
+
+        /**
+         * @brief Temps passé en mode idle (exprimé en millisecondes).
+         */
+        uint32_t _idle_ms;
+
+        /**
+         * @brief Fraction de milliseconde passée en mode idle (exprimée en microsecondes).
+         */
+        uint16_t _idle_us;
+
+        /**
+         * @brief Temps passé en mode power-down (exprimé en millisecondes).
+         */
+        uint32_t _power_down_ms;
+
+        /**
+         * @brief Nombre de réveils de chaque mode de sommeil.
+         */
+        uint32_t _wakeups[3];
+
+        /**
+         * @brief Sommeil en mode idle.
+         */
+        void _idle();
+
+        /**
+         * @brief Sommeil en mode power-down.
+         *
+         * @param step Période du chien de garde (voir watchdogStep()).
+         */
+        void _powerDown(const uint8_t step);
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param wake_pin Broche du bouton, dont les changements d'état réveillent le microcontrôleur.
+         */
+        PowerManager(const uint8_t wake_pin);
+
+        /**
+         * @brief Démarrage du décompte des temps passés dans chaque état.
+         */
+        void begin();
+
+        /**
+         * @brief Mise en sommeil jusqu'au prochain événement.
+         *
+         * @param busy     Indique si un travail est en cours.
+         * @param until_ms Délai avant la prochaine échéance (NO_DEADLINE s'il n'y en a pas).
+         *
+         * @return L'état dans lequel le microcontrôleur a été placé.
+         *
+         * @note Le programme principal doit vider le tampon d'émission de la
+         *       liaison série (Serial.flush()) avant de s'endormir, sans quoi
+         *       la fin du message est perdue en mode power-down.
+         */
+        PowerState sleep(const bool busy, const uint32_t until_ms);
+
+        /**
+         * @brief Choix de l'état d'alimentation.
+         *
+         * @param busy     Indique si un travail est en cours.
+         * @param until_ms Délai avant la prochaine échéance (NO_DEADLINE s'il n'y en a pas).
+         *
+         * @return active si l'échéance est arrivée, idle si un travail est en
+         *         cours ou si l'échéance est trop proche pour le chien de garde,
+         *         powerDown sinon.
+         */
+        static PowerState decide(const bool busy, const uint32_t until_ms) {
+
+            if (!until_ms) return PowerState::active;
+            if (busy || until_ms < MIN_WATCHDOG_MS) return PowerState::idle;
+
+            return PowerState::powerDown;
+
+        }
+
+        /**
+         * @brief Choix de la période du chien de garde.
+         *
+         * @param until_ms Délai avant la prochaine échéance (au moins 16 ms).
+         *
+         * @return Le rang de la plus longue période qui n'excède pas le délai
+         *         (la période vaut 16 ms x 2^rang).
+         */
+        static uint8_t watchdogStep(const uint32_t until_ms) {
+
+            uint8_t step = 0;
+
+            while (step + 1 < WATCHDOG_STEPS && ((uint32_t) MIN_WATCHDOG_MS << (step + 1)) <= until_ms) step++;
+
+            return step;
+
+        }
+
+        /**
+         * @brief Temps passé dans un état (exprimé en millisecondes).
+         *
+         * @param state État d'alimentation.
+         */
+        uint32_t timeIn(const PowerState state) const;
+
+        /**
+         * @brief Nombre de passages dans un état de sommeil.
+         *
+         * @param state État d'alimentation.
+         */
+        uint32_t wakeups(const PowerState state) const;
+
+        /**
+         * @brief Affichage des temps passés dans chaque état.
+         */
+        void report(Print &out) const;
+
+};
\ No newline at end of file
@@ -0,0 +1,259 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe Profiler
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe Profiler avant de les définir.
+ */
+#include "Profiler.h"
+#include <util/atomic.h>
+
+/**
+ * @brief Fin du code du programme, définie par l'éditeur de liens.
+ */
+extern char _etext;
+
+/**
+ * @brief Profileur associé à la routine d'interruption du Timer2.
+ */
+static Profiler *active_profiler = nullptr;
+
+/**
+ * @brief Enregistrement d'un échantillon par le profileur actif.
+ *
+ * @note Cette fonction est appelée par la routine d'interruption écrite en
+ *       assembleur : elle ne doit pas être renommée par le compilateur.
+ */
+extern "C" void profiler_sample(const uint16_t pc) __attribute__((used));
+
+extern "C" void profiler_sample(const uint16_t pc) {
+    active_profiler->sample(pc);
+}
+
+/**
+ * @brief Sauvegarde des registres que profiler_sample() peut modifier, ainsi
+ *        que de SREG, puis restauration dans l'ordre inverse.
+ */
+#define _PROFILER_SAVE                                                        \
+        "push r0                 \n\t"                                        \
+        "in   r0, __SREG__       \n\t"                                        \
+        "push r0                 \n\t"                                        \
+        "push r1                 \n\t"                                        \
+        "clr  r1                 \n\t"                                        \
+        "push r18                \n\t"                                        \
+        "push r19                \n\t"                                        \
+        "push r20                \n\t"                                        \
+        "push r21                \n\t"                                        \
+        "push r22                \n\t"                                        \
+        "push r23                \n\t"                                        \
+        "push r24                \n\t"                                        \
+        "push r25                \n\t"                                        \
+        "push r26                \n\t"                                        \
+        "push r27                \n\t"                                        \
+        "push r30                \n\t"                                        \
+        "push r31                \n\t"
+
+#define _PROFILER_RESTORE                                                     \
+        "pop  r31                \n\t"                                        \
+        "pop  r30                \n\t"                                        \
+        "pop  r27                \n\t"                                        \
+        "pop  r26                \n\t"                                        \
+        "pop  r25                \n\t"                                        \
+        "pop  r24                \n\t"                                        \
+        "pop  r23                \n\t"                                        \
+        "pop  r22                \n\t"                                        \
+        "pop  r21                \n\t"                                        \
+        "pop  r20                \n\t"                                        \
+        "pop  r19                \n\t"                                        \
+        "pop  r18                \n\t"                                        \
+        "pop  r1                 \n\t"                                        \
+        "pop  r0                 \n\t"                                        \
+        "out  __SREG__, r0       \n\t"                                        \
+        "pop  r0                 \n\t"
+
+/**
+ * @brief Position de l'adresse de retour par rapport à SP, et conversion
+ *        d'une constante en texte pour l'assembleur.
+ *
+ * @note SP pointe sur le premier emplacement libre : les octets empilés par
+ *       _PROFILER_SAVE occupent SP+1 à SP+15, et l'adresse de retour, empilée
+ *       avant eux par le processeur, SP+16 (poids fort) et SP+17 (poids
+ *       faible). Toute modification de la sauvegarde décale ces positions :
+ *       les assertions ci-dessous comptent les instructions push et pop.
+ */
+#define _PROFILER_RETURN_HI 16
+#define _PROFILER_RETURN_LO 17
+#define _PROFILER_XSTR(x) #x
+#define _PROFILER_STR(x) _PROFILER_XSTR(x)
+
+/**
+ * @brief Vrai si la ligne d'assembleur `line` commence par l'instruction `op`.
+ */
+static constexpr bool startsWith(const char *line, const char *op) {
+    return !*op || (*line == *op && startsWith(line + 1, op + 1));
+}
+
+/**
+ * @brief Début de la ligne d'assembleur qui suit `line` (après "\n\t").
+ */
+static constexpr const char *nextLine(const char *line) {
+    return !*line ? line : *line == '\n' ? line + 1 + (line[1] == '\t') : nextLine(line + 1);
+}
+
+/**
+ * @brief Nombre de lignes d'assembleur qui commencent par l'instruction `op`.
+ *
+ * @note La récursion se fait ligne par ligne : sa profondeur reste bien en
+ *       deçà de la limite imposée au compilateur pour les constexpr.
+ */
+static constexpr uint8_t countOp(const char *code, const char *op) {
+    return !*code ? 0 : startsWith(code, op) + countOp(nextLine(code), op);
+}
+
+static_assert(countOp(_PROFILER_SAVE, "push ") + 1 == _PROFILER_RETURN_HI, "return address offset does not match the saved registers");
+static_assert(_PROFILER_RETURN_LO == _PROFILER_RETURN_HI + 1, "return address is stored on two bytes");
+static_assert(countOp(_PROFILER_RESTORE, "pop ") == countOp(_PROFILER_SAVE, "push "), "unbalanced stack in the profiler ISR");
+
+/**
+ * @brief Routine d'interruption du Timer2.
+ *
+ * @note Le processeur a empilé l'adresse de retour (octet de poids faible,
+ *       puis octet de poids fort). La routine sauvegarde les registres que
+ *       profiler_sample() peut modifier, ainsi que SREG : 15 octets en tout,
+ *       et lit l'adresse de retour juste au-dessus (voir _PROFILER_RETURN_HI).
+ *
+ *       Une fonction naked ne peut contenir que de l'assembleur de base : les
+ *       constantes sont donc insérées dans le texte par le préprocesseur.
+ */
+ISR(TIMER2_COMPA_vect, ISR_NAKED) {
+
+    asm volatile(
+        _PROFILER_SAVE
+        "in   r30, __SP_L__      \n\t"
+        "in   r31, __SP_H__      \n\t"
+        "ldd  r25, Z+" _PROFILER_STR(_PROFILER_RETURN_HI) "          \n\t"
+        "ldd  r24, Z+" _PROFILER_STR(_PROFILER_RETURN_LO) "          \n\t"
+        "call profiler_sample    \n\t"
+        _PROFILER_RESTORE
+        "reti                    \n\t"
+    );
+
+}
+
+Profiler::Profiler(uint16_t *bins, const uint8_t count)
+    : _bins(bins), _count(count), _shift(0), _rate_hz(0) {
+    reset();
+}
+
+void Profiler::begin(const uint16_t rate_hz) {
+
+    uint16_t top = (15625 + rate_hz / 2) / rate_hz;
+
+    if (top < 2)   top = 2;
+    if (top > 256) top = 256;
+
+    _rate_hz = 15625 / top;
+    _shift   = shiftFor((uint16_t) (uintptr_t) &_etext >> 1, _count);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+
+        active_profiler = this;
+
+        TCCR2A = _BV(WGM21);
+        TCCR2B = _BV(CS22) | _BV(CS21) | _BV(CS20);
+        OCR2A  = top - 1;
+        TCNT2  = 0;
+        TIFR2  = _BV(OCF2A);
+        TIMSK2 = _BV(OCIE2A);
+
+    }
+
+}
+
+void Profiler::end() {
+    TIMSK2 = 0;
+}
+
+void Profiler::reset() {
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        memset(_bins, 0, _count * sizeof(uint16_t));
+        _samples = 0;
+        _other   = 0;
+    }
+
+}
+
+void Profiler::sample(const uint16_t pc) {
+
+    uint16_t bin = pc >> _shift;
+
+    _samples++;
+
+    if (bin >= _count) {
+        if (_other < 0xffff) _other++;
+    } else if (_bins[bin] < 0xffff) _bins[bin]++;
+
+}
+
+uint32_t Profiler::samples() const {
+
+    uint32_t samples;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        samples = _samples;
+    }
+
+    return samples;
+
+}
+
+uint8_t Profiler::shiftFor(const uint16_t words, const uint8_t count) {
+
+    uint8_t shift = 0;
+
+    while (((uint32_t) count << shift) < words) shift++;
+
+    return shift;
+
+}
+
+void Profiler::dump(Print &out) {
+
+    uint8_t timsk = TIMSK2;
+    TIMSK2 = 0;
+
+    out.print(F("# profile rate="));
+    out.print(_rate_hz);
+    out.print(F(" width="));
+    out.print(2U << _shift);
+    out.print(F(" samples="));
+    out.print(_samples);
+    out.print(F(" other="));
+    out.println(_other);
+
+    for (uint8_t i=0; i<_count; i++) {
+
+        if (!_bins[i]) continue;
+
+        out.print(F("0x"));
+        out.print((uint32_t) i << (_shift + 1), HEX);
+        out.print(' ');
+        out.println(_bins[i]);
+
+    }
+
+    out.println(F("# end"));
+
+    TIMSK2 = timsk;
+
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour le profilage statistique du
+ * programme (échantillonnage du compteur ordinal)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Profiler
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe Profiler.
+ *
+ * @note Le Timer2 interrompt le programme à intervalles réguliers. La routine
+ *       d'interruption relève sur la pile l'adresse de retour, c'est-à-dire
+ *       l'adresse de l'instruction interrompue, et incrémente le compteur de
+ *       la tranche d'adresses qui la contient. Au bout de quelques milliers
+ *       d'échantillons, l'histogramme montre où le programme passe son temps,
+ *       fonctions de la bibliothèque Arduino comprises (digitalWrite(),
+ *       millis(), vsnprintf_P(), etc.).
+ *
+ *       Le code du programme est découpé en `count` tranches de même largeur
+ *       (une puissance de 2, d'au moins 2 octets), de l'adresse 0 jusqu'à la
+ *       fin du code. Les compteurs sont fournis par le programme principal
+ *       (deux octets par tranche) et saturent à 65535.
+ *
+ *       La routine d'interruption est écrite en assembleur, sans prologue
+ *       généré par le compilateur : c'est ce qui permet de connaître la
+ *       position exacte de l'adresse de retour sur la pile. Elle coûte une
+ *       soixantaine de cycles. Seul le code exécuté interruptions actives
+ *       peut être échantillonné : les autres routines d'interruption
+ *       n'apparaissent pas dans l'histogramme.
+ *
+ *       Le Timer2 n'est plus disponible pour autre chose (tone(), PWM sur
+ *       les broches D3 et D11, KeyMatrix, CharlieLedBank). La fréquence
+ *       d'échantillonnage doit différer de celle du Timer0 (976 Hz, soit
+ *       n = 16 ci-dessous), sans quoi l'échantillonnage se synchronise sur
+ *       l'interruption de millis() et n'observe jamais que le même instant
+ *       de la boucle principale.
+ *
+ *       Les données sont restituées sur la liaison série sous une forme que
+ *       l'outil tools/symbolize.py associe aux symboles du fichier ELF.
+ */
+class Profiler {
+
+    private:
+
+        /**
+         * @brief Compteurs des tranches d'adresses.
+         */
+        uint16_t *_bins;
+
+        /**
+         * @brief Nombre de tranches.
+         */
+        uint8_t _count;
+
+        /**
+         * @brief Largeur d'une tranche (2^_shift mots de 2 octets).
+         */
+        uint8_t _shift;
+
+        /**
+         * @brief Fréquence d'échantillonnage (exprimée en hertz).
+         */
+        uint16_t _rate_hz;
+
+        /**
+         * @brief Nombre d'échantillons relevés.
+         */
+        uint32_t _samples;
+
+        /**
+         * @brief Nombre d'échantillons relevés hors du code du programme (chargeur de démarrage).
+         */
+        uint16_t _other;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param bins  Compteurs des tranches d'adresses (`count` entiers de 16 bits).
+         * @param count Nombre de tranches.
+         */
+        Profiler(uint16_t *bins, const uint8_t count);
+
+        /**
+         * @brief Démarrage de l'échantillonnage.
+         *
+         * @param rate_hz Fréquence d'échantillonnage (de 62 à 7812 Hz).
+         *
+         * @note Le Timer2 est configuré en mode CTC, avec un prédiviseur de
+         *       1024 : la fréquence effective est 15625 / n Hz.
+         */
+        void begin(const uint16_t rate_hz = 919);
+
+        /**
+         * @brief Arrêt de l'échantillonnage.
+         */
+        void end();
+
+        /**
+         * @brief Remise à zéro de l'histogramme.
+         */
+        void reset();
+
+        /**
+         * @brief Enregistrement d'un échantillon.
+         *
+         * @param pc Adresse de l'instruction interrompue (exprimée en mots de 2 octets).
+         *
+         * @note Cette méthode est appelée par la routine d'interruption du Timer2.
+         */
+        void sample(const uint16_t pc);
+
+        /**
+         * @brief Nombre d'échantillons relevés.
+         */
+        uint32_t samples() const;
+
+        /**
+         * @brief Rang de la plus petite largeur de tranche qui couvre tout le code.
+         *
+         * @param words Taille du code (exprimée en mots de 2 octets).
+         * @param count Nombre de tranches.
+         */
+        static uint8_t shiftFor(const uint16_t words, const uint8_t count);
+
+        /**
+         * @brief Restitution de l'histogramme.
+         *
+         * @note L'échantillonnage est suspendu pendant la restitution. Le
+         *       format est le suivant (adresses en octets, en hexadécimal) :
+         *
+         *           # profile rate=919 width=64 samples=12345 other=0
+         *           0x0a40 123
+         *           0x0a80 17
+         *           # end
+         *
+         *       Seules les tranches non vides sont restituées.
+         */
+        void dump(Print &out);
+
+};
\ No newline at end of file
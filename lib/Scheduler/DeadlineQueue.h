@@ -0,0 +1,252 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour l'ordonnancement d'échéances
+ * (file de priorité à capacité fixe)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe DeadlineQueue
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe DeadlineQueue.
+ *
+ * @tparam CAPACITY Nombre d'échéances identifiées (de 1 à 254).
+ *
+ * @note Chaque échéance est identifiée par un entier de 0 à CAPACITY - 1,
+ *       choisi par le programme principal (par exemple : 2 x bouton + seuil).
+ *       Une échéance identifiée n'est programmée qu'une seule fois : la
+ *       reprogrammer déplace sa date.
+ *
+ *       Les échéances programmées sont rangées dans un tas binaire (min-heap)
+ *       ordonné par date : la plus proche est toujours à la racine. Vérifier
+ *       qu'aucune échéance n'est arrivée ne coûte donc qu'une comparaison,
+ *       quel que soit le nombre d'échéances programmées. Programmer, annuler
+ *       ou extraire une échéance coûte au plus log2(CAPACITY) échanges.
+ *
+ *       La position de chaque échéance dans le tas est mémorisée, pour
+ *       pouvoir l'annuler ou la reprogrammer sans la rechercher.
+ *
+ *       Les dates sont comparées par différence signée : l'ordre reste
+ *       correct au passage à zéro de millis() (au bout de 49,7 jours), tant
+ *       que les échéances sont à moins de 24 jours les unes des autres.
+ *
+ *       Aucune allocation dynamique : chaque échéance occupe 6 octets.
+ */
+template <uint8_t CAPACITY>
+class DeadlineQueue {
+
+    static_assert(CAPACITY >= 1 && CAPACITY <= 254, "deadline queue capacity must be between 1 and 254");
+
+    public:
+
+        /**
+         * @brief Position d'une échéance qui n'est pas programmée.
+         */
+        static const uint8_t NONE = 0xff;
+
+    private:
+
+        /**
+         * @brief Dates des échéances du tas.
+         */
+        uint32_t _due[CAPACITY];
+
+        /**
+         * @brief Identifiants des échéances du tas.
+         */
+        uint8_t _id[CAPACITY];
+
+        /**
+         * @brief Position de chaque échéance dans le tas (NONE si elle n'est pas programmée).
+         */
+        uint8_t _position[CAPACITY];
+
+        /**
+         * @brief Nombre d'échéances programmées.
+         */
+        uint8_t _size;
+
+        /**
+         * @brief Compare deux dates en tenant compte du passage à zéro de l'horloge.
+         */
+        static bool _before(const uint32_t a, const uint32_t b) {
+            return (int32_t) (a - b) < 0;
+        }
+
+        /**
+         * @brief Échange deux éléments du tas.
+         */
+        void _swap(const uint8_t i, const uint8_t j) {
+
+            uint32_t due = _due[i]; _due[i] = _due[j]; _due[j] = due;
+            uint8_t  id  = _id[i];  _id[i]  = _id[j];  _id[j]  = id;
+
+            _position[_id[i]] = i;
+            _position[_id[j]] = j;
+
+        }
+
+        /**
+         * @brief Fait remonter un élément vers la racine tant qu'il précède son parent.
+         */
+        uint8_t _siftUp(uint8_t i) {
+
+            while (i) {
+                uint8_t parent = (i - 1) >> 1;
+                if (!_before(_due[i], _due[parent])) break;
+                _swap(i, parent);
+                i = parent;
+            }
+
+            return i;
+
+        }
+
+        /**
+         * @brief Fait descendre un élément vers les feuilles tant qu'un de ses enfants le précède.
+         */
+        void _siftDown(uint8_t i) {
+
+            for (;;) {
+
+                // Les indices des enfants sont calculés sur 16 bits : au-delà
+                // de la position 126, ils dépassent 255.
+                uint8_t  first = i;
+                uint16_t left  = 2 * i + 1;
+                uint16_t right = left + 1;
+
+                if (left  < _size && _before(_due[left],  _due[first])) first = left;
+                if (right < _size && _before(_due[right], _due[first])) first = right;
+
+                if (first == i) return;
+
+                _swap(i, first);
+                i = first;
+
+            }
+
+        }
+
+        /**
+         * @brief Retire l'élément du tas situé à une position donnée.
+         */
+        void _remove(const uint8_t i) {
+
+            _position[_id[i]] = NONE;
+
+            if (i != --_size) {
+
+                _due[i] = _due[_size];
+                _id[i]  = _id[_size];
+                _position[_id[i]] = i;
+
+                // L'élément déplacé peut devoir monter ou descendre.
+                if (_siftUp(i) == i) _siftDown(i);
+
+            }
+
+        }
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         */
+        DeadlineQueue() : _size(0) {
+            memset(_position, NONE, CAPACITY);
+        }
+
+        /**
+         * @brief Programme (ou reprogramme) une échéance.
+         *
+         * @param id     Identifiant de l'échéance (de 0 à CAPACITY - 1).
+         * @param due_ms Date de l'échéance (exprimée en millisecondes).
+         */
+        void schedule(const uint8_t id, const uint32_t due_ms) {
+
+            if (id >= CAPACITY) return;
+
+            uint8_t i = _position[id];
+
+            if (i == NONE) {
+                i = _size++;
+                _id[i] = id;
+                _position[id] = i;
+            }
+
+            _due[i] = due_ms;
+
+            if (_siftUp(i) == i) _siftDown(i);
+
+        }
+
+        /**
+         * @brief Annule une échéance (sans effet si elle n'est pas programmée).
+         *
+         * @param id Identifiant de l'échéance.
+         */
+        void cancel(const uint8_t id) {
+            if (id < CAPACITY && _position[id] != NONE) _remove(_position[id]);
+        }
+
+        /**
+         * @brief Extrait l'échéance la plus ancienne parmi celles qui sont arrivées.
+         *
+         * @param now_ms Date courante (exprimée en millisecondes).
+         * @param id     Identifiant de l'échéance extraite.
+         *
+         * @return false si aucune échéance n'est arrivée.
+         *
+         * @note On appelle cette méthode en boucle pour traiter toutes les
+         *       échéances arrivées : le coût de la boucle ne dépend que de
+         *       leur nombre.
+         */
+        bool expired(const uint32_t now_ms, uint8_t &id) {
+
+            if (!_size || _before(now_ms, _due[0])) return false;
+
+            id = _id[0];
+            _remove(0);
+
+            return true;
+
+        }
+
+        /**
+         * @brief Détermine si une échéance est programmée.
+         *
+         * @param id Identifiant de l'échéance.
+         */
+        bool isScheduled(const uint8_t id) const {
+            return id < CAPACITY && _position[id] != NONE;
+        }
+
+        /**
+         * @brief Nombre d'échéances programmées.
+         */
+        uint8_t size() const {
+            return _size;
+        }
+
+        /**
+         * @brief Date de l'échéance la plus proche (à n'appeler que si size() n'est pas nul).
+         */
+        uint32_t next() const {
+            return _due[0];
+        }
+
+};
\ No newline at end of file
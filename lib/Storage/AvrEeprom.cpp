@@ -0,0 +1,34 @@
+/*
+ * --------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * --------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * --------------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe AvrEeprom
+ * --------------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe AvrEeprom avant de les définir.
+ */
+#include "AvrEeprom.h"
+#include <avr/eeprom.h>
+
+uint16_t AvrEeprom::size() const {
+    return E2END + 1;
+}
+
+bool AvrEeprom::isReady() const {
+    return eeprom_is_ready();
+}
+
+uint8_t AvrEeprom::read(const uint16_t address) const {
+    return eeprom_read_byte((const uint8_t *) address);
+}
+
+void AvrEeprom::write(const uint16_t address, const uint8_t data) {
+    eeprom_write_byte((uint8_t *) address, data);
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour l'accès octet par octet, non
+ * bloquant, à l'EEPROM interne du microcontrôleur
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe AvrEeprom
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe AvrEeprom.
+ *
+ * @note L'écriture d'un octet en EEPROM dure environ 3,4 ms (effacement puis
+ *       écriture). Les fonctions de la bibliothèque EEPROM attendent la fin
+ *       de l'écriture précédente avant de lancer la suivante : enregistrer
+ *       une centaine d'octets bloquerait la boucle principale pendant plus
+ *       d'un tiers de seconde.
+ *
+ *       Ici, on vérifie que l'EEPROM est disponible avec isReady() avant de
+ *       lancer chaque écriture : write() n'attend donc jamais.
+ *
+ *       Cette classe sert de support de stockage à la classe RecordLog. La
+ *       classe MemoryEeprom en fournit un équivalent en mémoire vive, pour
+ *       vérifier RecordLog sans carte Arduino.
+ */
+class AvrEeprom {
+
+    public:
+
+        /**
+         * @brief Capacité de l'EEPROM (exprimée en octets).
+         */
+        uint16_t size() const;
+
+        /**
+         * @brief Détermine si l'EEPROM est prête à recevoir une nouvelle écriture.
+         */
+        bool isReady() const;
+
+        /**
+         * @brief Lecture d'un octet.
+         *
+         * @param address Adresse de l'octet.
+         */
+        uint8_t read(const uint16_t address) const;
+
+        /**
+         * @brief Écriture d'un octet.
+         *
+         * @param address Adresse de l'octet.
+         * @param data    Valeur de l'octet.
+         *
+         * @note L'EEPROM doit être prête (isReady()), faute de quoi l'écriture
+         *       attend la fin de l'écriture précédente.
+         */
+        void write(const uint16_t address, const uint8_t data);
+
+};
\ No newline at end of file
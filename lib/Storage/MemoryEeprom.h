@@ -0,0 +1,137 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet qui simule une EEPROM en mémoire
+ * vive, et qui compte les cycles d'effacement et d'écriture de chaque octet
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe MemoryEeprom
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Définition de la classe MemoryEeprom.
+ *
+ * @tparam SIZE Capacité simulée (exprimée en octets).
+ *
+ * @note Cette classe offre la même interface que AvrEeprom : elle permet de
+ *       vérifier la classe RecordLog sur un ordinateur, et de mesurer l'usure
+ *       qu'elle inflige à chaque octet. Elle est bien trop gourmande en
+ *       mémoire (5 octets par octet simulé) pour être utilisée sur la carte.
+ *
+ *       Comme une véritable EEPROM, elle est entièrement effacée (0xFF) au
+ *       départ. Chaque écriture compte pour un cycle d'écriture, et pour un
+ *       cycle d'effacement si l'un des bits passe de 0 à 1 (seul l'effacement
+ *       peut remettre un bit à 1).
+ */
+template <uint16_t SIZE>
+class MemoryEeprom {
+
+    private:
+
+        /**
+         * @brief Contenu simulé de l'EEPROM.
+         */
+        uint8_t _data[SIZE];
+
+        /**
+         * @brief Nombre d'écritures subies par chaque octet.
+         */
+        uint16_t _writes[SIZE];
+
+        /**
+         * @brief Nombre d'effacements subis par chaque octet.
+         */
+        uint16_t _erases[SIZE];
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur : l'EEPROM est vierge.
+         */
+        MemoryEeprom() {
+            memset(_data, 0xff, SIZE);
+            memset(_writes, 0, sizeof(_writes));
+            memset(_erases, 0, sizeof(_erases));
+        }
+
+        /**
+         * @brief Capacité simulée (exprimée en octets).
+         */
+        uint16_t size() const {
+            return SIZE;
+        }
+
+        /**
+         * @brief L'EEPROM simulée est toujours prête.
+         */
+        bool isReady() const {
+            return true;
+        }
+
+        /**
+         * @brief Lecture d'un octet.
+         */
+        uint8_t read(const uint16_t address) const {
+            return _data[address];
+        }
+
+        /**
+         * @brief Écriture d'un octet, avec décompte des cycles.
+         */
+        void write(const uint16_t address, const uint8_t data) {
+
+            if (~_data[address] & data) _erases[address]++;
+
+            _writes[address]++;
+            _data[address] = data;
+
+        }
+
+        /**
+         * @brief Nombre d'écritures subies par un octet.
+         */
+        uint16_t writes(const uint16_t address) const {
+            return _writes[address];
+        }
+
+        /**
+         * @brief Nombre d'effacements subis par un octet.
+         */
+        uint16_t erases(const uint16_t address) const {
+            return _erases[address];
+        }
+
+        /**
+         * @brief Plus grand nombre d'écritures subies par un même octet.
+         */
+        uint16_t maxWrites() const {
+
+            uint16_t max = 0;
+            for (uint16_t i=0; i<SIZE; i++) if (_writes[i] > max) max = _writes[i];
+
+            return max;
+
+        }
+
+        /**
+         * @brief Altère un octet sans compter de cycle (simulation d'une écriture interrompue).
+         */
+        void corrupt(const uint16_t address, const uint8_t data) {
+            _data[address] = data;
+        }
+
+};
\ No newline at end of file
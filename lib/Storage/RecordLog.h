@@ -0,0 +1,326 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour la sauvegarde persistante d'un
+ * enregistrement en EEPROM, avec répartition de l'usure et somme de contrôle
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe RecordLog
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Définition de la classe RecordLog.
+ *
+ * @tparam T Type de l'enregistrement (une structure simple, copiable octet par octet).
+ * @tparam S Support de stockage (AvrEeprom sur la carte, MemoryEeprom pour les essais).
+ *
+ * @note Chaque octet d'EEPROM ne supporte qu'environ 100 000 cycles
+ *       d'écriture. Réécrire l'enregistrement toujours au même endroit
+ *       userait prématurément ces quelques octets.
+ *
+ *       La zone d'EEPROM est donc découpée en emplacements (slots), écrits
+ *       à tour de rôle, comme un journal circulaire :
+ *
+ *           +-----------+-------------------------+-----+
+ *           | séquence  | enregistrement (T)      | CRC |
+ *           | (2 oct.)  | (sizeof(T) octets)      |     |
+ *           +-----------+-------------------------+-----+
+ *
+ *       Chaque sauvegarde porte un numéro de séquence supérieur d'une unité à
+ *       la précédente, et une somme de contrôle (CRC-8) qui couvre le numéro
+ *       de séquence et l'enregistrement. Au démarrage, load() retient
+ *       l'emplacement valide de plus grand numéro de séquence : un
+ *       enregistrement interrompu par une coupure d'alimentation est écarté
+ *       par sa somme de contrôle, et c'est le précédent qui est chargé.
+ *       Le chargement se contente de lire la zone une seule fois (environ
+ *       1 ms pour 1 Ko).
+ *
+ *       Les sauvegardes sont limitées en fréquence : save() ne fait que
+ *       mémoriser la dernière valeur demandée, et update() ne l'écrit que si
+ *       `min_interval_ms` millisecondes se sont écoulées depuis la sauvegarde
+ *       précédente. L'écriture elle-même progresse d'un octet par appel à
+ *       update(), uniquement lorsque l'EEPROM est disponible : la boucle
+ *       principale n'est jamais bloquée. Les octets qui ont déjà la bonne
+ *       valeur ne sont pas réécrits.
+ *
+ *       Par exemple, avec 12 emplacements et une sauvegarde par minute au
+ *       plus, chaque octet est écrit au plus toutes les 12 minutes, soit plus
+ *       de deux ans de fonctionnement continu avant d'atteindre 100 000 cycles.
+ */
+template <class T, class S>
+class RecordLog {
+
+    static_assert(sizeof(T) <= 252, "record is too large");
+
+    private:
+
+        /**
+         * @brief Taille d'un emplacement (exprimée en octets).
+         */
+        static const uint8_t _SLOT_SIZE = sizeof(T) + 3;
+
+        /**
+         * @brief Numéro de séquence d'un emplacement vierge (EEPROM effacée).
+         */
+        static const uint16_t _BLANK = 0xffff;
+
+        /**
+         * @brief Support de stockage.
+         */
+        S &_storage;
+
+        /**
+         * @brief Adresse de début de la zone réservée au journal.
+         */
+        uint16_t _base;
+
+        /**
+         * @brief Nombre d'emplacements de la zone.
+         */
+        uint8_t _slots;
+
+        /**
+         * @brief Délai minimal entre deux sauvegardes (exprimé en millisecondes).
+         */
+        uint32_t _min_interval_ms;
+
+        /**
+         * @brief Numéro de séquence du dernier enregistrement.
+         */
+        uint16_t _seq;
+
+        /**
+         * @brief Prochain emplacement à écrire.
+         */
+        uint8_t _next;
+
+        /**
+         * @brief Emplacement en cours d'écriture, prêt à être copié octet par octet.
+         */
+        uint8_t _buffer[_SLOT_SIZE];
+
+        /**
+         * @brief Adresse de l'emplacement en cours d'écriture.
+         */
+        uint16_t _address;
+
+        /**
+         * @brief Nombre d'octets de l'emplacement déjà écrits.
+         */
+        uint8_t _written;
+
+        /**
+         * @brief Dernière valeur demandée, en attente de sauvegarde.
+         */
+        T _pending;
+
+        /**
+         * @brief Indique si une valeur est en attente de sauvegarde.
+         */
+        bool _dirty;
+
+        /**
+         * @brief Date de la dernière sauvegarde.
+         */
+        uint32_t _last_save_ms;
+
+        /**
+         * @brief Mise à jour d'une somme de contrôle CRC-8 (polynôme 0x07) avec un octet.
+         *
+         * @note Même calcul que _crc8_ccitt_update() de la avr-libc (les
+         *       journaux déjà écrits restent valides), mais sans dépendance à
+         *       la avr-libc : la classe se compile telle quelle sur un ordinateur.
+         */
+        static uint8_t _crcUpdate(uint8_t crc, const uint8_t data) {
+
+            crc ^= data;
+            for (uint8_t i=0; i<8; i++) crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+
+            return crc;
+
+        }
+
+        /**
+         * @brief Somme de contrôle d'un bloc d'octets.
+         */
+        static uint8_t _crc(const uint8_t *data, const uint8_t n) {
+
+            uint8_t crc = 0;
+            for (uint8_t i=0; i<n; i++) crc = _crcUpdate(crc, data[i]);
+
+            return crc;
+
+        }
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param storage         Support de stockage.
+         * @param base            Adresse de début de la zone réservée au journal.
+         * @param size            Taille de la zone (exprimée en octets).
+         * @param min_interval_ms Délai minimal entre deux sauvegardes (exprimé en millisecondes).
+         */
+        RecordLog(S &storage, const uint16_t base, const uint16_t size, const uint32_t min_interval_ms)
+            : _storage(storage)
+            , _base(base)
+            , _slots(size / _SLOT_SIZE > 255 ? 255 : size / _SLOT_SIZE)
+            , _min_interval_ms(min_interval_ms)
+            , _seq(0)
+            , _next(0)
+            , _written(_SLOT_SIZE)
+            , _dirty(false)
+            , _last_save_ms(0) {}
+
+        /**
+         * @brief Nombre d'emplacements de la zone.
+         */
+        uint8_t slots() const {
+            return _slots;
+        }
+
+        /**
+         * @brief Numéro de séquence du dernier enregistrement chargé ou sauvegardé.
+         */
+        uint16_t sequence() const {
+            return _seq;
+        }
+
+        /**
+         * @brief Chargement de l'enregistrement le plus récent.
+         *
+         * @param value Enregistrement chargé.
+         *
+         * @return false si aucun emplacement valide n'a été trouvé (`value` est
+         *         alors inchangé).
+         */
+        bool load(T &value) {
+
+            bool     found = false;
+            uint8_t  best  = 0;
+            uint16_t seq   = 0;
+
+            for (uint8_t s=0; s<_slots; s++) {
+
+                uint16_t address = _base + s * _SLOT_SIZE;
+                uint8_t  crc     = 0;
+
+                // La somme de contrôle est calculée au fil de la lecture, sans
+                // recopier l'emplacement en mémoire vive.
+                for (uint8_t i=0; i<_SLOT_SIZE - 1; i++) crc = _crcUpdate(crc, _storage.read(address + i));
+
+                uint16_t current = _storage.read(address) | _storage.read(address + 1) << 8;
+
+                if (current == _BLANK || crc != _storage.read(address + _SLOT_SIZE - 1)) continue;
+
+                // Comparaison valable même lorsque la séquence a fait le tour
+                // de 65536, puisque les emplacements valides sont consécutifs.
+                if (!found || (int16_t) (current - seq) > 0) {
+                    found = true;
+                    best  = s;
+                    seq   = current;
+                }
+
+            }
+
+            if (!found) return false;
+
+            uint16_t address = _base + best * _SLOT_SIZE + 2;
+            uint8_t *bytes   = (uint8_t *) &value;
+
+            for (uint8_t i=0; i<sizeof(T); i++) bytes[i] = _storage.read(address + i);
+
+            _seq  = seq;
+            _next = (best + 1) % _slots;
+
+            return true;
+
+        }
+
+        /**
+         * @brief Demande de sauvegarde d'un enregistrement.
+         *
+         * @param value Enregistrement à sauvegarder.
+         *
+         * @note La sauvegarde est différée : elle est effectuée par update(). Si
+         *       plusieurs demandes surviennent entre-temps, seule la dernière est
+         *       sauvegardée.
+         */
+        void save(const T &value) {
+            _pending = value;
+            _dirty   = true;
+        }
+
+        /**
+         * @brief Détermine si une sauvegarde est en attente ou en cours.
+         */
+        bool isBusy() const {
+            return _dirty || _written < _SLOT_SIZE;
+        }
+
+        /**
+         * @brief Progression de la sauvegarde, à appeler à chaque itération de la boucle principale.
+         *
+         * @param now_ms Date courante (exprimée en millisecondes).
+         *
+         * @note Au plus un octet est écrit par appel, et seulement si l'EEPROM
+         *       est disponible.
+         */
+        void update(const uint32_t now_ms) {
+
+            if (_written < _SLOT_SIZE) {
+
+                if (!_storage.isReady()) return;
+
+                while (_written < _SLOT_SIZE) {
+
+                    uint16_t address = _address + _written;
+                    uint8_t  data    = _buffer[_written++];
+
+                    if (_storage.read(address) != data) {
+                        _storage.write(address, data);
+                        return;
+                    }
+
+                }
+
+                return;
+
+            }
+
+            if (!_dirty || now_ms - _last_save_ms < _min_interval_ms || !_slots) return;
+
+            // Préparation de l'emplacement : la valeur en attente est recopiée,
+            // de sorte qu'une nouvelle demande de sauvegarde ne puisse pas
+            // altérer l'écriture en cours.
+            if (++_seq == _BLANK) _seq = 0;
+
+            _buffer[0] = _seq;
+            _buffer[1] = _seq >> 8;
+            memcpy(&_buffer[2], &_pending, sizeof(T));
+            _buffer[_SLOT_SIZE - 1] = _crc(_buffer, _SLOT_SIZE - 1);
+
+            _address      = _base + _next * _SLOT_SIZE;
+            _next         = (_next + 1) % _slots;
+            _written      = 0;
+            _dirty        = false;
+            _last_save_ms = now_ms;
+
+        }
+
+};
\ No newline at end of file
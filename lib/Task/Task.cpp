@@ -0,0 +1,44 @@
+/*
+ * ---------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ---------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ---------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe Task
+ * ---------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe Task avant de les définir.
+ */
+#include "Task.h"
+
+Task::Task(const uint8_t priority) : _priority(priority), _runtime_us(0), _runs(0), _lc(0) {}
+
+void Task::restart() {
+    _lc = 0;
+}
+
+bool Task::isEnded() const {
+    return _lc == TASK_ENDED_LC;
+}
+
+uint8_t Task::priority() const {
+    return _priority;
+}
+
+uint32_t Task::runtimeUs() const {
+    return _runtime_us;
+}
+
+uint16_t Task::runs() const {
+    return _runs;
+}
+
+void Task::resetStats() {
+    _runtime_us = 0;
+    _runs       = 0;
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet abstrait pour l'écriture de tâches
+ * coopératives sans pile (protothreads)
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Task
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Valeur du point de reprise d'une tâche terminée.
+ */
+#define TASK_ENDED_LC 0xffff
+
+/**
+ * @brief Début du corps d'une tâche (première instruction de la méthode run()).
+ */
+#define TASK_BEGIN() switch (_lc) { case 0:
+
+/**
+ * @brief Rend la main à l'ordonnanceur : la tâche reprendra juste après.
+ */
+#define TASK_YIELD()                                                          \
+    do {                                                                      \
+        _lc = __LINE__; return TaskState::yielded; case __LINE__:;            \
+    } while (0)
+
+/**
+ * @brief Rend la main à l'ordonnanceur tant que la condition n'est pas remplie.
+ */
+#define TASK_WAIT_UNTIL(condition)                                            \
+    do {                                                                      \
+        _lc = __LINE__; case __LINE__:                                        \
+        if (!(condition)) return TaskState::waiting;                          \
+    } while (0)
+
+/**
+ * @brief Fin du corps d'une tâche (dernière instruction de la méthode run()).
+ */
+#define TASK_END() } _lc = TASK_ENDED_LC; return TaskState::ended
+
+/**
+ * @brief État d'une tâche lorsqu'elle rend la main.
+ *
+ * @note waiting : la tâche attend une condition, elle n'a rien fait,
+ *       yielded : la tâche a travaillé, et rend la main pour laisser
+ *                 travailler les autres,
+ *       ended   : la tâche est terminée.
+ */
+enum class TaskState : uint8_t { waiting, yielded, ended };
+
+template <uint8_t CAPACITY> class TaskScheduler;
+
+/**
+ * @brief Définition de la classe abstraite Task.
+ *
+ * @note Une tâche est un objet dont la méthode run() est appelée en boucle
+ *       par l'ordonnanceur. Au lieu de s'exécuter d'une traite, elle rend
+ *       la main explicitement (TASK_YIELD, TASK_WAIT_UNTIL), et reprend à ce
+ *       même endroit lors de l'appel suivant :
+ *
+ *           TaskState run() override {
+ *               TASK_BEGIN();
+ *               for (;;) {
+ *                   TASK_WAIT_UNTIL(button.isPressed());
+ *                   ...
+ *                   TASK_YIELD();
+ *               }
+ *               TASK_END();
+ *           }
+ *
+ *       Ces macros transforment le corps de run() en une instruction switch
+ *       (technique du "Duff's device") : le point de reprise est le numéro
+ *       de la ligne où la tâche a rendu la main, mémorisé sur deux octets.
+ *       Aucune pile n'est réservée à la tâche, d'où deux contraintes :
+ *
+ *           - les variables locales de run() sont perdues chaque fois que
+ *             la tâche rend la main : ce qui doit survivre est un attribut,
+ *           - le corps de run() ne peut pas contenir d'instruction switch,
+ *             ni rendre la main dans une fonction appelée.
+ *
+ *       Chaque tâche occupe 11 octets de mémoire vive, comptabilité du temps
+ *       d'exécution comprise.
+ */
+class Task {
+
+    template <uint8_t CAPACITY> friend class TaskScheduler;
+
+    private:
+
+        /**
+         * @brief Priorité de la tâche (la plus haute vaut 255).
+         */
+        uint8_t _priority;
+
+        /**
+         * @brief Temps d'exécution cumulé (exprimé en microsecondes).
+         */
+        uint32_t _runtime_us;
+
+        /**
+         * @brief Nombre d'appels de la méthode run().
+         */
+        uint16_t _runs;
+
+    protected:
+
+        /**
+         * @brief Point de reprise de la tâche (0 au démarrage).
+         */
+        uint16_t _lc;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         *
+         * @param priority Priorité de la tâche (la plus haute vaut 255).
+         */
+        Task(const uint8_t priority);
+
+        /**
+         * @brief Exécution de la tâche jusqu'à ce qu'elle rende la main.
+         *
+         * @return L'état de la tâche lorsqu'elle rend la main.
+         *
+         * @note Cette méthode doit être définie par les classes dérivées, à
+         *       l'aide des macros TASK_BEGIN(), TASK_YIELD(), TASK_WAIT_UNTIL()
+         *       et TASK_END().
+         */
+        virtual TaskState run() = 0;
+
+        /**
+         * @brief Redémarre la tâche depuis le début.
+         */
+        void restart();
+
+        /**
+         * @brief Détermine si la tâche est terminée.
+         */
+        bool isEnded() const;
+
+        /**
+         * @brief Priorité de la tâche.
+         */
+        uint8_t priority() const;
+
+        /**
+         * @brief Temps d'exécution cumulé (exprimé en microsecondes).
+         */
+        uint32_t runtimeUs() const;
+
+        /**
+         * @brief Nombre d'appels de la méthode run() (modulo 65536).
+         */
+        uint16_t runs() const;
+
+        /**
+         * @brief Remise à zéro de la comptabilité du temps d'exécution.
+         */
+        void resetStats();
+
+};
\ No newline at end of file
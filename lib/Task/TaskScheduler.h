@@ -0,0 +1,130 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un modèle orienté objet pour l'ordonnancement de tâches
+ * coopératives par priorités
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe TaskScheduler
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include "Task.h"
+#include <Arduino.h>
+
+/**
+ * @brief Définition de la classe TaskScheduler.
+ *
+ * @tparam CAPACITY Nombre maximal de tâches.
+ *
+ * @note Les tâches sont rangées par priorité décroissante. Chaque appel de
+ *       run() (à placer dans la boucle principale) sollicite les tâches dans
+ *       cet ordre, jusqu'à ce que l'une d'elles travaille (TASK_YIELD) : les
+ *       tâches de priorité inférieure ne sont donc sollicitées que si toutes
+ *       les autres sont en attente (TASK_WAIT_UNTIL). Une tâche de haute
+ *       priorité doit donc attendre quelque chose, au moins de temps en
+ *       temps, sans quoi elle accapare le processeur.
+ *
+ *       Le temps passé dans chaque tâche est mesuré avec micros() (à 4 µs
+ *       près), y compris lorsqu'elle ne fait que constater qu'elle attend.
+ */
+template <uint8_t CAPACITY>
+class TaskScheduler {
+
+    private:
+
+        /**
+         * @brief Tâches ordonnancées, par priorité décroissante.
+         */
+        Task *_tasks[CAPACITY];
+
+        /**
+         * @brief Nombre de tâches ordonnancées.
+         */
+        uint8_t _count;
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         */
+        TaskScheduler() : _count(0) {}
+
+        /**
+         * @brief Ajoute une tâche à l'ordonnanceur.
+         *
+         * @param task Tâche à ordonnancer.
+         *
+         * @return false si l'ordonnanceur est complet.
+         *
+         * @note À priorité égale, les tâches sont sollicitées dans l'ordre
+         *       où elles ont été ajoutées.
+         */
+        bool add(Task &task) {
+
+            if (_count == CAPACITY) return false;
+
+            uint8_t i = _count++;
+
+            for (; i && _tasks[i - 1]->_priority < task._priority; i--) _tasks[i] = _tasks[i - 1];
+
+            _tasks[i] = &task;
+
+            return true;
+
+        }
+
+        /**
+         * @brief Sollicite les tâches jusqu'à ce que l'une d'elles travaille.
+         *
+         * @return La tâche qui a travaillé, ou nullptr si toutes sont en attente.
+         */
+        Task *run() {
+
+            for (uint8_t i=0; i<_count; i++) {
+
+                Task &task = *_tasks[i];
+
+                if (task.isEnded()) continue;
+
+                uint32_t  start = micros();
+                TaskState state = task.run();
+
+                task._runtime_us += micros() - start;
+                task._runs++;
+
+                if (state != TaskState::waiting) return &task;
+
+            }
+
+            return nullptr;
+
+        }
+
+        /**
+         * @brief Nombre de tâches ordonnancées.
+         */
+        uint8_t count() const {
+            return _count;
+        }
+
+        /**
+         * @brief Tâche de rang donné (par priorité décroissante).
+         *
+         * @param index Rang de la tâche.
+         */
+        Task &task(const uint8_t index) {
+            return *_tasks[index];
+        }
+
+};
\ No newline at end of file
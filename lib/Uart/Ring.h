@@ -0,0 +1,178 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un tampon circulaire d'octets partagé entre le programme
+ * principal et une routine d'interruption
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Ring
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Définition de la classe Ring.
+ *
+ * @tparam SIZE Capacité du tampon (puissance de 2, de 1 à 128 octets).
+ *
+ * @note Le tampon n'a qu'un seul producteur et un seul consommateur (par
+ *       exemple : le programme principal et la routine d'interruption de la
+ *       liaison série). Le producteur ne modifie que l'indice d'écriture, le
+ *       consommateur que l'indice de lecture : chacun étant lu ou écrit en
+ *       une seule instruction, aucune section critique n'est nécessaire.
+ *
+ *       Les indices avancent librement, modulo 256, et ne sont ramenés dans
+ *       le tampon qu'au moment de l'accès (par un simple masque, puisque la
+ *       capacité est une puissance de 2). Leur différence donne directement
+ *       le nombre d'octets en attente : les SIZE octets du tampon sont tous
+ *       utilisables, sans case sacrifiée pour distinguer le tampon plein du
+ *       tampon vide.
+ *
+ *       La classe ne dépend d'aucun registre : elle se compile et s'éprouve
+ *       telle quelle sur un ordinateur.
+ */
+template <uint8_t SIZE>
+class Ring {
+
+    static_assert(SIZE >= 1 && SIZE <= 128 && !(SIZE & (SIZE - 1)), "ring size must be a power of 2, up to 128");
+
+    private:
+
+        /**
+         * @brief Octets du tampon.
+         */
+        volatile uint8_t _data[SIZE];
+
+        /**
+         * @brief Indice d'écriture (modifié par le producteur seulement).
+         */
+        volatile uint8_t _head;
+
+        /**
+         * @brief Indice de lecture (modifié par le consommateur seulement).
+         */
+        volatile uint8_t _tail;
+
+    public:
+
+        /**
+         * @brief Capacité du tampon.
+         */
+        static const uint8_t CAPACITY = SIZE;
+
+        /**
+         * @brief Déclaration du constructeur.
+         */
+        Ring() : _head(0), _tail(0) {}
+
+        /**
+         * @brief Nombre d'octets en attente.
+         */
+        uint8_t size() const {
+            return (uint8_t) (_head - _tail);
+        }
+
+        /**
+         * @brief Nombre d'octets qui peuvent encore être déposés.
+         */
+        uint8_t space() const {
+            return SIZE - size();
+        }
+
+        /**
+         * @brief Détermine si le tampon est vide.
+         */
+        bool isEmpty() const {
+            return _head == _tail;
+        }
+
+        /**
+         * @brief Détermine si le tampon est plein.
+         */
+        bool isFull() const {
+            return size() == SIZE;
+        }
+
+        /**
+         * @brief Dépose un octet (producteur).
+         *
+         * @return false si le tampon est plein.
+         */
+        bool push(const uint8_t byte) {
+
+            uint8_t head = _head;
+
+            if ((uint8_t) (head - _tail) == SIZE) return false;
+
+            _data[head & (SIZE - 1)] = byte;
+            _head = head + 1;
+
+            return true;
+
+        }
+
+        /**
+         * @brief Dépose autant d'octets que le tampon peut en recevoir (producteur).
+         *
+         * @param data  Octets à déposer.
+         * @param count Nombre d'octets à déposer.
+         *
+         * @return Le nombre d'octets effectivement déposés.
+         *
+         * @note L'indice d'écriture n'est publié qu'une fois tous les octets
+         *       recopiés : le consommateur les découvre d'un seul coup.
+         */
+        uint8_t push(const uint8_t *data, uint8_t count) {
+
+            uint8_t head  = _head;
+            uint8_t space = SIZE - (uint8_t) (head - _tail);
+
+            if (count > space) count = space;
+
+            for (uint8_t i=0; i<count; i++) _data[head++ & (SIZE - 1)] = data[i];
+
+            _head = head;
+
+            return count;
+
+        }
+
+        /**
+         * @brief Extrait l'octet le plus ancien (consommateur).
+         *
+         * @param byte Octet extrait.
+         *
+         * @return false si le tampon est vide.
+         */
+        bool pop(uint8_t &byte) {
+
+            uint8_t tail = _tail;
+
+            if (tail == _head) return false;
+
+            byte  = _data[tail & (SIZE - 1)];
+            _tail = tail + 1;
+
+            return true;
+
+        }
+
+        /**
+         * @brief Vide le tampon (consommateur).
+         */
+        void clear() {
+            _tail = _head;
+        }
+
+};
\ No newline at end of file
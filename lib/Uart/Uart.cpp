@@ -0,0 +1,212 @@
+/*
+ * ----------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * ----------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * ----------------------------------------------------------------------
+ * Fichier de définition (implémentation) des méthodes de la classe Uart
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @note Incorpore le fichier d'en-tête qui déclare les attributs et les
+ *       méthodes de la classe Uart avant de les définir.
+ */
+#include "Uart.h"
+
+/**
+ * @brief Valeur maximale du registre UBRR0 (12 bits).
+ */
+static const uint16_t UBRR_MAX = 0x0fff;
+
+/**
+ * @brief Pilote associé aux routines d'interruption de l'USART0.
+ *
+ * @note Il n'existe qu'un seul USART sur l'ATmega328P, donc un seul pilote actif.
+ */
+static Uart *active_uart = nullptr;
+
+ISR(USART_UDRE_vect) {
+    active_uart->transmit();
+}
+
+#if UART_RX_SIZE
+
+ISR(USART_RX_vect) {
+    active_uart->receive();
+}
+
+#endif
+
+Uart::Uart() : _written(false), _blocking(false) {
+#if UART_RX_SIZE
+    _overruns = 0;
+#endif
+}
+
+void Uart::begin(const uint32_t baud) {
+
+    active_uart = this;
+    _written    = false;
+
+#if UART_RX_SIZE
+    _rx.clear();
+    _overruns = 0;
+#endif
+
+    // Double débit (U2X) : le bit TXC0 est effacé en y écrivant un 1.
+    UCSR0A = _BV(U2X0) | _BV(TXC0);
+    UBRR0  = ubrrFor(baud);
+    UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+
+    // L'interruption d'émission (UDRIE0) n'est activée que lorsque le
+    // tampon d'émission contient des octets.
+#if UART_RX_SIZE
+    UCSR0B = _BV(TXEN0) | _BV(RXEN0) | _BV(RXCIE0);
+#else
+    UCSR0B = _BV(TXEN0);
+#endif
+
+    if (!_tx.isEmpty()) UCSR0B |= _BV(UDRIE0);
+
+}
+
+void Uart::end() {
+
+    flush();
+
+    UCSR0B = 0;
+
+}
+
+uint16_t Uart::ubrrFor(const uint32_t baud) {
+
+    if (baud >= F_CPU / 8) return 0;
+    if (baud <= F_CPU / 8 / (UBRR_MAX + 1)) return UBRR_MAX;
+
+    // UBRR0 = F_CPU / (8 x baud) - 1, arrondi au plus proche.
+    return ((F_CPU / 4) / baud - 1) / 2;
+
+}
+
+uint32_t Uart::baudFor(const uint16_t ubrr) {
+    return F_CPU / 8 / (ubrr + 1UL);
+}
+
+void Uart::setBlocking(const bool blocking) {
+    _blocking = blocking;
+}
+
+size_t Uart::write(const uint8_t byte) {
+
+    while (!_tx.push(byte)) {
+        if (!_blocking) return 0;
+        _poll();
+    }
+
+    UCSR0B |= _BV(UDRIE0);
+
+    return 1;
+
+}
+
+size_t Uart::write(const uint8_t *buffer, size_t size) {
+
+    size_t accepted = 0;
+
+    // Les octets sont déposés par paquets de 255 au plus. Dès que le
+    // tampon en refuse, on s'arrête, ou on attend en mode bloquant.
+    while (size) {
+
+        uint8_t chunk = size > 0xff ? 0xff : size;
+        uint8_t count = _tx.push(buffer, chunk);
+
+        if (count) UCSR0B |= _BV(UDRIE0);
+
+        accepted += count;
+        buffer   += count;
+        size     -= count;
+
+        if (count < chunk) {
+            if (!_blocking) break;
+            _poll();
+        }
+
+    }
+
+    return accepted;
+
+}
+
+int Uart::availableForWrite() {
+    return _tx.space();
+}
+
+void Uart::flush() {
+
+    if (!_written && _tx.isEmpty()) return;
+
+    while (!_tx.isEmpty() || !(UCSR0A & _BV(TXC0))) _poll();
+
+}
+
+#if UART_RX_SIZE
+
+int Uart::available() {
+    return _rx.size();
+}
+
+int Uart::read() {
+
+    uint8_t byte;
+
+    if (!_rx.pop(byte)) return -1;
+
+    return byte;
+
+}
+
+uint8_t Uart::overruns() const {
+    return _overruns;
+}
+
+void Uart::receive() {
+
+    // Les bits d'erreur doivent être lus avant le registre de données.
+    bool lost = UCSR0A & _BV(DOR0);
+
+    if (!_rx.push(UDR0)) lost = true;
+
+    if (lost && _overruns < 0xff) _overruns++;
+
+}
+
+#endif
+
+void Uart::_poll() {
+
+    // Interruptions désactivées : la routine d'émission est appelée à la
+    // main dès que le registre de données est libre.
+    if (!(SREG & _BV(SREG_I)) && (UCSR0B & _BV(UDRIE0)) && (UCSR0A & _BV(UDRE0))) transmit();
+
+}
+
+void Uart::transmit() {
+
+    uint8_t byte;
+
+    if (!_tx.pop(byte)) {
+        UCSR0B &= ~_BV(UDRIE0);
+        return;
+    }
+
+    // TXC0 est effacé avant chaque octet : flush() sait ainsi quand le
+    // dernier est complètement sorti du registre à décalage.
+    UCSR0A = (UCSR0A & _BV(U2X0)) | _BV(TXC0);
+    UDR0   = byte;
+
+    _written = true;
+
+}
\ No newline at end of file
@@ -0,0 +1,224 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition d'un pilote léger de la liaison série (USART0), piloté par
+ * interruptions, dont les tampons sont dimensionnés à la compilation
+ * -------------------------------------------------------------------------
+ * Fichier d'en-tête (header) de définition de la classe Uart
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include "Ring.h"
+
+/**
+ * @brief Capacité du tampon d'émission (puissance de 2, de 1 à 128 octets).
+ */
+#ifndef UART_TX_SIZE
+#define UART_TX_SIZE 64
+#endif
+
+/**
+ * @brief Capacité du tampon de réception (puissance de 2, jusqu'à 128 octets).
+ *
+ * @note 0 produit un pilote en émission seule : ni tampon, ni routine
+ *       d'interruption de réception.
+ */
+#ifndef UART_RX_SIZE
+#define UART_RX_SIZE 0
+#endif
+
+/**
+ * @brief Définition de la classe Uart.
+ *
+ * @note Remplace HardwareSerial (Serial), qui réserve deux tampons de 64
+ *       octets quel que soit l'usage qu'en fait le programme. Les capacités
+ *       des tampons sont fixées à la compilation, par les options de
+ *       l'environnement PlatformIO (elles doivent être vues par Uart.cpp) :
+ *
+ *           build_flags = -D UART_TX_SIZE=32 -D UART_RX_SIZE=0
+ *
+ *       Par défaut, l'émission n'est jamais bloquante : write() dépose dans
+ *       le tampon autant d'octets qu'il peut en recevoir et renvoie ce
+ *       nombre, sans attendre. Les octets refusés sont perdus : pour ne pas
+ *       tronquer un message, le programme vérifie d'abord availableForWrite()
+ *       (ou passe temporairement en mode bloquant avec setBlocking()).
+ *
+ *       Le double débit (U2X) est toujours activé, ce qui permet d'atteindre
+ *       F_CPU / 8, soit 2 Mbauds à 16 MHz. Les débits qui divisent exactement
+ *       F_CPU / 8 (250 000, 500 000, 1 000 000 et 2 000 000 bauds) sont
+ *       exacts ; 115 200 bauds donne en réalité 117 647 bauds (+2,1 %).
+ *
+ *       À 1 Mbauds, un octet part toutes les 10 µs (160 cycles), et la
+ *       routine d'interruption en consomme une cinquantaine : l'émission
+ *       occupe environ un tiers du processeur tant que le tampon se vide.
+ *
+ *       Les routines d'interruption de l'USART0 sont définies par Uart.cpp :
+ *       un programme qui utilise Uart ne doit pas utiliser Serial (les deux
+ *       pilotes définiraient les mêmes vecteurs).
+ */
+class Uart : public Print {
+
+    private:
+
+        /**
+         * @brief Tampon d'émission.
+         */
+        Ring<UART_TX_SIZE> _tx;
+
+#if UART_RX_SIZE
+
+        /**
+         * @brief Tampon de réception.
+         */
+        Ring<UART_RX_SIZE> _rx;
+
+        /**
+         * @brief Nombre d'octets reçus perdus (tampon plein ou octet écrasé par le matériel).
+         */
+        volatile uint8_t _overruns;
+
+#endif
+
+        /**
+         * @brief Indique si un octet a été transmis depuis begin() (voir flush()).
+         */
+        volatile bool _written;
+
+        /**
+         * @brief Indique si l'émission attend que le tampon se libère (voir setBlocking()).
+         */
+        bool _blocking;
+
+        /**
+         * @brief Fait avancer l'émission lorsque les interruptions sont désactivées.
+         */
+        void _poll();
+
+    public:
+
+        /**
+         * @brief Déclaration du constructeur.
+         */
+        Uart();
+
+        /**
+         * @brief Démarrage de la liaison série (8 bits, sans parité, 1 bit de stop).
+         *
+         * @param baud Débit de la liaison (de F_CPU / 32768 à F_CPU / 8 bauds).
+         */
+        void begin(const uint32_t baud);
+
+        /**
+         * @brief Arrêt de la liaison série, après transmission du tampon d'émission.
+         */
+        void end();
+
+        /**
+         * @brief Valeur du registre UBRR0 pour un débit donné, en double débit (U2X).
+         *
+         * @param baud Débit souhaité.
+         */
+        static uint16_t ubrrFor(const uint32_t baud);
+
+        /**
+         * @brief Débit effectivement obtenu avec une valeur du registre UBRR0.
+         *
+         * @param ubrr Valeur du registre UBRR0.
+         */
+        static uint32_t baudFor(const uint16_t ubrr);
+
+        /**
+         * @brief Dépose un octet dans le tampon d'émission.
+         *
+         * @return 1 si l'octet a été accepté, 0 si le tampon est plein
+         *         (jamais en mode bloquant).
+         */
+        size_t write(const uint8_t byte) override;
+
+        /**
+         * @brief Dépose une suite d'octets dans le tampon d'émission.
+         *
+         * @param buffer Octets à émettre.
+         * @param size   Nombre d'octets à émettre.
+         *
+         * @return Le nombre d'octets acceptés (les premiers de la suite,
+         *         tous en mode bloquant).
+         */
+        size_t write(const uint8_t *buffer, size_t size) override;
+
+        using Print::write;
+
+        /**
+         * @brief Choix du comportement de write() lorsque le tampon d'émission est plein.
+         *
+         * @param blocking true pour attendre que le tampon se libère, false
+         *                 (par défaut) pour refuser les octets excédentaires.
+         *
+         * @note Le mode bloquant convient aux restitutions volumineuses, pour
+         *       lesquelles la perte d'octets est pire que l'attente.
+         */
+        void setBlocking(const bool blocking);
+
+        /**
+         * @brief Nombre d'octets que le tampon d'émission peut encore recevoir.
+         */
+        int availableForWrite() override;
+
+        /**
+         * @brief Attente de la transmission complète du tampon d'émission.
+         *
+         * @note Comme write() en mode bloquant, elle fonctionne aussi lorsque
+         *       les interruptions sont désactivées.
+         */
+        void flush() override;
+
+#if UART_RX_SIZE
+
+        /**
+         * @brief Nombre d'octets reçus en attente de lecture.
+         */
+        int available();
+
+        /**
+         * @brief Lecture de l'octet reçu le plus ancien.
+         *
+         * @return L'octet lu, ou -1 si aucun octet n'est en attente.
+         */
+        int read();
+
+        /**
+         * @brief Nombre d'octets reçus perdus depuis begin() (plafonné à 255).
+         */
+        uint8_t overruns() const;
+
+        /**
+         * @brief Réception d'un octet dans le tampon de réception.
+         *
+         * @note Cette méthode est appelée par la routine d'interruption
+         *       USART_RX_vect, et uniquement par elle.
+         */
+        void receive();
+
+#endif
+
+        /**
+         * @brief Transmission de l'octet suivant du tampon d'émission.
+         *
+         * @note Cette méthode est appelée par la routine d'interruption
+         *       USART_UDRE_vect, et uniquement par elle (ou par _poll()).
+         */
+        void transmit();
+
+};
\ No newline at end of file
@@ -13,16 +13,38 @@
  * Un intégrateur est utilisé pour effectuer une hystérésis temporelle de
  * sorte que le signal d'entrée doit être maintenu dans un état logique
  * (0 ou 1) constant pour que la sortie passe à cet état.
+ *
+ * L'échantillonnage et la restitution des données sont confiés à deux
+ * tâches coopératives : l'échantillonnage se poursuit pendant toute la
+ * durée de la restitution, et les échantillons relevés entre-temps sont
+ * mis de côté, puis enregistrés dès que l'enregistreur est réarmé.
  * -------------------------------------------------------------------------
  */
 
 #include <Arduino.h>
+#include <Task.h>
+#include <TaskScheduler.h>
+#include <MemoryMonitor.h>
+#include <Uart.h>
+
+#ifdef PROFILER
+#include <Profiler.h>
+#endif
 
 /**
  * @brief Broche de lecture de l'état du bouton.
  */
 const uint8_t BTN_PIN = 2;
 
+/**
+ * @brief Débit de la liaison série (exprimé en bauds).
+ *
+ * @note Le moniteur série doit être réglé sur le même débit :
+ *
+ *           pio device monitor -b 1000000
+ */
+const uint32_t BAUD_RATE = 1000000;
+
 /**
  * @brief Seuil maximal de l'intégrateur.
  * 
@@ -31,13 +53,97 @@ const uint8_t BTN_PIN = 2;
  */
 const uint8_t DEBOUNCING_THRESHOLD = 8;
 
+/**
+ * @brief Période d'échantillonnage (exprimée en microsecondes).
+ *
+ * @note C'est à peu près la durée d'une itération de la boucle principale
+ *       lorsqu'elle ne fait qu'échantillonner. La résolution de micros()
+ *       est de 4 µs.
+ */
+const uint8_t SAMPLE_PERIOD_US = 8;
+
+/**
+ * @brief Nombre de caractères maximal d'une ligne de la restitution.
+ *
+ * @note Une ligne n'est envoyée que lorsque le tampon d'émission de la
+ *       liaison série peut la recevoir en entier : elle n'est alors jamais
+ *       tronquée.
+ */
+const uint8_t LINE_SIZE = 32;
+
+/**
+ * @brief Nombre d'échantillons conservés avant le déclenchement (pré-déclenchement).
+ *
+ * @note L'enregistreur fonctionne comme un oscilloscope : il enregistre en
+ *       permanence dans un tampon circulaire, de sorte qu'au moment du
+ *       déclenchement, les échantillons qui le précèdent sont déjà en mémoire.
+ *       On observe ainsi les premiers fronts d'un appui, et les parasites qui
+ *       le devancent éventuellement.
+ */
+const uint8_t PRE_TRIGGER_SAMPLES = 24;
+
+/**
+ * @brief Nombre d'échantillons enregistrés à partir du déclenchement (post-déclenchement).
+ */
+const uint8_t POST_TRIGGER_SAMPLES = 40;
+
 /**
  * @brief Nombre d'échantillons maximal pouvant être enregistrés.
  * 
- * @note Cette valeur est fixée empiriquement sur la base des observations
- *       que j'ai effectuées sur différentes fenêtres d'échantillonnage.
+ * @note Chaque échantillon occupe 7 octets : les 64 échantillons du tampon
+ *       occupent donc 448 octets de mémoire vive.
+ */
+const uint8_t MAX_SAMPLES = PRE_TRIGGER_SAMPLES + POST_TRIGGER_SAMPLES;
+
+/**
+ * @brief Nombre d'échantillons mis de côté pendant la restitution.
+ *
+ * @note Le tampon principal est figé pendant toute la restitution : les
+ *       échantillons relevés entre-temps sont conservés dans ce second
+ *       tampon, plus petit (112 octets), puis enregistrés lorsque
+ *       l'enregistreur est réarmé. Il suffit à couvrir le déclenchement
+ *       d'un appui survenu pendant la restitution (DEBOUNCING_THRESHOLD
+ *       échantillons au moins). Au-delà, les échantillons sont perdus, et
+ *       leur nombre est signalé à la fin de la table.
+ */
+const uint8_t BACKLOG_SAMPLES = 16;
+
+/**
+ * @brief Délai au-delà duquel l'enregistrement est figé, même si le
+ *        post-déclenchement n'est pas complet (exprimé en microsecondes).
+ *
+ * @note Le signal est alors considéré comme stabilisé : il est inutile
+ *       d'attendre le prochain échantillon (le relâchement du bouton).
+ */
+const uint32_t POST_TRIGGER_TIMEOUT_US = 50000;
+
+/**
+ * @brief Conditions de déclenchement de l'enregistreur.
+ *
+ * @note edge       : premier changement d'état du signal d'entrée,
+ *       integrator : l'intégrateur atteint la valeur `TRIGGER_LEVEL`,
+ *       output     : changement d'état du signal de sortie.
+ */
+enum class Trigger : uint8_t { edge, integrator, output };
+
+/**
+ * @brief Condition de déclenchement retenue.
+ */
+const Trigger TRIGGER = Trigger::output;
+
+/**
+ * @brief Valeur de l'intégrateur qui provoque le déclenchement (condition `Trigger::integrator`).
  */
-const uint8_t MAX_SAMPLES = 4 * DEBOUNCING_THRESHOLD;
+const uint8_t TRIGGER_LEVEL = DEBOUNCING_THRESHOLD / 2;
+
+/**
+ * @brief Liaison série, en émission seule (voir UART_TX_SIZE et UART_RX_SIZE).
+ *
+ * @note Elle remplace Serial : ses 64 octets d'émission suffisent à la
+ *       restitution, qui n'envoie jamais plus d'une ligne à la fois, et la
+ *       réception, inutile ici, n'occupe aucun octet.
+ */
+Uart uart;
 
 // -----------------------------------------------------------------------------
 // Enregistrement des données (échantillonnage)
@@ -58,15 +164,37 @@ struct Sample {
  */
 struct DataLogger {
 
-    // Collection d'échantillons.
+    // État de l'enregistreur :
+    //   - armed     : enregistrement continu, en attente du déclenchement,
+    //   - triggered : enregistrement du post-déclenchement,
+    //   - frozen    : enregistrement figé, en attente de restitution (les
+    //                 nouveaux échantillons sont mis de côté).
+    enum State : uint8_t { armed, triggered, frozen };
+
+    // Collection d'échantillons (tampon circulaire).
     Sample samples[MAX_SAMPLES];
 
+    // Échantillons mis de côté pendant que l'enregistrement est figé, et
+    // pour chacun d'eux (un bit par échantillon), la condition de déclenchement.
+    Sample   backlog[BACKLOG_SAMPLES];
+    uint16_t backlog_fire;
+    uint8_t  backlogged;     // Nombre d'échantillons mis de côté.
+    uint8_t  dropped;        // Nombre d'échantillons perdus (second tampon plein).
+
+    uint8_t head;            // Emplacement du prochain échantillon.
     uint8_t records;         // Nombre d'échantillons enregistrés.
+    uint8_t trigger;         // Emplacement de l'échantillon de déclenchement.
+    uint8_t remaining;       // Nombre d'échantillons restant à enregistrer après le déclenchement.
+    State   state;           // État de l'enregistreur.
+
     uint8_t input;           // Valeur instantanée du signal d'entrée.
     uint8_t integrator;      // Valeur instantanée de l'intégrateur.
     uint8_t output;          // Valeur instantanée du signal de sortie.
     
-    uint8_t last_integrator; // Dernière valeur connue de l'intégrateur.
+    uint8_t  last_input;      // Dernière valeur connue du signal d'entrée.
+    uint8_t  last_integrator; // Dernière valeur connue de l'intégrateur.
+    uint8_t  last_output;     // Dernière valeur connue du signal de sortie.
+    uint32_t last_us;         // Date du dernier échantillon enregistré.
 
     /**
      * @brief Lecture de l'état du bouton (signal d'entrée).
@@ -86,6 +214,51 @@ struct DataLogger {
 
     }
 
+    /**
+     * @brief Évaluation de la condition de déclenchement.
+     */
+    bool isTriggered() const {
+
+        switch (TRIGGER) {
+            case Trigger::edge:       return input != last_input;
+            case Trigger::integrator: return integrator == TRIGGER_LEVEL && last_integrator != TRIGGER_LEVEL;
+            case Trigger::output:     return output != last_output;
+        }
+
+        return false;
+
+    }
+
+    /**
+     * @brief Enregistrement d'un échantillon dans le tampon circulaire.
+     *
+     * @param data Échantillon à enregistrer.
+     * @param fire Condition de déclenchement remplie par l'échantillon.
+     */
+    void record(const Sample &data, const bool fire) {
+
+        // On sélectionne l'échantillon qui va recevoir les données à enregistrer.
+        // Lorsque le tampon est plein, l'échantillon le plus ancien est écrasé.
+        samples[head] = data;
+
+        if (fire && state == armed) {
+            state     = triggered;
+            trigger   = head;
+            remaining = POST_TRIGGER_SAMPLES;
+        }
+
+        ++head %= MAX_SAMPLES;
+        if (records < MAX_SAMPLES) records++;
+
+        // Le tampon est figé dès que le post-déclenchement est complet : il
+        // contient alors au moins `PRE_TRIGGER_SAMPLES` échantillons antérieurs
+        // au déclenchement (si le bouton en a produit autant).
+        if (state == triggered && !--remaining) state = frozen;
+
+        last_us = data.timestamp_us;
+
+    }
+
     /**
      * @brief Sauvegarde opportuniste d'un échantillon.
      * 
@@ -93,33 +266,70 @@ struct DataLogger {
      */
     void save(const uint32_t time_us) {
 
-        // On n'enregistre un échantillon que lorsque la valeur instantanée
-        // de l'intégrateur a changé. En effet, les cas où l'intégrateur demeure
-        // constant sont les suivants :
-        //   - soit il est nul, autrement dit le bouton est considéré comme au repos,
-        //   - soit il a atteint sa valeur maximale, auquel cas le signal s'est stabilisé.
-        if (integrator != last_integrator) {
+        // Si le post-déclenchement tarde à se compléter, c'est que le signal
+        // s'est stabilisé : on fige l'enregistrement sans attendre.
+        if (state == triggered && time_us - last_us > POST_TRIGGER_TIMEOUT_US) {
+            state = frozen;
+            return;
+        }
+
+        // On n'enregistre un échantillon que lorsque le signal d'entrée ou la
+        // valeur instantanée de l'intégrateur a changé : tant que le bouton
+        // est au repos, ou que son signal est stabilisé, rien ne se passe.
+        if (input == last_input && integrator == last_integrator) return;
+
+        // Et on sauvegarde les données collectées par l'algorithme de Kenneth A. Kuhn.
+        Sample data = { input, integrator, output, time_us };
+
+        if (state != frozen) {
 
-            // On sélectionne l'échantillon qui va recevoir les données à enregistrer.
-            Sample * const sample = &samples[records];
+            record(data, isTriggered());
 
-            // Et on sauvegarde les données collectées par l'algorithme de Kenneth A. Kuhn.
-            sample->input        = input;
-            sample->integrator   = integrator;
-            sample->output       = output;
-            sample->timestamp_us = time_us;
+        } else if (backlogged < BACKLOG_SAMPLES) {
 
-            // Normalement, il suffirait d'incrémenter simplement le nombre d'enregistrements.
-            // records++;
+            // Enregistrement figé : l'échantillon est mis de côté, avec la
+            // condition de déclenchement, évaluée dès maintenant.
+            if (isTriggered()) backlog_fire |= 1U << backlogged;
+            backlog[backlogged++] = data;
 
-            // Mais on préfère jouer la prudence pour éviter un débordement...
-            ++records %= MAX_SAMPLES;
+        } else if (dropped < 0xff) {
 
-            // Et on n'oublie pas de sauvegarder la dernière valeur connue de l'intégrateur.
-            last_integrator = integrator;
+            dropped++;
 
         }
 
+        // Et on n'oublie pas de sauvegarder les dernières valeurs connues.
+        last_input      = input;
+        last_integrator = integrator;
+        last_output     = output;
+
+    }
+
+    /**
+     * @brief Réarmement de l'enregistreur, après la restitution.
+     *
+     * @note Les échantillons mis de côté sont enregistrés dans l'ordre, comme
+     *       s'ils venaient d'être relevés : un appui survenu pendant la
+     *       restitution peut ainsi déclencher l'enregistreur. Si celui-ci se
+     *       fige à nouveau, les échantillons restants attendent la
+     *       restitution suivante.
+     */
+    void rearm() {
+
+        records = 0;
+        state   = armed;
+
+        uint8_t i = 0;
+
+        while (i < backlogged && state != frozen) {
+            record(backlog[i], backlog_fire >> i & 0x1);
+            i++;
+        }
+
+        backlogged  -= i;
+        backlog_fire = (uint32_t) backlog_fire >> i;
+        memmove(backlog, backlog + i, backlogged * sizeof(Sample));
+
     }
 
     /**
@@ -144,98 +354,296 @@ struct DataLogger {
         vsnprintf_P(buffer, sizeof(buffer), (const char *)format, args);
         va_end(args);
         
-        Serial.print(buffer);
+        uart.print(buffer);
+
+    }
+
+};
+
+DataLogger logger; 
+
+/**
+ * @brief Surveillance de la mémoire vive.
+ *
+ * @note Le tampon d'échantillons occupe à lui seul près du quart de la
+ *       mémoire vive : l'occupation de la mémoire est affichée après chaque
+ *       table, pour dimensionner le tampon en connaissance de cause. Une
+ *       alerte est émise lorsque la marge passe sous 128 octets.
+ */
+MemoryMonitor memory(128);
 
+#ifdef PROFILER
+
+/**
+ * @brief Nombre de tranches d'adresses du profileur.
+ */
+const uint8_t PROFILER_BINS = 64;
+
+/**
+ * @brief Compteurs des tranches d'adresses du profileur.
+ */
+uint16_t profile[PROFILER_BINS];
+
+/**
+ * @brief Profileur statistique (environnement PlatformIO `profile`).
+ *
+ * @note L'histogramme est restitué après chaque table, puis remis à zéro.
+ *       Il s'analyse avec tools/symbolize.py.
+ */
+Profiler profiler(profile, PROFILER_BINS);
+
+#endif
+
+// -----------------------------------------------------------------------------
+// Tâches coopératives
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Tâche d'échantillonnage du bouton.
+ *
+ * @note C'est la tâche la plus prioritaire : elle est sollicitée avant toute
+ *       autre, et ne laisse la main à la restitution qu'en attendant la
+ *       période d'échantillonnage suivante.
+ */
+struct SampleTask : public Task {
+
+    uint32_t last_us; // Date du dernier échantillon.
+
+    using Task::Task;
+
+    TaskState run() override {
+
+        TASK_BEGIN();
+
+        for (;;) {
+
+            TASK_WAIT_UNTIL(micros() - last_us >= SAMPLE_PERIOD_US);
+
+            last_us = micros();
+
+            // Lecture de l'état courant du bouton.
+            logger.read();
+
+            // L'enregistrement est continu : le tampon circulaire conserve en
+            // permanence les derniers échantillons. Lorsque la condition de
+            // déclenchement est remplie, l'enregistrement se poursuit jusqu'à ce
+            // que le post-déclenchement soit complet, puis le tampon est figé,
+            // et les échantillons suivants sont mis de côté.
+            logger.save(last_us);
+
+            TASK_YIELD();
+
+        }
+
+        TASK_END();
+
+    }
+
+};
+
+/**
+ * @brief Tâche d'échantillonnage (priorité 2).
+ */
+SampleTask sampler(2);
+
+/**
+ * @brief Tâche de restitution des données enregistrées.
+ * 
+ * @note Rien de bien compliqué ici, si ce n'est (à la rigueur) le formatage
+ *       de l'affichage pour faciliter la lecture des données...
+ * 
+ *       Cette fonction affiche simplement les données enregistrée au cours de
+ *       l'échantillonnage dans une table formatée ainsi :
+ * 
+ *                  _______________________ rang de l'échantillon
+ *                 /         ______________ durée écoulée depuis l'échantillon précédent (en µs)
+ *                /         /   ___________ signal d'entrée
+ *               /         /   /    _______ intégrateur et sens de variation
+ *              /         /   /    /     __ signal de sortie
+ *             /         /   /    /     /
+ *           ---+---------+---+------+---
+ *            # |      µs | i |  ∑   | o
+ *           ---+---------+---+------+---
+ *            1 |       0 | 1 |  1 + | 0
+ *            2 |       8 | 1 |  2 + | 0
+ *            3 |      12 | 1 |  3 + | 0
+ *            4 |       8 | 1 |  4 + | 0
+ *            5 |       8 | 1 |  5 + | 0
+ *            6 |      12 | 1 |  6 + | 0
+ *            7 |       8 | 1 |  7 + | 0
+ *           ---+---------+---+------+---             (DEBOUNCING_THRESHOLD = 8)
+ *            8 |       8 | 1 |  8 + | 1  <-- L'intégrateur atteint ici le seuil maximal,
+ *           ---+---------+---+------+---     donc le signal de sortie passe à 1.
+ *            9 |      48 | 0 |  7 - | 1  -+
+ *           10 |       8 | 0 |  6 - | 1   |  Puis on observe la manifestation d'un rebond,
+ *           11 |       8 | 0 |  5 - | 1   |  le signal d'entrée repasse à 0, puis revient à 1,
+ *           12 |      12 | 1 |  6 + | 1   |  donc l'intégrateur décroît puis croît à nouveau.
+ *           13 |       8 | 1 |  7 + | 1   |
+ *           ---+---------+---+------+---  |
+ *           14 |       8 | 1 |  8 + | 1  -+
+ *           ---+---------+---+------+---
+ *           15 |    4700 | 0 |  7 - | 1  -+  On voit que le bouton est maintenu enfoncé
+ *           16 |       8 | 0 |  6 - | 1   |  pendant près de 5 millisecondes.
+ *           17 |      12 | 0 |  5 - | 1   |
+ *           18 |       8 | 0 |  4 - | 1   |  Puis l'intégrateur descend en chute libre
+ *           19 |       8 | 0 |  3 - | 1   |  car le bouton est relâché par l'utilisateur...
+ *           20 |      12 | 0 |  2 - | 1   |
+ *           21 |       8 | 0 |  1 - | 1  -+
+ *           ---+---------+---+------+---
+ *                            |  0 - | 0  <-- pour finalement retomber à zéro (plancher)
+ *                                            et le signal de sortie repasse alors à 0.
+ *
+ *       Les échantillons sont restitués du plus ancien au plus récent, et
+ *       l'échantillon de déclenchement est précédé d'une ligne "trigger".
+ *
+ *       La tâche rend la main avant chaque ligne, tant que le tampon
+ *       d'émission ne peut pas la recevoir : à 1 Mbauds, il faut environ
+ *       300 µs pour transmettre une ligne, pendant lesquelles l'échantillonnage
+ *       se poursuit. Le tampon principal reste figé jusqu'à la fin de la
+ *       restitution : les échantillons relevés entre-temps sont mis de côté
+ *       (voir BACKLOG_SAMPLES), puis enregistrés au réarmement.
+ *
+ *       Le temps d'exécution de chaque tâche est affiché à la fin de la table.
+ */
+struct DumpTask : public Task {
+
+    // Les variables qui doivent survivre lorsque la tâche rend la main
+    // sont des attributs, et non des variables locales.
+    uint8_t  first;   // Emplacement de l'échantillon le plus ancien.
+    uint8_t  i;       // Rang de l'échantillon en cours de restitution.
+    uint32_t last_us; // Date de l'échantillon précédent.
+
+    using Task::Task;
+
+    /**
+     * @brief Échantillon de rang `i`.
+     */
+    Sample *sample() const {
+        return &logger.samples[(first + i) % MAX_SAMPLES];
     }
 
     /**
-     * @brief Restitution des données enregistrées.
-     * 
-     * @note Rien de bien compliqué ici, si ce n'est (à la rigueur) le formatage
-     *       de l'affichage pour faciliter la lecture des données...
-     * 
-     *       Cette fonction affiche simplement les données enregistrée au cours de
-     *       l'échantillonnage dans une table formatée ainsi :
-     * 
-     *                  _______________________ rang de l'échantillon
-     *                 /         ______________ durée écoulée depuis l'échantillon précédent (en µs)
-     *                /         /   ___________ signal d'entrée
-     *               /         /   /    _______ intégrateur et sens de variation
-     *              /         /   /    /     __ signal de sortie
-     *             /         /   /    /     /
-     *           ---+---------+---+------+---
-     *            # |      µs | i |  ∑   | o
-     *           ---+---------+---+------+---
-     *            1 |       0 | 1 |  1 + | 0
-     *            2 |       8 | 1 |  2 + | 0
-     *            3 |      12 | 1 |  3 + | 0
-     *            4 |       8 | 1 |  4 + | 0
-     *            5 |       8 | 1 |  5 + | 0
-     *            6 |      12 | 1 |  6 + | 0
-     *            7 |       8 | 1 |  7 + | 0
-     *           ---+---------+---+------+---             (DEBOUNCING_THRESHOLD = 8)
-     *            8 |       8 | 1 |  8 + | 1  <-- L'intégrateur atteint ici le seuil maximal,
-     *           ---+---------+---+------+---     donc le signal de sortie passe à 1.
-     *            9 |      48 | 0 |  7 - | 1  -+
-     *           10 |       8 | 0 |  6 - | 1   |  Puis on observe la manifestation d'un rebond,
-     *           11 |       8 | 0 |  5 - | 1   |  le signal d'entrée repasse à 0, puis revient à 1,
-     *           12 |      12 | 1 |  6 + | 1   |  donc l'intégrateur décroît puis croît à nouveau.
-     *           13 |       8 | 1 |  7 + | 1   |
-     *           ---+---------+---+------+---  |
-     *           14 |       8 | 1 |  8 + | 1  -+
-     *           ---+---------+---+------+---
-     *           15 |    4700 | 0 |  7 - | 1  -+  On voit que le bouton est maintenu enfoncé
-     *           16 |       8 | 0 |  6 - | 1   |  pendant près de 5 millisecondes.
-     *           17 |      12 | 0 |  5 - | 1   |
-     *           18 |       8 | 0 |  4 - | 1   |  Puis l'intégrateur descend en chute libre
-     *           19 |       8 | 0 |  3 - | 1   |  car le bouton est relâché par l'utilisateur...
-     *           20 |      12 | 0 |  2 - | 1   |
-     *           21 |       8 | 0 |  1 - | 1  -+
-     *           ---+---------+---+------+---
-     *                            |  0 - | 0  <-- pour finalement retomber à zéro (plancher)
-     *                                            et le signal de sortie repasse alors à 0.
+     * @brief Détermine si l'échantillon de rang `i` porte l'intégrateur à son seuil maximal.
      */
-    void dump() {
+    bool isMax() const {
+        return sample()->integrator == DEBOUNCING_THRESHOLD;
+    }
+
+    /**
+     * @brief Détermine si le tampon d'émission peut recevoir une ligne entière.
+     */
+    static bool canWrite() {
+        return uart.availableForWrite() >= LINE_SIZE;
+    }
+
+    TaskState run() override {
+
+        TASK_BEGIN();
+
+        for (;;) {
+
+            // On restitue les données d'échantillonnage dès que l'enregistreur
+            // est figé, avant de le réarmer pour la prochaine collecte.
+            TASK_WAIT_UNTIL(logger.state == DataLogger::frozen);
+
+            // L'échantillon le plus ancien est celui qui suit le dernier enregistré.
+            first   = (logger.head + MAX_SAMPLES - logger.records) % MAX_SAMPLES;
+            last_us = logger.samples[first].timestamp_us;
 
-        uint32_t last_us = samples[0].timestamp_us;
+            TASK_WAIT_UNTIL(canWrite());
+            uart.print(F("\n\n"));
+            uart.print(F("---+---------+---+------+---\n"));
+            TASK_WAIT_UNTIL(canWrite());
+            uart.print(F(" # |      µs | i |  ∑   | o\n"));
+            TASK_WAIT_UNTIL(canWrite());
+            uart.print(F("---+---------+---+------+---\n"));
 
-        Serial.print(F("\n\n"));
-        Serial.print(F("---+---------+---+------+---\n"));
-        Serial.print(F(" # |      µs | i |  ∑   | o\n"));
-        Serial.print(F("---+---------+---+------+---\n"));
+            for (i=0; i<logger.records; i++) {
 
-        for (uint8_t i=0; i<records; i++) {
+                TASK_WAIT_UNTIL(canWrite());
 
-            Sample * const sample = &samples[i];
-            bool           is_max = sample->integrator == DEBOUNCING_THRESHOLD;
+                if ((first + i) % MAX_SAMPLES == logger.trigger) uart.println(F("===+=== trigger ==========="));
+                else if (isMax()) uart.println(F("---+---------+---+------+---"));
 
-            if (is_max) Serial.println(F("---+---------+---+------+---"));
+                TASK_WAIT_UNTIL(canWrite());
 
-            printf(F("%2u | %7lu | %u | %2u %c | %u\n"),
-                i+1,
-                sample->timestamp_us - last_us,
-                sample->input,
-                sample->integrator,
-                sample->input ? '+' : '-',
-                sample->output);
+                logger.printf(F("%2u | %7lu | %u | %2u %c | %u\n"),
+                    i+1,
+                    sample()->timestamp_us - last_us,
+                    sample()->input,
+                    sample()->integrator,
+                    sample()->input ? '+' : '-',
+                    sample()->output);
 
-            if (is_max) Serial.println(F("---+---------+---+------+---"));
+                if (isMax()) {
+                    TASK_WAIT_UNTIL(canWrite());
+                    uart.println(F("---+---------+---+------+---"));
+                }
 
-            last_us = sample->timestamp_us;
+                last_us = sample()->timestamp_us;
+
+            }
+
+            TASK_WAIT_UNTIL(canWrite());
+            uart.print(F("---+---------+---+------+---\n"));
+
+            // Échantillons perdus pendant la restitution précédente.
+            if (logger.dropped) {
+                TASK_WAIT_UNTIL(canWrite());
+                logger.printf(F("dropped: %u samples\n"), logger.dropped);
+                logger.dropped = 0;
+            }
+
+            // Réinitialisation des données de l'enregistreur, qui est réarmé.
+            // Les dernières valeurs connues sont conservées : l'enregistrement
+            // reprend exactement là où il s'était arrêté, avec les
+            // échantillons mis de côté pendant la restitution.
+            logger.rearm();
+
+            // Temps d'exécution de chaque tâche depuis la dernière restitution.
+            TASK_WAIT_UNTIL(canWrite());
+            logger.printf(F("sampler: %lu us\n"), sampler.runtimeUs());
+            TASK_WAIT_UNTIL(canWrite());
+            logger.printf(F("dumper: %lu us\n"), runtimeUs());
+
+            sampler.resetStats();
+            resetStats();
+
+            // Occupation de la mémoire vive, et alerte éventuelle.
+            TASK_WAIT_UNTIL(uart.availableForWrite() >= MemoryMonitor::REPORT_SIZE);
+            memory.report(uart);
+
+            if (memory.isLow()) {
+                TASK_WAIT_UNTIL(canWrite());
+                uart.println(F("warning: low memory"));
+            }
+
+#ifdef PROFILER
+            // La restitution de l'histogramme est bloquante : c'est sans
+            // importance dans une version destinée au profilage.
+            uart.setBlocking(true);
+            profiler.dump(uart);
+            uart.setBlocking(false);
+            profiler.reset();
+#endif
 
         }
-        
-        Serial.print(F("---+---------+---+------+---\n"));
 
-        // Réinitialisation des données de l'enregistreur.
-        records         = 0;
-        last_integrator = 0;
+        TASK_END();
 
     }
 
 };
 
-DataLogger logger; 
+/**
+ * @brief Tâche de restitution (priorité 1).
+ */
+DumpTask dumper(1);
+
+/**
+ * @brief Ordonnanceur des tâches.
+ */
+TaskScheduler<2> scheduler;
 
 // -----------------------------------------------------------------------------
 // Squelette du programme principal
@@ -249,11 +657,19 @@ void setup() {
     // Configuration de la broche de lecture du bouton.
     pinMode(BTN_PIN, INPUT);
     
-    // Initialisation du moniteur série.
-    Serial.begin(9600);
-    while (!Serial);
-    Serial.println(F("\n\nDebouncing with Kenneth A. Kuhn's algorithm"));
-    Serial.println(F("https://www.kennethkuhn.com/electronics/debounce.c"));
+    // Initialisation du moniteur série. L'en-tête est plus long que le
+    // tampon d'émission : on attend qu'il soit transmis.
+    uart.begin(BAUD_RATE);
+    uart.println(F("\n\nDebouncing with Kenneth A. Kuhn's algorithm"));
+    uart.flush();
+    uart.println(F("https://www.kennethkuhn.com/electronics/debounce.c"));
+
+    scheduler.add(sampler);
+    scheduler.add(dumper);
+
+#ifdef PROFILER
+    profiler.begin();
+#endif
 
 }
 
@@ -262,19 +678,8 @@ void setup() {
  */
 void loop() {
 
-    // Lecture de l'état courant du bouton.
-    logger.read();
-
-    // Si l'intégrateur n'est pas nul, c'est que le bouton a été sollicité.
-    // Il convient donc de démarrer la fenêtre d'échantillonnage et de
-    // poursuivre les enregistrements jusqu'à ce que l'intégrateur retombe
-    // à une valeur nulle, indiquant que le bouton est de nouveau au repos.
-    // 
-    // Dans ce cas, on contrôle si des enregistrements ont été effectués et,
-    // le cas échéant, on restitue les données d'échantillonnage avant de
-    // lancer la prochaine collecte.
-
-         if (logger.integrator) logger.save(micros());
-    else if (logger.records) logger.dump();
+    // Les tâches se partagent le processeur : l'échantillonnage est toujours
+    // prioritaire sur la restitution des données.
+    scheduler.run();
 
 }
\ No newline at end of file
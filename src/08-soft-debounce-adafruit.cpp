@@ -13,6 +13,7 @@
 #include <Arduino.h>
 #include <Led.h>
 #include <AdafruitButton.h>
+#include <PinSetup.h>
 
 /**
  * @brief Définition des LEDs.
@@ -35,9 +36,22 @@ AdafruitButton button(2);
 /**
  * @brief Démarrage du programme principal.
  * 
- * @note Il n'y'a rien de spécial à effectuer ici...
+ * @note Les LEDs et le bouton, construits à la compilation, déclarent ici
+ *       leurs broches (voir PinSetup).
  */
-void setup() {}
+void setup() {
+
+    PinSetup pins;
+
+    led1.configure(pins);
+    led2.configure(pins);
+    led3.configure(pins);
+    led4.configure(pins);
+    button.configure(pins);
+
+    pins.apply();
+
+}
 
 /**
  * @brief Boucle de contrôle principale.
@@ -7,12 +7,18 @@
  * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
  * -------------------------------------------------------------------------
  * Balayage bidirectionnel du chenillard à LEDs contrôlé par un bouton.
+ *
+ * Un clic fait avancer le chenillard d'une LED, un double clic inverse le
+ * sens du balayage, et un appui prolongé le fait défiler de plus en plus
+ * vite, jusqu'au relâchement du bouton.
  * -------------------------------------------------------------------------
  */
 
 #include <Arduino.h>
 #include <Led.h>
 #include <AdafruitButton.h>
+#include <Gesture.h>
+#include <PinSetup.h>
 
 /**
  * @brief Nombre de LEDs.
@@ -43,6 +49,15 @@ Led led[] = { Led(5), Led(6), Led(7), Led(8), Led(9), Led(10), Led(11), Led(12)
  */
 AdafruitButton button(2);
 
+/**
+ * @brief Reconnaissance des gestes effectués sur le bouton.
+ *
+ * @note C'est elle qui mesure les délais de double clic et d'appui long, et
+ *       qui cadence le défilement : le programme principal n'a plus à lire
+ *       l'horloge.
+ */
+Gesture gesture(button);
+
 /**
  * @brief Indice de la LED active sur le chenillard.
  */
@@ -61,11 +76,37 @@ uint8_t index = 0;
  */
 int8_t direction = 1;
 
+/**
+ * @brief Décale le chenillard d'une LED dans le sens du balayage.
+ */
+void step() {
+
+    // On vérifie les cas où l'on a atteint les extrémités du chenillard,
+    // auquel cas il faut inverser la direction du balayage.
+    if ((!index && direction < 0) || (index + 1 == NUM_LEDS && direction > 0)) direction *= -1;
+
+    // On éteint la LED active.
+    led[index].light(false);
+
+    // Puis on détermine l'indice de la prochaine LED à activer en fonction de la
+    // direction du balayage, et on l'allume.
+    led[index += direction].light(true);
+
+}
+
 /**
  * @brief Démarrage du programme principal.
  */
 void setup() {
 
+    // LEDs du chenillard et bouton.
+    PinSetup pins;
+
+    for (uint8_t i=0; i<NUM_LEDS; i++) led[i].configure(pins);
+    button.configure(pins);
+
+    pins.apply();
+
     // On allume la première LED du chenillard (`index` est initialisé à 0).
     led[index].light(true);
 
@@ -79,19 +120,21 @@ void loop() {
     // Lecture de l'état du bouton.
     button.read();
 
-    // À chaque fois qu'on vient d'enfoncer le bouton...
-    if (button.isPressed()) {
+    // Puis interprétation du geste effectué.
+    switch (gesture.update()) {
 
-        // On vérifie les cas où l'on a atteint les extrémités du chenillard,
-        // auquel cas il faut inverser la direction du balayage.
-        if ((!index && direction < 0) || (index + 1 == NUM_LEDS && direction > 0)) direction *= -1;
+        case GestureEvent::click:
+        case GestureEvent::longPress:
+        case GestureEvent::repeat:
+            step();
+            break;
 
-        // On éteint la LED active.
-        led[index].light(false);
+        case GestureEvent::doubleClick:
+            direction *= -1;
+            break;
 
-        // Puis on détermine l'indice de la prochaine LED à activer en fonction de la
-        // direction du balayage, et on l'allume.
-        led[index += direction].light(true);
+        default:
+            break;
 
     }
 
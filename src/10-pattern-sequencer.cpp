@@ -0,0 +1,157 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Animations autonomes du chenillard jouées par un séquenceur de motifs
+ * stockés en mémoire Flash. Le bouton permet de changer de motif (appui
+ * bref) ou de vitesse (appui maintenu pendant une seconde).
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <PinLedBank.h>
+#include <AdafruitButton.h>
+#include <Sequencer.h>
+#include <Patterns.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 8;
+
+/**
+ * @brief Broches de commande des LEDs.
+ */
+const uint8_t LED_PIN[] = { 5, 6, 7, 8, 9, 10, 11, 12 };
+
+/**
+ * @brief Durée d'appui au-delà de laquelle on change de vitesse (exprimée en millisecondes).
+ */
+const uint16_t HOLD_DELAY_MS = 1000;
+
+/**
+ * @brief Motif défini par l'utilisateur : les LEDs convergent vers le centre puis s'en écartent.
+ *
+ * @note Chaque image est suivie de sa durée d'affichage, exprimée en nombre de tops.
+ */
+const uint8_t CONVERGE_FRAMES[] PROGMEM = {
+    0b10000001, 8,
+    0b01000010, 8,
+    0b00100100, 8,
+    0b00011000, 16,
+    0b00100100, 8,
+    0b01000010, 8
+};
+
+const Pattern CONVERGE PROGMEM = { CONVERGE_FRAMES, 6, 1, 0 };
+
+/**
+ * @brief Liste des motifs proposés, dans l'ordre où on les fait défiler.
+ *
+ * @note La liste elle-même est stockée en mémoire Flash.
+ */
+const Pattern * const PATTERNS[] PROGMEM = { &PING_PONG, &WRAP, &KNIGHT_RIDER, &BINARY_COUNTER, &CONVERGE };
+
+/**
+ * @brief Nombre de motifs proposés.
+ */
+const uint8_t NUM_PATTERNS = sizeof(PATTERNS) / sizeof(PATTERNS[0]);
+
+/**
+ * @brief Périodes des tops d'horloge du séquenceur (exprimées en millisecondes).
+ */
+const uint8_t TICKS_MS[] = { 10, 5, 20 };
+
+/**
+ * @brief Nombre de vitesses proposées.
+ */
+const uint8_t NUM_TICKS = sizeof(TICKS_MS);
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ */
+PinLedBank bank(LED_PIN, NUM_LEDS);
+
+/**
+ * @brief Instanciation du séquenceur.
+ */
+Sequencer sequencer(bank, TICKS_MS[0]);
+
+/**
+ * @brief Instanciation du bouton poussoir.
+ */
+AdafruitButton button(2);
+
+/**
+ * @brief Indice du motif en cours.
+ */
+uint8_t pattern = 0;
+
+/**
+ * @brief Indice de la vitesse en cours.
+ */
+uint8_t speed = 0;
+
+/**
+ * @brief Indique si l'appui en cours a déjà provoqué un changement de vitesse.
+ *
+ * @note Sans cette précaution, la vitesse changerait à chaque passage dans
+ *       la boucle tant que le bouton reste enfoncé au-delà d'une seconde.
+ */
+bool speed_changed = false;
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // Rampe de LEDs et bouton.
+    PinSetup pins;
+
+    bank.configure(pins);
+    button.configure(pins);
+
+    pins.apply();
+
+    sequencer.play((const Pattern *) pgm_read_ptr(&PATTERNS[pattern]));
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Lecture de l'état du bouton.
+    button.read();
+
+    // Un appui maintenu change la vitesse, une seule fois par appui.
+    if (button.wasHeldFor(HOLD_DELAY_MS) && !speed_changed) {
+
+        ++speed %= NUM_TICKS;
+        sequencer.setTick(TICKS_MS[speed]);
+        speed_changed = true;
+
+    }
+
+    // Au relâchement, un appui bref passe au motif suivant.
+    if (button.isReleased()) {
+
+        if (!speed_changed) {
+            ++pattern %= NUM_PATTERNS;
+            sequencer.play((const Pattern *) pgm_read_ptr(&PATTERNS[pattern]));
+        }
+
+        speed_changed = false;
+
+    }
+
+    // Le séquenceur fait progresser l'animation sans jamais bloquer la boucle.
+    sequencer.update();
+
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Animations du chenillard cadencées par une horloge matérielle (Timer1),
+ * insensibles à la charge de la boucle principale.
+ *
+ * La boucle principale se contente de préparer les images à l'avance, et
+ * affiche chaque seconde sur le moniteur série les statistiques de
+ * l'horloge : malgré ces affichages, le balayage ne saccade pas.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <PinLedBank.h>
+#include <AdafruitButton.h>
+#include <Sequencer.h>
+#include <Patterns.h>
+#include <FrameClock.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 8;
+
+/**
+ * @brief Broches de commande des LEDs.
+ */
+const uint8_t LED_PIN[] = { 5, 6, 7, 8, 9, 10, 11, 12 };
+
+/**
+ * @brief Période des tops de l'horloge d'affichage (exprimée en microsecondes).
+ */
+const uint16_t TICK_US = 10000;
+
+/**
+ * @brief Période d'affichage des statistiques (exprimée en millisecondes).
+ */
+const uint16_t REPORT_DELAY_MS = 1000;
+
+/**
+ * @brief Liste des motifs proposés, dans l'ordre où on les fait défiler.
+ */
+const Pattern * const PATTERNS[] PROGMEM = { &PING_PONG, &WRAP, &KNIGHT_RIDER, &BINARY_COUNTER };
+
+/**
+ * @brief Nombre de motifs proposés.
+ */
+const uint8_t NUM_PATTERNS = sizeof(PATTERNS) / sizeof(PATTERNS[0]);
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ */
+PinLedBank bank(LED_PIN, NUM_LEDS);
+
+/**
+ * @brief Instanciation du séquenceur.
+ *
+ * @note La période des tops du séquenceur n'est pas utilisée ici, puisque
+ *       c'est l'horloge d'affichage qui cadence l'animation.
+ */
+Sequencer sequencer(bank, TICK_US / 1000);
+
+/**
+ * @brief Instanciation de l'horloge d'affichage.
+ */
+FrameClock frame_clock(bank);
+
+/**
+ * @brief Instanciation du bouton poussoir.
+ */
+AdafruitButton button(2);
+
+/**
+ * @brief Indice du motif en cours.
+ */
+uint8_t pattern = 0;
+
+/**
+ * @brief Date du dernier affichage des statistiques.
+ */
+uint32_t last_report_ms = 0;
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // Rampe de LEDs et bouton.
+    PinSetup pins;
+
+    bank.configure(pins);
+    button.configure(pins);
+
+    pins.apply();
+
+    Serial.begin(9600);
+    while (!Serial);
+
+    sequencer.play((const Pattern *) pgm_read_ptr(&PATTERNS[pattern]));
+
+    // L'horloge n'est démarrée qu'une fois la liaison série initialisée,
+    // puisque le framework Arduino reconfigure les timers avant setup().
+    frame_clock.begin(TICK_US);
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Lecture de l'état du bouton : chaque appui passe au motif suivant.
+    button.read();
+
+    if (button.isPressed()) {
+        ++pattern %= NUM_PATTERNS;
+        sequencer.play((const Pattern *) pgm_read_ptr(&PATTERNS[pattern]));
+    }
+
+    // Préparation de l'image suivante, qui sera appliquée par l'horloge
+    // exactement à l'échéance de l'image affichée.
+    if (frame_clock.needsFrame()) {
+        uint8_t frame[1];
+        uint8_t duration = sequencer.next(frame);
+        frame_clock.queue(frame, duration);
+    }
+
+    // Affichage des statistiques : c'est justement le genre de traitement
+    // qui ferait saccader une animation cadencée par millis().
+    uint32_t now = millis();
+
+    if (now - last_report_ms >= REPORT_DELAY_MS) {
+
+        FrameClock::Stats stats = frame_clock.stats();
+
+        Serial.print(F("frames: "));
+        Serial.print(stats.frames);
+        Serial.print(F(" | missed: "));
+        Serial.print(stats.missed);
+        Serial.print(F(" | worst latency: "));
+        Serial.print(stats.worst_latency_us);
+        Serial.println(F(" us"));
+
+        last_report_ms = now;
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Balayage bidirectionnel d'un chenillard de 64 LEDs commandées par une
+ * chaîne de 8 registres à décalage 74HC595, contrôlé par un bouton.
+ *
+ * Au démarrage, le temps de mise à jour d'une image complète est mesuré
+ * et affiché sur le moniteur série.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <ShiftLedBank.h>
+#include <AdafruitButton.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 64;
+
+/**
+ * @brief Broche de verrouillage (RCLK) des registres à décalage.
+ */
+const uint8_t LATCH_PIN = 10;
+
+/**
+ * @brief Nombre de mises à jour effectuées pour mesurer le temps de transmission d'une image.
+ */
+const uint16_t BENCHMARK_RUNS = 1000;
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ *
+ * @note Les registres sont reliés aux broches D11 (MOSI) et D13 (SCK)
+ *       du périphérique SPI, et à la broche de verrouillage D10.
+ */
+ShiftLedBank leds(LATCH_PIN, NUM_LEDS);
+
+/**
+ * @brief Instanciation du bouton poussoir.
+ */
+AdafruitButton button(2);
+
+/**
+ * @brief Indice de la LED active sur le chenillard.
+ */
+uint8_t index = 0;
+
+/**
+ * @brief Sens de progression du balayage.
+ */
+int8_t direction = 1;
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // Broches du registre à décalage et bouton.
+    PinSetup pins;
+
+    leds.configure(pins);
+    button.configure(pins);
+
+    pins.apply();
+
+    Serial.begin(9600);
+    while (!Serial);
+
+    leds.begin();
+
+    // Mesure du temps de mise à jour d'une image complète.
+    uint32_t start_us = micros();
+    for (uint16_t i=0; i<BENCHMARK_RUNS; i++) leds.show();
+    uint32_t elapsed_us = micros() - start_us;
+
+    Serial.print(F("Full frame update ("));
+    Serial.print(NUM_LEDS);
+    Serial.print(F(" LEDs): "));
+    Serial.print(elapsed_us / (float) BENCHMARK_RUNS);
+    Serial.println(F(" us"));
+
+    // On allume la première LED du chenillard.
+    leds.light(index, true);
+    leds.show();
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Lecture de l'état du bouton.
+    button.read();
+
+    // À chaque fois qu'on vient d'enfoncer le bouton...
+    if (button.isPressed()) {
+
+        // On inverse la direction du balayage aux extrémités du chenillard.
+        if ((!index && direction < 0) || (index + 1 == NUM_LEDS && direction > 0)) direction *= -1;
+
+        // On éteint la LED active, on allume la suivante, et on transmet
+        // la nouvelle image d'un seul bloc.
+        leds.light(index, false);
+        leds.light(index += direction, true);
+        leds.show();
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Balayage bidirectionnel d'un chenillard de 20 LEDs commandées par
+ * seulement 5 broches (A0 à A4) grâce au charlieplexing, contrôlé par un
+ * bouton.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <CharlieLedBank.h>
+#include <AdafruitButton.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de broches de commande des LEDs.
+ */
+const uint8_t NUM_PINS = 5;
+
+/**
+ * @brief Nombre de LEDs : N x (N-1) avec N broches.
+ */
+const uint8_t NUM_LEDS = NUM_PINS * (NUM_PINS - 1);
+
+/**
+ * @brief Fréquence de rafraîchissement de la rampe (exprimée en hertz).
+ */
+const uint16_t REFRESH_HZ = 200;
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ *
+ * @note Les LEDs sont reliées aux broches A0 à A4, qui correspondent
+ *       aux 5 premiers bits du port C.
+ */
+CharlieLedBank<NUM_PINS> leds(DDRC, PORTC);
+
+/**
+ * @brief Instanciation du bouton poussoir.
+ */
+AdafruitButton button(2);
+
+/**
+ * @brief Image courante de la rampe (un bit par LED).
+ */
+uint8_t frame[(NUM_LEDS + 7) / 8];
+
+/**
+ * @brief Indice de la LED active sur le chenillard.
+ */
+uint8_t index = 0;
+
+/**
+ * @brief Sens de progression du balayage.
+ */
+int8_t direction = 1;
+
+/**
+ * @brief Routine d'interruption du Timer2 : affichage du slot suivant.
+ */
+ISR(TIMER2_COMPA_vect) {
+    leds.refresh();
+}
+
+/**
+ * @brief Allume la LED active, et elle seule.
+ */
+void show() {
+
+    memset(frame, 0, sizeof(frame));
+    frame[index >> 3] = 1 << (index & 0x7);
+    leds.write(frame);
+
+}
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // Seul le bouton : la banque charlieplexée pilote elle-même ses
+    // broches, à chaque rafraîchissement.
+    PinSetup pins;
+
+    button.configure(pins);
+
+    pins.apply();
+
+    show();
+    leds.begin(REFRESH_HZ);
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Lecture de l'état du bouton.
+    button.read();
+
+    // À chaque fois qu'on vient d'enfoncer le bouton...
+    if (button.isPressed()) {
+
+        // On inverse la direction du balayage aux extrémités du chenillard.
+        if ((!index && direction < 0) || (index + 1 == NUM_LEDS && direction > 0)) direction *= -1;
+
+        index += direction;
+        show();
+
+    }
+
+}
\ No newline at end of file
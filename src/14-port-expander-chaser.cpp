@@ -0,0 +1,169 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Balayage bidirectionnel d'un chenillard de 16 LEDs et lecture de deux
+ * boutons au travers de deux expandeurs de ports MCP23017 (bus I2C).
+ *
+ * Le nombre de transactions effectuées sur le bus est affiché chaque
+ * seconde sur le moniteur série.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <ExpanderLedBank.h>
+#include <ExpanderButtons.h>
+#include <KuhnButton.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 16;
+
+/**
+ * @brief Nombre de boutons.
+ */
+const uint8_t NUM_BUTTONS = 2;
+
+/**
+ * @brief Broche reliée à la sortie d'interruption INTA de l'expandeur des boutons.
+ */
+const uint8_t INT_PIN = 3;
+
+/**
+ * @brief Période d'affichage des statistiques (exprimée en millisecondes).
+ */
+const uint16_t REPORT_DELAY_MS = 1000;
+
+/**
+ * @brief Expandeur des LEDs (broches A0, A1 et A2 à la masse).
+ */
+Mcp23017 led_chip(0x20);
+
+/**
+ * @brief Expandeur des boutons (broche A0 à 5V, A1 et A2 à la masse).
+ */
+Mcp23017 button_chip(0x21);
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ */
+ExpanderLedBank leds(led_chip, NUM_LEDS);
+
+/**
+ * @brief Échantillonnage groupé des boutons.
+ */
+ExpanderButtons inputs(button_chip, INT_PIN);
+
+/**
+ * @brief Instanciation des boutons virtuels.
+ *
+ * @note Le bouton 0 (GPA0) fait progresser le chenillard, le bouton 1 (GPA1)
+ *       inverse le sens du balayage.
+ */
+KuhnButton button[NUM_BUTTONS];
+
+/**
+ * @brief Indice de la LED active sur le chenillard.
+ */
+uint8_t index = 0;
+
+/**
+ * @brief Sens de progression du balayage.
+ */
+int8_t direction = 1;
+
+/**
+ * @brief Nombre d'images transmises à la rampe.
+ */
+uint32_t frames = 0;
+
+/**
+ * @brief Date du dernier affichage des statistiques.
+ */
+uint32_t last_report_ms = 0;
+
+/**
+ * @brief Allume la LED active, et elle seule.
+ */
+void show() {
+
+    uint8_t frame[] = { 0, 0 };
+    frame[index >> 3] = 1 << (index & 0x7);
+    leds.write(frame);
+    frames++;
+
+}
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // Seule la broche d'interruption de l'expandeur des boutons : les LEDs
+    // et les boutons sont sur le bus I2C.
+    PinSetup pins;
+
+    inputs.configure(pins);
+
+    pins.apply();
+
+    Serial.begin(9600);
+    while (!Serial);
+
+    // Les deux expandeurs partagent le même bus : il suffirait d'initialiser
+    // le bus une seule fois, mais chacun doit recevoir sa configuration.
+    led_chip.begin();
+    button_chip.begin();
+
+    leds.begin();
+    inputs.begin(0x0003);
+
+    show();
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Échantillonnage des boutons, qui ne coûte une transaction
+    // que si l'expandeur a signalé un changement d'état.
+    inputs.sample();
+
+    for (uint8_t i=0; i<NUM_BUTTONS; i++) button[i].read(inputs.input(i));
+
+    if (button[1].isPressed()) direction *= -1;
+
+    if (button[0].isPressed()) {
+
+        // On inverse la direction du balayage aux extrémités du chenillard.
+        if ((!index && direction < 0) || (index + 1 == NUM_LEDS && direction > 0)) direction *= -1;
+
+        index += direction;
+        show();
+
+    }
+
+    uint32_t now = millis();
+
+    if (now - last_report_ms >= REPORT_DELAY_MS) {
+
+        Serial.print(F("frames: "));
+        Serial.print(frames);
+        Serial.print(F(" | LED transactions: "));
+        Serial.print(led_chip.transactions());
+        Serial.print(F(" | button transactions: "));
+        Serial.println(button_chip.transactions());
+
+        last_report_ms = now;
+
+    }
+
+}
\ No newline at end of file
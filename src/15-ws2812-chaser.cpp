@@ -0,0 +1,123 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Balayage bidirectionnel d'un ruban de 60 LEDs adressables WS2812
+ * contrôlé par un bouton.
+ *
+ * Les 8 LEDs reliées aux broches D5 à D12 sont remplacées par un ruban
+ * commandé par la seule broche D6.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <PixelStrip.h>
+#include <AdafruitButton.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de pixels du ruban.
+ */
+const uint8_t NUM_PIXELS = 60;
+
+/**
+ * @brief Broche de données du ruban.
+ */
+const uint8_t STRIP_PIN = 6;
+
+/**
+ * @brief Tampon d'image du ruban (3 octets par pixel).
+ */
+uint8_t pixels[NUM_PIXELS * 3];
+
+/**
+ * @brief Instanciation du ruban de LEDs.
+ */
+PixelStrip strip(STRIP_PIN, pixels, NUM_PIXELS);
+
+/**
+ * @brief Instanciation du bouton poussoir.
+ * 
+ * @note Le bouton est relié à la broche de lecture D2 de la carte Arduino.
+ */
+AdafruitButton button(2);
+
+/**
+ * @brief Indice du pixel actif sur le ruban.
+ */
+uint8_t index = 0;
+
+/**
+ * @brief Sens de progression du balayage.
+ */
+int8_t direction = 1;
+
+/**
+ * @brief Allume le pixel actif et sa traînée, qui s'estompe derrière lui.
+ */
+void draw() {
+
+    strip.clear();
+
+    uint8_t level = 0xff;
+    uint8_t i     = index;
+
+    for (uint8_t n=0; n<4 && i<NUM_PIXELS; n++, level >>= 2) {
+        strip.setPixel(i, level, level >> 3, 0);
+        i -= direction;
+    }
+
+}
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // Broche de données du ruban et bouton.
+    PinSetup pins;
+
+    strip.configure(pins);
+    button.configure(pins);
+
+    pins.apply();
+
+    Serial.begin(9600);
+    while (!Serial);
+
+    Serial.print(F("transmit time: "));
+    Serial.print(strip.transmitTimeUs());
+    Serial.println(F(" us/frame"));
+
+    draw();
+    strip.show();
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Lecture de l'état du bouton.
+    button.read();
+
+    if (button.isPressed()) {
+
+        if ((!index && direction < 0) || (index + 1 == NUM_PIXELS && direction > 0)) direction *= -1;
+
+        index += direction;
+        draw();
+
+    }
+
+    // La transmission bloque le programme pendant près de 2 ms. Elle n'a
+    // lieu que si l'image a changé, et le bouton est lu à nouveau dès
+    // qu'elle se termine pour ne pas retarder la détection du relâchement.
+    if (strip.show()) button.read();
+
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Balayage du chenillard à LEDs contrôlé par un clavier de 5 boutons
+ * montés sur une échelle de résistances, et lus sur la seule entrée A0.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <Led.h>
+#include <AnalogKeypad.h>
+#include <KuhnButton.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 8;
+
+/**
+ * @brief Nombre de boutons du clavier.
+ */
+const uint8_t NUM_KEYS = 5;
+
+/**
+ * @brief Bornes supérieures des bandes de tension de chaque bouton.
+ *
+ * @note Échelle de résistances alimentée en 5V au travers d'une résistance
+ *       de tirage de 2 kΩ. Mesures nominales (sur 10 bits) :
+ *
+ *           bouton 0 :    0 (0 Ω)
+ *           bouton 1 :  145 (330 Ω)
+ *           bouton 2 :  329 (330 + 620 Ω)
+ *           bouton 3 :  505 (330 + 620 + 1 kΩ)
+ *           bouton 4 :  741 (330 + 620 + 1 kΩ + 3,3 kΩ)
+ *           aucun    : 1023
+ *
+ *       Chaque borne est placée à mi-chemin entre deux mesures voisines.
+ */
+const uint16_t KEY_LIMITS[NUM_KEYS] = { 72, 237, 417, 623, 882 };
+
+/**
+ * @brief Période de balayage automatique (exprimée en millisecondes).
+ */
+const uint16_t AUTO_DELAY_MS = 100;
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ *
+ * @note Les LEDs sont respectivement reliées aux broches de commande
+ *       D5, D6, D7, D8, D9, D10, D11 et D12.
+ */
+Led led[] = { Led(5), Led(6), Led(7), Led(8), Led(9), Led(10), Led(11), Led(12) };
+
+/**
+ * @brief Instanciation du clavier analogique, relié à l'entrée A0.
+ */
+AnalogKeypad keypad(0, KEY_LIMITS, NUM_KEYS);
+
+/**
+ * @brief Instanciation des boutons virtuels du clavier.
+ *
+ * @note Bouton 0 : fait progresser le chenillard.
+ *       Bouton 1 : inverse le sens du balayage.
+ *       Bouton 2 : revient à la première LED.
+ *       Bouton 3 : passe à la dernière LED.
+ *       Bouton 4 : maintenu enfoncé 1 seconde, active ou désactive le balayage automatique.
+ */
+KuhnButton button[NUM_KEYS];
+
+/**
+ * @brief Indice de la LED active sur le chenillard.
+ */
+uint8_t index = 0;
+
+/**
+ * @brief Sens de progression du balayage.
+ */
+int8_t direction = 1;
+
+/**
+ * @brief Indique si le balayage automatique est actif.
+ */
+bool auto_scan = false;
+
+/**
+ * @brief Indique si le balayage automatique vient d'être basculé.
+ *
+ * @note Permet de ne basculer qu'une seule fois tant que le bouton 4 reste enfoncé.
+ */
+bool auto_toggled = false;
+
+/**
+ * @brief Date du dernier pas de balayage automatique.
+ */
+uint32_t last_step_ms = 0;
+
+/**
+ * @brief Déplace la LED active.
+ *
+ * @param next Indice de la prochaine LED à activer.
+ */
+void moveTo(const uint8_t next) {
+
+    led[index].light(false);
+    led[index = next].light(true);
+
+}
+
+/**
+ * @brief Fait progresser le chenillard d'une LED dans le sens du balayage.
+ */
+void step() {
+
+    if ((!index && direction < 0) || (index + 1 == NUM_LEDS && direction > 0)) direction *= -1;
+
+    moveTo(index + direction);
+
+}
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // LEDs seulement : le clavier est lu par le convertisseur analogique.
+    PinSetup pins;
+
+    for (uint8_t i=0; i<NUM_LEDS; i++) led[i].configure(pins);
+
+    pins.apply();
+
+    keypad.begin();
+    led[index].light(true);
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Le bouton enfoncé est décodé une seule fois, puis chaque bouton
+    // virtuel reçoit son propre signal d'entrée.
+    uint8_t key = keypad.key();
+
+    for (uint8_t k=0; k<NUM_KEYS; k++) button[k].read(key == k);
+
+    if (button[0].isPressed()) step();
+    if (button[1].isPressed()) direction *= -1;
+    if (button[2].isPressed()) moveTo(0);
+    if (button[3].isPressed()) moveTo(NUM_LEDS - 1);
+
+    if (button[4].wasHeldFor(1000) && !auto_toggled) {
+        auto_scan    = !auto_scan;
+        auto_toggled = true;
+    } else if (button[4].isReleased()) {
+        auto_toggled = false;
+    }
+
+    uint32_t now = millis();
+
+    if (auto_scan && now - last_step_ms >= AUTO_DELAY_MS) {
+        step();
+        last_step_ms = now;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Contrôle du chenillard à LEDs par un clavier matriciel de 16 touches
+ * (4 lignes x 4 colonnes) balayé par le Timer2.
+ *
+ * Les appuis et les relâchements sont affichés sur le moniteur série.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <Led.h>
+#include <KeyMatrix.h>
+#include <KuhnButton.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 8;
+
+/**
+ * @brief Nombre de lignes du clavier.
+ */
+const uint8_t NUM_ROWS = 4;
+
+/**
+ * @brief Nombre de colonnes du clavier.
+ */
+const uint8_t NUM_COLS = 4;
+
+/**
+ * @brief Broches des lignes du clavier (A0 à A3).
+ */
+const uint8_t ROW_PINS[NUM_ROWS] = { A0, A1, A2, A3 };
+
+/**
+ * @brief Broches des colonnes du clavier (A4, A5, D2 et D3).
+ */
+const uint8_t COL_PINS[NUM_COLS] = { A4, A5, 2, 3 };
+
+/**
+ * @brief Période de balayage d'une ligne (exprimée en microsecondes).
+ *
+ * @note Chaque touche est échantillonnée toutes les 4 x 500 µs = 2 ms :
+ *       avec le seuil de 16 de KuhnButton, un appui est validé en 32 ms.
+ */
+const uint16_t TICK_US = 500;
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ *
+ * @note Les LEDs sont respectivement reliées aux broches de commande
+ *       D5, D6, D7, D8, D9, D10, D11 et D12.
+ */
+Led led[] = { Led(5), Led(6), Led(7), Led(8), Led(9), Led(10), Led(11), Led(12) };
+
+/**
+ * @brief Instanciation du clavier matriciel.
+ *
+ * @note Touches 0 à 7 : activent la LED correspondante.
+ *       Touche 8      : fait progresser le chenillard.
+ *       Touche 9      : inverse le sens du balayage.
+ */
+KeyMatrix<NUM_ROWS, NUM_COLS, KuhnButton> keypad(ROW_PINS, COL_PINS);
+
+/**
+ * @brief Routine d'interruption du Timer2 : balayage d'une ligne du clavier.
+ */
+ISR(TIMER2_COMPA_vect) {
+    keypad.scan();
+}
+
+/**
+ * @brief Indice de la LED active sur le chenillard.
+ */
+uint8_t index = 0;
+
+/**
+ * @brief Sens de progression du balayage.
+ */
+int8_t direction = 1;
+
+/**
+ * @brief Indique si des touches fantômes étaient signalées lors du dernier balayage.
+ */
+bool ghosting = false;
+
+/**
+ * @brief Déplace la LED active.
+ *
+ * @param next Indice de la prochaine LED à activer.
+ */
+void moveTo(const uint8_t next) {
+
+    led[index].light(false);
+    led[index = next].light(true);
+
+}
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // LEDs, lignes et colonnes du clavier.
+    PinSetup pins;
+
+    for (uint8_t i=0; i<NUM_LEDS; i++) led[i].configure(pins);
+    keypad.configure(pins);
+
+    pins.apply();
+
+    Serial.begin(9600);
+    while (!Serial);
+
+    keypad.begin(TICK_US);
+    led[index].light(true);
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    if (!keypad.update()) return;
+
+    if (keypad.isGhosting() != ghosting) {
+        ghosting = !ghosting;
+        Serial.println(ghosting ? F("ghost keys: scan ignored") : F("ghost keys cleared"));
+    }
+
+    KeyMatrix<NUM_ROWS, NUM_COLS, KuhnButton>::Event event;
+
+    while (keypad.nextEvent(event)) {
+
+        Serial.print(F("key "));
+        Serial.print(event.key);
+        Serial.println(event.pressed ? F(" pressed") : F(" released"));
+
+        if (!event.pressed) continue;
+
+        if (event.key < NUM_LEDS) {
+
+            moveTo(event.key);
+
+        } else if (event.key == 8) {
+
+            if ((!index && direction < 0) || (index + 1 == NUM_LEDS && direction > 0)) direction *= -1;
+            moveTo(index + direction);
+
+        } else if (event.key == 9) {
+
+            direction *= -1;
+
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Mise en évidence de l'effet rebond par un décompte matériel des
+ * transitions logiques du bouton, effectué par le Timer1
+ *
+ * Le bouton est relié à la broche D5 (entrée d'horloge externe T1 du
+ * Timer1), à la place de la broche D2. La LED qui occupait la broche D5
+ * est déplacée sur la broche D4.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <EdgeCounter.h>
+#include <BounceWindow.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 8;
+
+/**
+ * @brief Broches de commande des LEDs.
+ */
+const uint8_t LED_PIN[] = { 4, 6, 7, 8, 9, 10, 11, 12 };
+
+/**
+ * Fenêtre de comptage exprimée en millisecondes.
+ */
+const uint16_t COUNT_DELAY_MS = 200;
+
+/**
+ * @brief Compteur matériel des transitions du bouton.
+ */
+EdgeCounter counter;
+
+/**
+ * @brief Fenêtre de comptage.
+ */
+BounceWindow window(COUNT_DELAY_MS);
+
+/**
+ * @brief Nombre de passages à l'état `HIGH`
+ */
+uint8_t up = 0;
+
+/**
+ * @brief Nombre de passages à l'état `LOW`
+ */
+uint8_t down = 0;
+
+/**
+ * @brief Affichage d'un entier sous sa forme binaire sur la rampe de LEDs.
+ * 
+ * @param n entier compris dans l'intervalle [0,255] (codé sur 8 bits).
+ */
+void ledWrite(const uint8_t n) {
+
+    for (uint8_t i=0; i<NUM_LEDS; i++) {
+        digitalWrite(LED_PIN[i], (n >> i) & 0x1);
+    }
+
+}
+
+/**
+ * @brief Affichage du décompte des transitions logiques enregistrées.
+ * 
+ * @note Les passages à l'état `HIGH` sont affichés à gauche, les passages
+ *       à l'état `LOW` à droite (voir 04-bouncing-highlighting-v3.cpp).
+ */
+void showCount() {
+
+    // Activation des bits "allumés" à gauche.
+    uint8_t n = 255 - ((1 << (8 - up)) - 1);
+
+    // Activation des bits "allumés" à droite.
+    n |= (1 << down) - 1;
+
+    // Affichage du nombre binaire obtenu par composition.
+    ledWrite(n);
+
+}
+
+/**
+ * @brief Démarrage du programme.
+ */
+void setup() {
+
+    Serial.begin(9600);
+    while (!Serial);
+
+    // Configuration des broches de commande des LEDs.
+    for (uint8_t i=0; i<NUM_LEDS; i++) {
+        pinMode(LED_PIN[i], OUTPUT);
+    }
+
+    counter.begin();
+    window.reset(millis(), counter.snapshot());
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ * 
+ * @note Les transitions sont dénombrées par le Timer1 : la boucle principale
+ *       se contente de relever le compteur, sans jamais en manquer aucune,
+ *       quelle que soit sa propre durée d'exécution.
+ */
+void loop() {
+
+    if (!window.update(millis(), counter.snapshot())) return;
+
+    // La rampe ne peut afficher que 4 transitions de chaque sorte : les
+    // décomptes sont donc limités pour l'affichage, mais transmis en entier
+    // sur le moniteur série.
+    up   = window.up()   < 4 ? window.up()   : 4;
+    down = window.down() < 4 ? window.down() : 4;
+
+    showCount();
+
+    Serial.print(F("up: "));
+    Serial.print(window.up());
+    Serial.print(F(" | down: "));
+    Serial.println(window.down());
+
+}
\ No newline at end of file
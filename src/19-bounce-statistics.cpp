@@ -0,0 +1,159 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Caractérisation statistique des rebonds du bouton, sur des milliers
+ * d'appuis, sans restitution des échantillons bruts.
+ *
+ * Les statistiques, et le délai de debouncing qui s'en déduit, sont
+ * sauvegardées en EEPROM et restaurées au démarrage.
+ *
+ * Commandes du moniteur série :
+ *   s : affichage du résumé des statistiques,
+ *   r : remise à zéro des statistiques.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <BounceStats.h>
+#include <AvrEeprom.h>
+#include <RecordLog.h>
+
+/**
+ * @brief Broche de lecture de l'état du bouton.
+ */
+const uint8_t BTN_PIN = 2;
+
+/**
+ * @brief Durée de stabilité qui referme une salve de rebonds (exprimée en microsecondes).
+ */
+const uint32_t QUIET_US = 20000;
+
+/**
+ * @brief Délai minimal entre deux sauvegardes en EEPROM (exprimé en millisecondes).
+ */
+const uint32_t SAVE_INTERVAL_MS = 60000;
+
+/**
+ * @brief Enregistrement sauvegardé en EEPROM pour le bouton.
+ */
+struct Record {
+    BounceStats::Profile stats;       // Résumé des statistiques.
+    uint16_t             debounce_us; // Délai de debouncing déduit des statistiques.
+};
+
+/**
+ * @brief Statistiques des rebonds du bouton.
+ */
+BounceStats stats(QUIET_US);
+
+/**
+ * @brief EEPROM interne du microcontrôleur.
+ */
+AvrEeprom eeprom;
+
+/**
+ * @brief Journal des enregistrements, sur toute l'EEPROM.
+ */
+RecordLog<Record, AvrEeprom> records(eeprom, 0, eeprom.size(), SAVE_INTERVAL_MS);
+
+/**
+ * @brief Enregistrement courant.
+ */
+Record record;
+
+/**
+ * @brief Délai de debouncing déduit des statistiques (exprimé en microsecondes).
+ *
+ * @note Il couvre la durée de stabilisation moyenne augmentée de trois
+ *       écarts-types, pour les appuis comme pour les relâchements.
+ */
+uint16_t debounceUs() {
+
+    const BounceStats::Metrics *metrics[] = { &stats.press(), &stats.release() };
+
+    float delay_us = 0;
+
+    for (uint8_t i=0; i<2; i++) {
+
+        const RunningStat &settle = metrics[i]->settle_us;
+        float d = settle.mean() + 3 * settle.stddev();
+        if (d > delay_us) delay_us = d;
+
+    }
+
+    return delay_us < 65535 ? (uint16_t) (delay_us + 0.5) : 65535;
+
+}
+
+/**
+ * @brief Démarrage du programme.
+ */
+void setup() {
+
+    // Configuration de la broche de lecture du bouton.
+    pinMode(BTN_PIN, INPUT);
+
+    // Initialisation du moniteur série.
+    Serial.begin(9600);
+    while (!Serial);
+    Serial.println(F("\n\nBounce statistics: press 's' for a summary, 'r' to reset"));
+
+    // Restauration des statistiques sauvegardées lors du fonctionnement précédent.
+    if (records.load(record)) {
+
+        stats.restore(record.stats);
+
+        Serial.print(F("profile #"));
+        Serial.print(records.sequence());
+        Serial.print(F(" restored: debounce="));
+        Serial.print(record.debounce_us);
+        Serial.println(F(" us"));
+
+    }
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    // Le signal brut est échantillonné à chaque itération : la boucle
+    // doit rester aussi courte que possible.
+    // À chaque salve refermée, une sauvegarde est demandée : elle n'aura
+    // lieu qu'une fois par minute au plus, quel que soit le nombre d'appuis.
+    if (stats.sample(micros(), digitalRead(BTN_PIN))) {
+
+        record.stats       = stats.profile();
+        record.debounce_us = debounceUs();
+
+        records.save(record);
+
+    }
+
+    // La sauvegarde progresse d'un octet au plus, sans jamais attendre l'EEPROM.
+    records.update(millis());
+
+    if (Serial.available()) {
+
+        switch (Serial.read()) {
+            case 's':
+                stats.report(Serial);
+                Serial.print(F("debounce="));
+                Serial.print(debounceUs());
+                Serial.println(F(" us"));
+                break;
+            case 'r':
+                stats.reset();
+                Serial.println(F("reset"));
+                break;
+        }
+
+    }
+
+}
\ No newline at end of file
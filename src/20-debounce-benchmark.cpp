@@ -0,0 +1,345 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Banc d'essai des méthodes de debouncing sur des signaux synthétiques.
+ *
+ * Chaque signal est décrit par une suite de paliers (alternativement LOW
+ * et HIGH) et transmis, échantillon par échantillon, à des boutons
+ * virtuels. Le retard de l'appui et du relâchement est mesuré en nombre
+ * d'échantillons, en comptant celui qui porte le front.
+ *
+ * Un second tableau indique, pour chaque méthode, la mémoire vive occupée
+ * par un bouton et le nombre de cycles d'horloge consommés par une lecture.
+ * La taille du code de chaque méthode se lit dans la table des symboles
+ * du firmware (avr-nm --size-sort -C, symboles `_debounce`).
+ *
+ * Un dernier tableau soumet chaque méthode à des rafales d'appuis francs,
+ * de plus en plus rapides. Le programme ne relève le compteur d'appuis
+ * (takePresses()) que toutes les 10 ms, comme le ferait une boucle
+ * principale chargée : aucun appui ne doit être perdu tant que la cadence
+ * reste sous la cadence maximale de la méthode.
+ *
+ * Les résultats sont affichés sur le moniteur série.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <KuhnButton.h>
+#include <AdafruitButton.h>
+#include <LeadingEdgeButton.h>
+#include <ShiftRegisterButton.h>
+#include <IirButton.h>
+#include <MajorityButton.h>
+
+/**
+ * @brief Période d'échantillonnage (exprimée en microsecondes).
+ *
+ * @note AdafruitButton mesure la stabilité du signal avec millis() : les
+ *       échantillons doivent donc être espacés dans le temps réel.
+ */
+const uint16_t SAMPLE_US = 100;
+
+/**
+ * @brief Nombre de lectures effectuées pour mesurer le coût d'une lecture.
+ */
+const uint16_t TIMING_READS = 1000;
+
+/**
+ * @brief Cadences des rafales d'appuis (exprimées en appuis par seconde).
+ */
+const uint16_t TAP_RATES[] = { 100, 200, 300, 500 };
+
+/**
+ * @brief Nombre de cadences éprouvées.
+ */
+const uint8_t NUM_TAP_RATES = sizeof(TAP_RATES) / sizeof(uint16_t);
+
+/**
+ * @brief Nombre d'appuis de chaque rafale.
+ */
+const uint8_t TAPS = 100;
+
+/**
+ * @brief Période de relevé du compteur d'appuis (exprimée en échantillons).
+ */
+const uint8_t CONSUMER_SAMPLES = 100;
+
+/**
+ * @brief Durée du repos qui encadre chaque rafale (exprimée en échantillons).
+ */
+const uint16_t MAX_BURST_IDLE = 300;
+
+/**
+ * @brief Nombre maximal de paliers d'un signal.
+ */
+const uint8_t MAX_RUNS = 16;
+
+/**
+ * @brief Description d'un signal synthétique.
+ */
+struct Waveform {
+    const char *name;        // Nom du signal.
+    int16_t     press_at;    // Échantillon du premier front d'appui (-1 si aucun).
+    int16_t     release_at;  // Échantillon du premier front de relâchement (-1 si aucun).
+    uint8_t     noise;       // Probabilité d'inversion de chaque échantillon (sur 256).
+    uint16_t    runs[MAX_RUNS]; // Durée des paliers LOW, HIGH, LOW... (0 termine la suite).
+};
+
+/**
+ * @brief Signaux synthétiques.
+ *
+ * @note Chaque signal commence et se termine par un long palier au repos,
+ *       de sorte que tous les boutons partent du même état.
+ *
+ *       Le signal "noisy" inverse aléatoirement 5 % des échantillons : il
+ *       mesure l'immunité au bruit (tout appui au-delà du premier est un
+ *       faux appui). Le générateur pseudo-aléatoire est réinitialisé pour
+ *       chaque bouton, qui reçoivent donc exactement le même signal.
+ */
+const Waveform WAVEFORMS[] = {
+    { "clean",   50, 350,  0, { 50, 300, 300 } },
+    { "bouncy",  50, 360,  0, { 50, 1, 2, 1, 3, 2, 1, 300, 1, 1, 2, 1, 300 } },
+    { "spike",   -1,  -1,  0, { 50, 1, 300 } },
+    { "dropout", 50, 651,  0, { 50, 300, 1, 300, 300 } },
+    { "noisy",   50, 350, 13, { 50, 300, 300 } }
+};
+
+/**
+ * @brief Nombre de signaux synthétiques.
+ */
+const uint8_t NUM_WAVEFORMS = sizeof(WAVEFORMS) / sizeof(Waveform);
+
+/**
+ * @brief Boutons virtuels comparés.
+ */
+KuhnButton     kuhn;
+AdafruitButton adafruit;
+LeadingEdgeButton<> leading;
+LeadingEdgeButton<EdgePolicy::leading, 16, EdgePolicy::leading, 16, true> filtered;
+LeadingEdgeButton<EdgePolicy::leading, 16, EdgePolicy::trailing, 16> asymmetric;
+ShiftRegisterButton<8> shift;
+IirButton<>            iir;
+MajorityButton<5>      majority;
+
+/**
+ * @brief Table des boutons comparés.
+ */
+Button * const BUTTONS[] = { &kuhn, &adafruit, &leading, &filtered, &asymmetric, &shift, &iir, &majority };
+
+/**
+ * @brief Noms des boutons comparés.
+ */
+const char * const NAMES[] = { "kuhn", "adafruit", "leading", "leading+filter", "lead/trail", "shift<8>", "iir<3>", "majority<5>" };
+
+/**
+ * @brief Mémoire vive occupée par chaque bouton (exprimée en octets).
+ */
+const uint8_t SIZES[] = {
+    sizeof(kuhn), sizeof(adafruit), sizeof(leading), sizeof(filtered),
+    sizeof(asymmetric), sizeof(shift), sizeof(iir), sizeof(majority)
+};
+
+/**
+ * @brief Nombre de boutons comparés.
+ */
+const uint8_t NUM_BUTTONS = sizeof(BUTTONS) / sizeof(Button *);
+
+/**
+ * @brief Résultat d'un essai.
+ */
+struct Result {
+    int16_t press_latency;    // Retard de l'appui (-1 si aucun appui).
+    int16_t release_latency;  // Retard du relâchement (-1 si aucun relâchement).
+    uint8_t presses;          // Nombre d'appuis détectés.
+};
+
+/**
+ * @brief Implémentation d'une fonction de remplacement de Serial.printf().
+ *
+ * @see 05-kuhn-debouncing-algorithm-analysis.cpp
+ */
+void printf(const __FlashStringHelper *format, ...) {
+
+    char    buffer[64];
+    va_list args;
+
+    va_start (args, format);
+    vsnprintf_P(buffer, sizeof(buffer), (const char *)format, args);
+    va_end(args);
+
+    Serial.print(buffer);
+
+}
+
+/**
+ * @brief Transmission d'un signal synthétique à un bouton.
+ *
+ * @param button   Bouton à éprouver.
+ * @param waveform Signal transmis.
+ */
+Result run(Button &button, const Waveform &waveform) {
+
+    Result   result = { -1, -1, 0 };
+    uint16_t sample = 0;
+    uint8_t  level  = LOW;
+    uint16_t random = 0xace1;
+
+    for (uint8_t r=0; r<MAX_RUNS && waveform.runs[r]; r++, level = !level) {
+
+        for (uint16_t i=0; i<waveform.runs[r]; i++, sample++) {
+
+            uint8_t input = level;
+
+            // Générateur pseudo-aléatoire xorshift sur 16 bits.
+            if (waveform.noise) {
+                random ^= random << 7;
+                random ^= random >> 9;
+                random ^= random << 8;
+                if ((uint8_t) random < waveform.noise) input = !input;
+            }
+
+            button.read(input);
+
+            if (button.isPressed()) {
+                if (!result.presses && waveform.press_at >= 0) result.press_latency = sample - waveform.press_at + 1;
+                result.presses++;
+            }
+
+            if (button.isReleased() && waveform.release_at >= 0 && sample >= waveform.release_at && result.release_latency < 0) {
+                result.release_latency = sample - waveform.release_at + 1;
+            }
+
+            delayMicroseconds(SAMPLE_US);
+
+        }
+
+    }
+
+    return result;
+
+}
+
+/**
+ * @brief Transmission d'une rafale d'appuis francs à un bouton.
+ *
+ * @param button Bouton à éprouver.
+ * @param rate   Cadence des appuis (exprimée en appuis par seconde).
+ *
+ * @return Le nombre d'appuis relevés par le programme.
+ */
+uint16_t tap(Button &button, const uint16_t rate) {
+
+    uint16_t half    = 500000UL / ((uint32_t) rate * SAMPLE_US);
+    uint16_t samples = 2 * TAPS * half + 2 * MAX_BURST_IDLE;
+    uint16_t presses = 0;
+
+    button.takePresses();
+
+    for (uint16_t i=0; i<samples; i++) {
+
+        // Repos, rafale, puis retour au repos.
+        uint16_t t = i - MAX_BURST_IDLE;
+        uint8_t  input = i >= MAX_BURST_IDLE && t < 2 * TAPS * half && (t / half) & 0x1;
+
+        button.read(input);
+
+        if (!((i + 1) % CONSUMER_SAMPLES)) presses += button.takePresses();
+
+        delayMicroseconds(SAMPLE_US);
+
+    }
+
+    return presses + button.takePresses();
+
+}
+
+/**
+ * @brief Mesure du coût d'une lecture (exprimé en cycles d'horloge).
+ *
+ * @param button Bouton à éprouver.
+ *
+ * @note Le coût mesuré comprend l'appel de read() et l'interprétation de
+ *       l'état du bouton par la classe Button, communs à toutes les méthodes.
+ */
+uint16_t cyclesPerRead(Button &button) {
+
+    uint32_t start = micros();
+
+    for (uint16_t i=0; i<TIMING_READS; i++) button.read((i >> 5) & 0x1);
+
+    uint32_t elapsed_us = micros() - start;
+
+    return elapsed_us * (F_CPU / 1000000UL) / TIMING_READS;
+
+}
+
+/**
+ * @brief Démarrage du programme principal : exécution du banc d'essai.
+ */
+void setup() {
+
+    Serial.begin(9600);
+    while (!Serial);
+
+    printf(F("\n\nsample period: %u us\n\n"), SAMPLE_US);
+    Serial.println(F("waveform | debouncer      | press | release | presses"));
+    Serial.println(F("---------+----------------+-------+---------+--------"));
+
+    for (uint8_t w=0; w<NUM_WAVEFORMS; w++) {
+
+        for (uint8_t b=0; b<NUM_BUTTONS; b++) {
+
+            Result result = run(*BUTTONS[b], WAVEFORMS[w]);
+
+            printf(F("%-8s | %-14s | %5d | %7d | %u\n"),
+                WAVEFORMS[w].name,
+                NAMES[b],
+                result.press_latency,
+                result.release_latency,
+                result.presses);
+
+        }
+
+    }
+
+    Serial.println();
+    Serial.println(F("debouncer      | RAM | cycles/read"));
+    Serial.println(F("---------------+-----+------------"));
+
+    for (uint8_t b=0; b<NUM_BUTTONS; b++) {
+
+        printf(F("%-14s | %3u | %u\n"),
+            NAMES[b],
+            SIZES[b],
+            cyclesPerRead(*BUTTONS[b]));
+
+    }
+
+    Serial.println();
+    printf(F("debouncer      | %u taps at (taps/s)\n"), TAPS);
+    Serial.print(F("              "));
+    for (uint8_t r=0; r<NUM_TAP_RATES; r++) printf(F(" | %4u"), TAP_RATES[r]);
+    Serial.println();
+    Serial.print(F("--------------"));
+    for (uint8_t r=0; r<NUM_TAP_RATES; r++) Serial.print(F("-+-----"));
+    Serial.println();
+
+    for (uint8_t b=0; b<NUM_BUTTONS; b++) {
+
+        printf(F("%-14s"), NAMES[b]);
+        for (uint8_t r=0; r<NUM_TAP_RATES; r++) printf(F(" | %4u"), tap(*BUTTONS[b], TAP_RATES[r]));
+        Serial.println();
+
+    }
+
+}
+
+/**
+ * @brief Boucle de contrôle principale : il n'y a plus rien à faire.
+ */
+void loop() {}
\ No newline at end of file
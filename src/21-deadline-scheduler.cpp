@@ -0,0 +1,184 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Gestion des appuis prolongés de quatre boutons par un ordonnanceur
+ * d'échéances.
+ *
+ * Chaque bouton commande deux LEDs : la première s'allume lorsque le
+ * bouton est maintenu enfoncé, la seconde clignote de plus en plus vite
+ * si l'appui se prolonge encore. Les deux LEDs s'éteignent un peu après
+ * le relâchement du bouton.
+ *
+ * Au lieu de comparer la durée de chaque appui à chaque seuil, à chaque
+ * itération de la boucle principale, les échéances sont programmées lors
+ * des changements d'état des boutons : la boucle ne traite que celles qui
+ * sont arrivées.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <Led.h>
+#include <KuhnButton.h>
+#include <PinSetup.h>
+#include <DeadlineQueue.h>
+
+/**
+ * @brief Nombre de boutons.
+ */
+const uint8_t NUM_BUTTONS = 4;
+
+/**
+ * @brief Échéances associées à chaque bouton.
+ */
+enum Deadline : uint8_t { hold, repeat, settle, NUM_DEADLINES };
+
+/**
+ * @brief Durée d'appui qui allume la première LED (exprimée en millisecondes).
+ */
+const uint16_t HOLD_DELAY_MS = 500;
+
+/**
+ * @brief Durée d'appui qui déclenche le clignotement (exprimée en millisecondes).
+ */
+const uint16_t REPEAT_DELAY_MS = 1000;
+
+/**
+ * @brief Demi-période initiale du clignotement (exprimée en millisecondes).
+ */
+const uint16_t REPEAT_START_MS = 200;
+
+/**
+ * @brief Demi-période minimale du clignotement (exprimée en millisecondes).
+ */
+const uint16_t REPEAT_MIN_MS = 25;
+
+/**
+ * @brief Délai d'extinction des LEDs après le relâchement (exprimé en millisecondes).
+ */
+const uint16_t SETTLE_DELAY_MS = 300;
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ *
+ * @note Les LEDs 2k et 2k+1 sont commandées par le bouton k.
+ */
+Led led[] = { Led(5), Led(6), Led(7), Led(8), Led(9), Led(10), Led(11), Led(12) };
+
+/**
+ * @brief Instanciation des boutons, reliés aux broches A0, A1, A2 et A3.
+ */
+KuhnButton button[] = { KuhnButton(A0), KuhnButton(A1), KuhnButton(A2), KuhnButton(A3) };
+
+/**
+ * @brief Échéances programmées (l'échéance d du bouton b porte l'identifiant b x 3 + d).
+ */
+DeadlineQueue<NUM_BUTTONS * NUM_DEADLINES> deadlines;
+
+/**
+ * @brief Demi-période courante du clignotement de chaque bouton.
+ */
+uint16_t repeat_ms[NUM_BUTTONS];
+
+/**
+ * @brief Identifiant d'une échéance.
+ *
+ * @param b        Indice du bouton.
+ * @param deadline Échéance du bouton.
+ */
+uint8_t deadlineId(const uint8_t b, const Deadline deadline) {
+    return b * NUM_DEADLINES + deadline;
+}
+
+/**
+ * @brief Traitement d'une échéance arrivée.
+ *
+ * @param id     Identifiant de l'échéance.
+ * @param now_ms Date courante (exprimée en millisecondes).
+ */
+void expire(const uint8_t id, const uint32_t now_ms) {
+
+    uint8_t b = id / NUM_DEADLINES;
+
+    switch (id % NUM_DEADLINES) {
+
+        case Deadline::hold:
+            led[2 * b].light(true);
+            break;
+
+        case Deadline::repeat:
+
+            // Le clignotement s'accélère à chaque demi-période.
+            led[2 * b + 1].toggle();
+            deadlines.schedule(id, now_ms + repeat_ms[b]);
+            repeat_ms[b] -= repeat_ms[b] >> 3;
+            if (repeat_ms[b] < REPEAT_MIN_MS) repeat_ms[b] = REPEAT_MIN_MS;
+            break;
+
+        case Deadline::settle:
+            led[2 * b].light(false);
+            led[2 * b + 1].light(false);
+            break;
+
+    }
+
+}
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // Deux LEDs par bouton.
+    PinSetup pins;
+
+    for (uint8_t b=0; b<NUM_BUTTONS; b++) {
+        led[2 * b].configure(pins);
+        led[2 * b + 1].configure(pins);
+        button[b].configure(pins);
+    }
+
+    pins.apply();
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    uint32_t now = millis();
+
+    for (uint8_t b=0; b<NUM_BUTTONS; b++) {
+
+        button[b].read();
+
+        if (button[b].isPressed()) {
+
+            repeat_ms[b] = REPEAT_START_MS;
+
+            deadlines.cancel(deadlineId(b, Deadline::settle));
+            deadlines.schedule(deadlineId(b, Deadline::hold), now + HOLD_DELAY_MS);
+            deadlines.schedule(deadlineId(b, Deadline::repeat), now + REPEAT_DELAY_MS);
+
+        } else if (button[b].isReleased()) {
+
+            deadlines.cancel(deadlineId(b, Deadline::hold));
+            deadlines.cancel(deadlineId(b, Deadline::repeat));
+            deadlines.schedule(deadlineId(b, Deadline::settle), now + SETTLE_DELAY_MS);
+
+        }
+
+    }
+
+    // Seules les échéances arrivées sont traitées : tant qu'aucune ne l'est,
+    // il en coûte une seule comparaison.
+    uint8_t id;
+
+    while (deadlines.expired(now, id)) expire(id, now);
+
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Chenillard à basse consommation : le microcontrôleur dort entre deux
+ * sollicitations du bouton.
+ *
+ * Chaque appui fait progresser le chenillard. Sans appui pendant 10 s, le
+ * chenillard s'éteint ; l'appui suivant le rallume. Un appui prolongé
+ * pendant 2 s affiche sur le moniteur série le temps passé dans chaque
+ * état d'alimentation.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <Led.h>
+#include <KuhnButton.h>
+#include <DeadlineQueue.h>
+#include <PowerManager.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Nombre de LEDs.
+ */
+const uint8_t NUM_LEDS = 8;
+
+/**
+ * @brief Broche de lecture du bouton.
+ */
+const uint8_t BUTTON_PIN = 2;
+
+/**
+ * @brief Délai d'extinction du chenillard (exprimé en millisecondes).
+ */
+const uint16_t OFF_DELAY_MS = 10000;
+
+/**
+ * @brief Durée d'appui qui déclenche l'affichage des statistiques (exprimée en millisecondes).
+ */
+const uint16_t REPORT_DELAY_MS = 2000;
+
+/**
+ * @brief Identifiant de l'échéance d'extinction.
+ */
+const uint8_t OFF_DEADLINE = 0;
+
+/**
+ * @brief Instanciation de la rampe de LEDs.
+ */
+Led led[] = { Led(5), Led(6), Led(7), Led(8), Led(9), Led(10), Led(11), Led(12) };
+
+/**
+ * @brief Instanciation du bouton poussoir.
+ *
+ * @note Entre deux lectures, le microcontrôleur dort en mode idle : il est
+ *       réveillé toutes les millisecondes par le Timer0. Le seuil de
+ *       KuhnButton correspond donc à peu près à une durée en millisecondes.
+ */
+KuhnButton button(BUTTON_PIN);
+
+/**
+ * @brief Échéances programmées.
+ */
+DeadlineQueue<1> deadlines;
+
+/**
+ * @brief Gestion de l'alimentation, avec réveil par le bouton.
+ */
+PowerManager power(BUTTON_PIN);
+
+/**
+ * @brief Réveil par le bouton (broche 2, port D : groupe PCINT2).
+ */
+POWER_WAKE_INTERRUPT(BUTTON_PIN, 2)
+
+/**
+ * @brief Indice de la LED active sur le chenillard.
+ */
+uint8_t index = 0;
+
+/**
+ * @brief Indique si le chenillard est allumé.
+ */
+bool lit = true;
+
+/**
+ * @brief Indique si les statistiques ont déjà été affichées pendant l'appui en cours.
+ */
+bool reported = false;
+
+/**
+ * @brief Démarrage du programme principal.
+ */
+void setup() {
+
+    // LEDs du chenillard et bouton de réveil.
+    PinSetup pins;
+
+    for (uint8_t i=0; i<NUM_LEDS; i++) led[i].configure(pins);
+    button.configure(pins);
+
+    pins.apply();
+
+    Serial.begin(9600);
+
+    led[index].light(true);
+    deadlines.schedule(OFF_DEADLINE, millis() + OFF_DELAY_MS);
+
+    power.begin();
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    button.read();
+
+    uint32_t now = millis();
+
+    if (button.isPressed()) {
+
+        led[index].light(false);
+        if (lit) index = (index + 1) % NUM_LEDS;
+        led[index].light(lit = true);
+
+        reported = false;
+        deadlines.schedule(OFF_DEADLINE, now + OFF_DELAY_MS);
+
+    }
+
+    if (!reported && button.wasHeldFor(REPORT_DELAY_MS)) {
+
+        power.report(Serial);
+        Serial.flush();
+        reported = true;
+
+    }
+
+    uint8_t id;
+
+    while (deadlines.expired(now, id)) led[index].light(lit = false);
+
+    // Un bouton enfoncé, ou en cours de déparasitage, empêche le sommeil profond :
+    // il faut continuer à le lire régulièrement.
+    bool busy = !button.isFree() || digitalRead(BUTTON_PIN);
+
+    uint32_t until_ms = PowerManager::NO_DEADLINE;
+
+    if (deadlines.size()) until_ms = (int32_t) (deadlines.next() - now) > 0 ? deadlines.next() - now : 0;
+
+    power.sleep(busy, until_ms);
+
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Mesure au cycle près du coût de la lecture des boutons et de la commande
+ * des LEDs, dans le simulateur simavr (voir bench/run.sh).
+ *
+ * Chaque portion de code mesurée est encadrée par deux écritures dans le
+ * registre GPIOR0, que le simulateur intercepte pour relever le compteur
+ * de cycles. Les interruptions sont désactivées pendant chaque mesure :
+ * l'interruption du Timer0 (toutes les millisecondes) ne peut pas s'y
+ * glisser, et les cycles relevés sont exactement ceux du code mesuré.
+ *
+ * Ce programme ne produit rien sur une vraie carte : il se contente de
+ * s'endormir, interruptions désactivées, à la fin des mesures.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <Led.h>
+#include <KuhnButton.h>
+#include <AdafruitButton.h>
+#include <LeadingEdgeButton.h>
+#include <ShiftRegisterButton.h>
+#include <IirButton.h>
+#include <MajorityButton.h>
+#include <PinSetup.h>
+
+/**
+ * @brief Broche de lecture du bouton (son signal est rejoué par le simulateur).
+ */
+const uint8_t BUTTON_PIN = 2;
+
+/**
+ * @brief Nombre de mesures de chaque portion de code.
+ */
+const uint16_t RUNS = 500;
+
+/**
+ * @brief Période d'échantillonnage du bouton (exprimée en microsecondes).
+ */
+const uint16_t SAMPLE_US = 20;
+
+/**
+ * @brief Identifiant de la portion vide, qui mesure le coût des marqueurs.
+ */
+const uint8_t OVERHEAD_ID = 1;
+
+/**
+ * @brief Identifiant de la mesure de Led::light().
+ */
+const uint8_t LED_ID = 2;
+
+/**
+ * @brief Premier identifiant des mesures des boutons (trois par bouton).
+ */
+const uint8_t BUTTON_ID = 3;
+
+/**
+ * @brief Accès à la méthode protégée _debounce() d'un bouton, pour la mesurer seule.
+ */
+template <class B>
+class Probe : public B {
+
+    public:
+
+        using B::B;
+
+        void debounce(const uint8_t input) {
+            this->_debounce(input);
+        }
+
+};
+
+/**
+ * @brief Boutons mesurés (tous reliés à la même broche).
+ */
+Probe<KuhnButton>             kuhn(BUTTON_PIN);
+Probe<AdafruitButton>         adafruit(BUTTON_PIN);
+Probe<LeadingEdgeButton<>>    leading(BUTTON_PIN);
+Probe<ShiftRegisterButton<8>> shift(BUTTON_PIN);
+Probe<IirButton<>>            iir(BUTTON_PIN);
+Probe<MajorityButton<5>>      majority(BUTTON_PIN);
+
+/**
+ * @brief LED mesurée.
+ */
+Led led(5);
+
+/**
+ * @brief Ouverture d'une mesure, interruptions désactivées.
+ *
+ * @param id Identifiant de la mesure (non nul).
+ *
+ * @return L'état des interruptions (registre SREG), à transmettre à closeRegion().
+ *
+ * @note Les barrières empêchent le compilateur de déplacer le code mesuré
+ *       hors de la mesure. Désactivation et restauration des interruptions
+ *       restent hors de la mesure : la portion vide "overhead" ne compte
+ *       que les deux marqueurs.
+ */
+inline uint8_t openRegion(const uint8_t id) {
+
+    uint8_t sreg = SREG;
+
+    cli();
+    GPIOR0 = id;
+    asm volatile("" ::: "memory");
+
+    return sreg;
+
+}
+
+/**
+ * @brief Fermeture d'une mesure, puis restauration des interruptions.
+ *
+ * @param sreg État des interruptions renvoyé par openRegion().
+ */
+inline void closeRegion(const uint8_t sreg) {
+
+    asm volatile("" ::: "memory");
+    GPIOR0 = 0;
+
+    SREG = sreg;
+
+}
+
+/**
+ * @brief Transmission au simulateur du nom d'une mesure.
+ *
+ * @param id     Identifiant de la mesure.
+ * @param name   Nom de la mesure (en mémoire flash).
+ * @param suffix Suffixe du nom (en mémoire flash).
+ */
+void label(const uint8_t id, const __FlashStringHelper *name, const __FlashStringHelper *suffix) {
+
+    const char *p = (const char *) name;
+    char        c;
+
+    GPIOR2 = id;
+
+    while ((c = pgm_read_byte(p++))) GPIOR1 = c;
+
+    p = (const char *) suffix;
+
+    while ((c = pgm_read_byte(p++))) GPIOR1 = c;
+
+    GPIOR1 = 0;
+
+}
+
+/**
+ * @brief Mesure de la lecture d'un bouton.
+ *
+ * @param button Bouton mesuré.
+ * @param id     Premier des trois identifiants de mesure du bouton.
+ * @param name   Nom du bouton (en mémoire flash).
+ *
+ * @note Trois portions sont mesurées : read() (avec digitalRead()), read(input)
+ *       (déparasitage et interprétation de l'état) et _debounce() seule.
+ */
+template <class B>
+void bench(B &button, const uint8_t id, const __FlashStringHelper *name) {
+
+    label(id,     name, F(" read()"));
+    label(id + 1, name, F(" read(input)"));
+    label(id + 2, name, F(" _debounce()"));
+
+    for (uint16_t i=0; i<RUNS; i++) {
+
+        uint8_t sreg = openRegion(id);
+        button.read();
+        closeRegion(sreg);
+
+        uint8_t input = digitalRead(BUTTON_PIN);
+
+        sreg = openRegion(id + 1);
+        button.read(input);
+        closeRegion(sreg);
+
+        sreg = openRegion(id + 2);
+        button.debounce(input);
+        closeRegion(sreg);
+
+        delayMicroseconds(SAMPLE_US);
+
+    }
+
+}
+
+/**
+ * @brief Démarrage du programme principal : exécution des mesures.
+ */
+void setup() {
+
+    // LED témoin et broche du bouton.
+    PinSetup pins;
+
+    // Tous les boutons lisent la même broche.
+    led.configure(pins);
+    kuhn.configure(pins);
+
+    pins.apply();
+
+    label(OVERHEAD_ID, F("overhead"), F(""));
+    label(LED_ID, F("Led::light()"), F(""));
+
+    for (uint16_t i=0; i<RUNS; i++) {
+
+        uint8_t sreg = openRegion(OVERHEAD_ID);
+        closeRegion(sreg);
+
+        sreg = openRegion(LED_ID);
+        led.light(i & 0x1);
+        closeRegion(sreg);
+
+    }
+
+    bench(kuhn,     BUTTON_ID,      F("kuhn"));
+    bench(adafruit, BUTTON_ID + 3,  F("adafruit"));
+    bench(leading,  BUTTON_ID + 6,  F("leading"));
+    bench(shift,    BUTTON_ID + 9,  F("shift<8>"));
+    bench(iir,      BUTTON_ID + 12, F("iir<3>"));
+    bench(majority, BUTTON_ID + 15, F("majority<5>"));
+
+    // Le simulateur s'arrête lorsque le processeur s'endort, interruptions désactivées.
+    cli();
+    sleep_enable();
+    sleep_cpu();
+
+}
+
+/**
+ * @brief Boucle de contrôle principale : elle n'est jamais atteinte.
+ */
+void loop() {}
\ No newline at end of file
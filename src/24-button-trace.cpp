@@ -0,0 +1,162 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Traçage des lectures des classes KuhnButton et AdafruitButton.
+ *
+ * Contrairement au programme 05, qui reproduit l'algorithme de Kenneth A.
+ * Kuhn pour l'observer, ce programme trace les classes telles qu'elles
+ * sont livrées : Button::read() émet une trace à chaque changement du
+ * signal d'entrée ou de l'état du bouton (environnement PlatformIO
+ * `trace`, qui définit le symbole BUTTON_TRACE).
+ *
+ * Les deux boutons lisent la même broche. Les traces sont déposées dans un
+ * tampon circulaire, puis restituées sur le moniteur série, une ligne à la
+ * fois, sans jamais bloquer la lecture des boutons.
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <KuhnButton.h>
+#include <AdafruitButton.h>
+#include <ButtonTrace.h>
+#include <Uart.h>
+#include <PinSetup.h>
+
+#ifndef BUTTON_TRACE
+#error "this sketch must be built with -D BUTTON_TRACE (PlatformIO environment `trace`)"
+#endif
+
+/**
+ * @brief Broche de lecture de l'état du bouton.
+ */
+const uint8_t BTN_PIN = 2;
+
+/**
+ * @brief Débit de la liaison série (exprimé en bauds).
+ */
+const uint32_t BAUD_RATE = 1000000;
+
+/**
+ * @brief Nombre de caractères maximal d'une ligne de la restitution.
+ */
+const uint8_t LINE_SIZE = 48;
+
+/**
+ * @brief Nombre de traces conservées en attente de restitution.
+ *
+ * @note Un appui franc produit une dizaine de traces par bouton, un appui
+ *       qui rebondit davantage : les 64 traces (576 octets) absorbent la
+ *       rafale, pendant que la restitution suit à raison d'une ligne toutes
+ *       les 400 µs environ.
+ */
+const uint8_t TRACE_SIZE = 64;
+
+/**
+ * @brief Boutons tracés.
+ */
+KuhnButton     kuhn(BTN_PIN);
+AdafruitButton adafruit(BTN_PIN);
+
+/**
+ * @brief Noms des états du bouton (voir ButtonTrace).
+ */
+const char * const STATES[] = { "free", "pressed", "held", "released" };
+
+/**
+ * @brief Tampon des traces.
+ */
+ButtonTraceRing<TRACE_SIZE> traces;
+
+/**
+ * @brief Liaison série, en émission seule.
+ */
+Uart uart;
+
+/**
+ * @brief Destinataire des traces émises par Button::read().
+ */
+void buttonTrace(const ButtonTrace &trace) {
+    traces.push(trace);
+}
+
+/**
+ * @brief Implémentation d'une fonction de remplacement de Serial.printf().
+ *
+ * @see 05-kuhn-debouncing-algorithm-analysis.cpp
+ */
+void printf(const __FlashStringHelper *format, ...) {
+
+    char    buffer[LINE_SIZE];
+    va_list args;
+
+    va_start (args, format);
+    vsnprintf_P(buffer, sizeof(buffer), (const char *)format, args);
+    va_end(args);
+
+    uart.print(buffer);
+
+}
+
+/**
+ * @brief Restitution de la trace la plus ancienne, si le tampon d'émission peut la recevoir.
+ */
+void dump() {
+
+    if (uart.availableForWrite() < LINE_SIZE) return;
+
+    uint8_t lost = traces.takeLost();
+
+    if (lost) {
+        printf(F("--- %u traces lost\n"), lost);
+        return;
+    }
+
+    ButtonTrace trace;
+
+    if (!traces.pop(trace)) return;
+
+    printf(F("%10lu | %-8s | %u | %u | %s\n"),
+        trace.time_us,
+        trace.button == &kuhn ? "kuhn" : "adafruit",
+        trace.input,
+        trace.output,
+        STATES[trace.state]);
+
+}
+
+/**
+ * @brief Démarrage du programme.
+ */
+void setup() {
+
+    // Broche du bouton.
+    PinSetup pins;
+
+    // Les deux boutons lisent la même broche.
+    kuhn.configure(pins);
+
+    pins.apply();
+
+    uart.begin(BAUD_RATE);
+    uart.println(F("\n\n        us | button   | i | o | state"));
+    uart.flush();
+    uart.println(F("-----------+----------+---+---+---------"));
+
+}
+
+/**
+ * @brief Boucle de contrôle principale.
+ */
+void loop() {
+
+    kuhn.read();
+    adafruit.read();
+
+    dump();
+
+}
\ No newline at end of file
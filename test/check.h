@@ -0,0 +1,63 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Vérifications des tests sur ordinateur : chaque échec est signalé avec
+ * sa position dans le fichier source, et le test se termine en erreur
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdio.h>
+
+/**
+ * @brief Nombre de vérifications en échec.
+ */
+static unsigned check_failures = 0;
+
+/**
+ * @brief Vérifie une condition.
+ */
+#define CHECK(condition)                                                   \
+    do {                                                                   \
+        if (!(condition)) {                                                \
+            printf("%s:%d: CHECK(%s) failed\n",                            \
+                __FILE__, __LINE__, #condition);                           \
+            check_failures++;                                              \
+        }                                                                  \
+    } while (0)
+
+/**
+ * @brief Vérifie l'égalité de deux entiers, et affiche leurs valeurs en cas d'échec.
+ */
+#define CHECK_EQUAL(expected, actual)                                      \
+    do {                                                                   \
+        long _expected = (long) (expected);                                \
+        long _actual   = (long) (actual);                                  \
+        if (_expected != _actual) {                                        \
+            printf("%s:%d: %s == %ld, expected %ld\n",                     \
+                __FILE__, __LINE__, #actual, _actual, _expected);          \
+            check_failures++;                                              \
+        }                                                                  \
+    } while (0)
+
+/**
+ * @brief Code de retour du test : 0 si toutes les vérifications ont réussi.
+ */
+inline int checkReport(const char *name) {
+
+    if (check_failures) printf("%s: %u check(s) failed\n", name, check_failures);
+    else                printf("%s: ok\n", name);
+
+    return check_failures ? 1 : 0;
+
+}
\ No newline at end of file
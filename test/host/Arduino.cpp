@@ -0,0 +1,29 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition des registres, de l'horloge et des broches simulés
+ * -------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+
+volatile uint8_t PINB, DDRB, PORTB;
+volatile uint8_t PINC, DDRC, PORTC;
+volatile uint8_t PIND, DDRD, PORTD;
+
+// Les interruptions sont actives, comme après l'initialisation d'Arduino.
+volatile uint8_t SREG = _BV(SREG_I);
+
+volatile uint8_t SPCR, SPSR, SPDR;
+
+volatile uint8_t  UCSR0A, UCSR0B, UCSR0C, UDR0;
+volatile uint16_t UBRR0;
+
+uint32_t host_micros;
+
+uint8_t host_pins[NUM_DIGITAL_PINS];
\ No newline at end of file
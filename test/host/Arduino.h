@@ -0,0 +1,81 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Substitut du fichier Arduino.h pour la compilation des tests sur un
+ * ordinateur : le temps et l'état des broches sont pilotés par les tests
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <Print.h>
+
+#define HIGH 1
+#define LOW  0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+typedef uint8_t byte;
+
+/**
+ * @brief Broches du SPI matériel et nombre de broches numériques de la Nano.
+ */
+static const uint8_t SS   = 10;
+static const uint8_t MOSI = 11;
+static const uint8_t MISO = 12;
+static const uint8_t SCK  = 13;
+
+#define NUM_DIGITAL_PINS 20
+
+/**
+ * @brief Correspondance broches / ports de l'ATmega328P (D0-D7 : PORTD,
+ *        D8-D13 : PORTB, A0-A5 : PORTC), comme pins_arduino.h.
+ */
+#define NOT_A_PORT 0
+#define PB 2
+#define PC 3
+#define PD 4
+
+#define digitalPinToPort(p)     ((uint8_t) ((p) < 8 ? PD : (p) < 14 ? PB : PC))
+#define digitalPinToBitMask(p)  ((uint8_t) (1 << ((p) < 8 ? (p) : (p) < 14 ? (p) - 8 : (p) - 14)))
+#define portOutputRegister(P)   ((P) == PB ? &PORTB : (P) == PC ? &PORTC : &PORTD)
+#define portInputRegister(P)    ((P) == PB ? &PINB  : (P) == PC ? &PINC  : &PIND)
+#define portModeRegister(P)     ((P) == PB ? &DDRB  : (P) == PC ? &DDRC  : &DDRD)
+#define digitalPinToPCICRbit(p) ((p) < 8 ? 2 : (p) < 14 ? 0 : 1)
+
+/**
+ * @brief Horloge simulée (exprimée en microsecondes), avancée par les tests.
+ */
+extern uint32_t host_micros;
+
+/**
+ * @brief Niveau logique simulé de chaque broche, fixé par les tests.
+ */
+extern uint8_t host_pins[NUM_DIGITAL_PINS];
+
+inline unsigned long micros() { return host_micros; }
+inline unsigned long millis() { return host_micros / 1000; }
+
+inline void delay(unsigned long ms)             { host_micros += ms * 1000; }
+inline void delayMicroseconds(unsigned int us) { host_micros += us; }
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t level) { host_pins[pin] = level; }
+inline int  digitalRead(uint8_t pin)                 { return host_pins[pin]; }
\ No newline at end of file
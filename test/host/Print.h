@@ -0,0 +1,49 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Substitut du fichier Print.h : seules les méthodes d'écriture que les
+ * classes éprouvées redéfinissent sont déclarées
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class Print {
+
+    public:
+
+        virtual ~Print() {}
+
+        virtual size_t write(uint8_t byte) = 0;
+
+        virtual size_t write(const uint8_t *buffer, size_t size) {
+
+            size_t n = 0;
+            while (size-- && write(*buffer++)) n++;
+
+            return n;
+
+        }
+
+        size_t write(const char *str) {
+            return str ? write((const uint8_t *) str, strlen(str)) : 0;
+        }
+
+        virtual int availableForWrite() { return 0; }
+
+        virtual void flush() {}
+
+};
\ No newline at end of file
@@ -0,0 +1,15 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Définition du bus I2C simulé
+ * -------------------------------------------------------------------------
+ */
+
+#include <Wire.h>
+
+TwoWire Wire;
\ No newline at end of file
@@ -0,0 +1,179 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Substitut du fichier Wire.h : le bus I2C relève chaque transaction, et
+ * simule un composant à registres adressés séquentiellement
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Bus I2C simulé.
+ *
+ * @note Le premier octet d'une écriture choisit le registre courant, les
+ *       suivants sont écrits dans les registres successifs. Une lecture
+ *       renvoie les registres successifs à partir du registre courant.
+ *       Comme le MCP23017 en mode séquentiel, le composant ne répond qu'à
+ *       son adresse (device).
+ *
+ *       Chaque séquence émise sur le bus est relevée dans `log`, et chaque
+ *       condition de stop compte pour une transaction.
+ */
+class TwoWire {
+
+    public:
+
+        /**
+         * @brief Séquence émise sur le bus : écriture (beginTransmission() à
+         *        endTransmission()) ou lecture (requestFrom()).
+         */
+        struct Sequence {
+            uint8_t address;  // Adresse du composant.
+            bool    read;     // true pour une lecture.
+            uint8_t length;   // Nombre d'octets (registre compris, pour une écriture).
+            uint8_t reg;      // Premier octet écrit, ou registre courant de la lecture.
+            bool    stop;     // Séquence terminée par une condition de stop.
+        };
+
+        static const uint8_t LOG_SIZE = 64;
+
+        uint8_t  device;              // Adresse du composant simulé.
+        uint8_t  registers[256];      // Registres du composant simulé.
+        uint8_t  pointer;             // Registre courant.
+        uint32_t clock_hz;            // Fréquence du bus.
+        bool     begun;               // Bus initialisé par begin().
+        Sequence log[LOG_SIZE];       // Séquences relevées (les LOG_SIZE premières).
+        uint16_t sequences;           // Nombre de séquences émises.
+        uint16_t transactions;        // Nombre de conditions de stop.
+        uint8_t  available_bytes;     // Octets restant à lire après requestFrom().
+        bool     open;                // Écriture en cours.
+
+        TwoWire() : device(0) {
+            reset();
+        }
+
+        /**
+         * @brief Remet le bus et le composant à zéro (sans toucher à `device`).
+         */
+        void reset() {
+
+            memset(registers, 0, sizeof(registers));
+            memset(log, 0, sizeof(log));
+
+            pointer         = 0;
+            clock_hz        = 0;
+            begun           = false;
+            sequences       = 0;
+            transactions    = 0;
+            available_bytes = 0;
+            open            = false;
+
+        }
+
+        void begin() {
+            begun = true;
+        }
+
+        void setClock(const uint32_t hz) {
+            clock_hz = hz;
+        }
+
+        void beginTransmission(const uint8_t address) {
+
+            Sequence &s = _current();
+            s.address = address;
+            s.read    = false;
+            s.length  = 0;
+            s.reg     = 0;
+            open      = true;
+
+        }
+
+        size_t write(const uint8_t byte) {
+
+            if (!open) return 0;
+
+            Sequence &s = _current();
+
+            if (s.address == device) {
+                if (!s.length) pointer = byte;
+                else registers[pointer++] = byte;
+            }
+
+            if (!s.length) s.reg = byte;
+            s.length++;
+
+            return 1;
+
+        }
+
+        uint8_t endTransmission(const bool stop = true) {
+
+            Sequence &s = _current();
+            s.stop = stop;
+
+            open = false;
+            sequences++;
+            if (stop) transactions++;
+
+            // 0 : succès, 2 : adresse sans acquittement.
+            return s.address == device ? 0 : 2;
+
+        }
+
+        uint8_t requestFrom(const uint8_t address, const uint8_t n) {
+
+            Sequence &s = _current();
+            s.address = address;
+            s.read    = true;
+            s.length  = n;
+            s.reg     = pointer;
+            s.stop    = true;
+
+            sequences++;
+            transactions++;
+
+            available_bytes = address == device ? n : 0;
+
+            return available_bytes;
+
+        }
+
+        int available() {
+            return available_bytes;
+        }
+
+        int read() {
+
+            if (!available_bytes) return -1;
+
+            available_bytes--;
+
+            return registers[pointer++];
+
+        }
+
+    private:
+
+        Sequence &_current() {
+            static Sequence overflow;
+            return sequences < LOG_SIZE ? log[sequences] : overflow;
+        }
+
+};
+
+extern TwoWire Wire;
\ No newline at end of file
@@ -0,0 +1,27 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Substitut du fichier avr/interrupt.h : les routines d'interruption sont
+ * des fonctions ordinaires, que les tests appellent à la main
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <avr/io.h>
+
+#define ISR(vector, ...) extern "C" void vector(void); void vector(void)
+
+#define EMPTY_INTERRUPT(vector) extern "C" void vector(void); void vector(void) {}
+
+#define cli() (SREG &= ~_BV(SREG_I))
+#define sei() (SREG |=  _BV(SREG_I))
\ No newline at end of file
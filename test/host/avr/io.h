@@ -0,0 +1,60 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Substitut du fichier avr/io.h : les registres de l'ATmega328P utilisés
+ * par les classes éprouvées sont de simples variables (voir Arduino.cpp)
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+// Ports d'entrées-sorties.
+extern volatile uint8_t PINB, DDRB, PORTB;
+extern volatile uint8_t PINC, DDRC, PORTC;
+extern volatile uint8_t PIND, DDRD, PORTD;
+
+// Registre d'état.
+extern volatile uint8_t SREG;
+
+#define SREG_I 7
+
+// SPI.
+extern volatile uint8_t SPCR, SPSR, SPDR;
+
+#define SPE   6
+#define DORD  5
+#define MSTR  4
+#define SPIF  7
+#define SPI2X 0
+
+// USART0.
+extern volatile uint8_t  UCSR0A, UCSR0B, UCSR0C, UDR0;
+extern volatile uint16_t UBRR0;
+
+#define DOR0   3
+#define U2X0   1
+#define TXC0   6
+#define UDRE0  5
+#define RXCIE0 7
+#define UDRIE0 5
+#define RXEN0  4
+#define TXEN0  3
+#define UCSZ01 2
+#define UCSZ00 1
\ No newline at end of file
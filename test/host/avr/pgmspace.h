@@ -0,0 +1,30 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Substitut du fichier avr/pgmspace.h : sur un ordinateur, la mémoire
+ * flash et la mémoire vive ne forment qu'un seul espace d'adressage
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+#define PSTR(s) (s)
+
+#define pgm_read_byte(address) (*(const uint8_t *) (address))
+#define pgm_read_word(address) (*(const uint16_t *) (address))
+
+#define memcpy_P memcpy
\ No newline at end of file
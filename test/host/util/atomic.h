@@ -0,0 +1,27 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Substitut du fichier util/atomic.h : le bloc est exécuté une fois, les
+ * interruptions désactivées (bit I de SREG), puis SREG est restauré
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ * @note Spécifie que le compilateur n’intègre le fichier d’en-tête
+ *       qu’une seule fois lors de la compilation des fichiers sources.
+ */
+#pragma once
+
+#include <avr/interrupt.h>
+
+#define ATOMIC_BLOCK(type)                                                 \
+    for (uint8_t _sreg = SREG, _once = (cli(), 1); _once;                  \
+         _once = 0, SREG = (type) == ATOMIC_FORCEON ? _sreg | _BV(SREG_I) : _sreg)
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON      1
\ No newline at end of file
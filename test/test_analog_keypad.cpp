@@ -0,0 +1,96 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test du décodage des bandes de tension de la classe AnalogKeypad, avec
+ * des mesures fictives
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <AnalogKeypad.h>
+
+/**
+ * @brief Bornes du programme 16 (échelle de résistances à 5 boutons).
+ */
+const uint16_t LIMITS[] = { 72, 237, 417, 623, 882 };
+const uint8_t  COUNT    = sizeof(LIMITS) / sizeof(LIMITS[0]);
+
+void testBandEdges() {
+
+    // Premier bouton : de 0 à la première borne exclue.
+    CHECK_EQUAL(0, AnalogKeypad::decode(0, LIMITS, COUNT));
+    CHECK_EQUAL(0, AnalogKeypad::decode(LIMITS[0] - 1, LIMITS, COUNT));
+
+    // Chaque borne appartient à la bande suivante.
+    for (uint8_t k=1; k<COUNT; k++) {
+        CHECK_EQUAL(k - 1, AnalogKeypad::decode(LIMITS[k - 1] - 1, LIMITS, COUNT));
+        CHECK_EQUAL(k,     AnalogKeypad::decode(LIMITS[k - 1], LIMITS, COUNT));
+        CHECK_EQUAL(k,     AnalogKeypad::decode(LIMITS[k] - 1, LIMITS, COUNT));
+    }
+
+    // Au-delà de la dernière borne : aucun bouton.
+    CHECK_EQUAL(COUNT - 1, AnalogKeypad::decode(LIMITS[COUNT - 1] - 1, LIMITS, COUNT));
+    CHECK_EQUAL(AnalogKeypad::NO_KEY, AnalogKeypad::decode(LIMITS[COUNT - 1], LIMITS, COUNT));
+    CHECK_EQUAL(AnalogKeypad::NO_KEY, AnalogKeypad::decode(1023, LIMITS, COUNT));
+
+}
+
+void testNominalValues() {
+
+    // Mesures nominales des boutons, à 5 % de la pleine échelle près.
+    const uint16_t NOMINAL[] = { 0, 145, 329, 505, 741 };
+    const uint16_t MARGIN    = 51;
+
+    for (uint8_t k=0; k<COUNT; k++) {
+        CHECK_EQUAL(k, AnalogKeypad::decode(NOMINAL[k], LIMITS, COUNT));
+        CHECK_EQUAL(k, AnalogKeypad::decode(NOMINAL[k] + MARGIN, LIMITS, COUNT));
+        if (k) CHECK_EQUAL(k, AnalogKeypad::decode(NOMINAL[k] - MARGIN, LIMITS, COUNT));
+    }
+
+}
+
+void testEveryValue() {
+
+    // Toutes les mesures possibles : l'indice décodé croît avec la mesure.
+    uint8_t previous = 0;
+
+    for (uint16_t value=0; value<1024; value++) {
+
+        uint8_t key = AnalogKeypad::decode(value, LIMITS, COUNT);
+
+        CHECK(key == AnalogKeypad::NO_KEY || key < COUNT);
+        CHECK(key == previous || key == previous + 1 || (key == AnalogKeypad::NO_KEY && previous == COUNT - 1));
+
+        if (key != previous) CHECK_EQUAL(value, key == AnalogKeypad::NO_KEY ? LIMITS[COUNT - 1] : LIMITS[key - 1]);
+
+        previous = key;
+
+    }
+
+    CHECK_EQUAL(AnalogKeypad::NO_KEY, previous);
+
+}
+
+void testEmptyKeypad() {
+
+    // Sans bouton, aucune mesure n'est décodée.
+    CHECK_EQUAL(AnalogKeypad::NO_KEY, AnalogKeypad::decode(0, LIMITS, 0));
+    CHECK_EQUAL(AnalogKeypad::NO_KEY, AnalogKeypad::decode(1023, LIMITS, 0));
+
+}
+
+int main() {
+
+    testBandEdges();
+    testNominalValues();
+    testEveryValue();
+    testEmptyKeypad();
+
+    return checkReport("analog_keypad");
+
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe BounceWindow, avec des relevés fictifs du compteur de
+ * fronts montants
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <BounceWindow.h>
+
+/**
+ * @brief Durée de la fenêtre de comptage (exprimée en millisecondes).
+ */
+const uint16_t WINDOW_MS = 20;
+
+/**
+ * @brief Compteur fictif : fronts montants et niveau de la broche.
+ */
+EdgeCounter::Snapshot counter;
+
+/**
+ * @brief Rebond : `edges` transitions, à partir du niveau courant.
+ */
+void bounce(const uint8_t edges) {
+
+    for (uint8_t i=0; i<edges; i++) {
+        if (!counter.level) counter.rising++;
+        counter.level ^= 1;
+    }
+
+}
+
+/**
+ * @brief Mises à jour de la fenêtre, une par milliseconde, de `from` à `to` exclue.
+ *
+ * @return La date de fermeture de la fenêtre, ou `to` si elle ne s'est pas refermée.
+ */
+uint32_t run(BounceWindow &window, const uint32_t from, const uint32_t to) {
+
+    for (uint32_t t=from; t!=to; t++) {
+        if (window.update(t, counter)) return t;
+    }
+
+    return to;
+
+}
+
+void testIdle() {
+
+    counter = { 0, 0 };
+
+    BounceWindow window(WINDOW_MS);
+    window.reset(0, counter);
+
+    // Aucune transition : la fenêtre ne s'ouvre jamais.
+    CHECK_EQUAL(10000, run(window, 0, 10000));
+    CHECK_EQUAL(0, window.up());
+    CHECK_EQUAL(0, window.down());
+
+}
+
+void testExpiry() {
+
+    counter = { 0, 0 };
+
+    BounceWindow window(WINDOW_MS);
+    window.reset(0, counter);
+
+    // Repos jusqu'à 999 ms : l'ouverture de la fenêtre est repoussée.
+    CHECK_EQUAL(1000, run(window, 0, 1000));
+
+    // Appui à 1000 ms, avec 5 transitions (3 montantes, 2 descendantes).
+    bounce(5);
+
+    // La fenêtre se referme plus de WINDOW_MS après la dernière date de repos.
+    CHECK_EQUAL(999 + WINDOW_MS + 1, run(window, 1000, 2000));
+    CHECK_EQUAL(3, window.up());
+    CHECK_EQUAL(2, window.down());
+
+    // Bouton stable : plus rien.
+    CHECK_EQUAL(2000, run(window, 1021, 2000));
+
+    // Relâchement : 7 transitions (3 montantes, 4 descendantes), dont les
+    // dernières tombent encore dans la fenêtre.
+    bounce(4);
+    CHECK_EQUAL(2010, run(window, 2000, 2010));
+    bounce(3);
+
+    CHECK_EQUAL(1999 + WINDOW_MS + 1, run(window, 2010, 3000));
+    CHECK_EQUAL(3, window.up());
+    CHECK_EQUAL(4, window.down());
+
+}
+
+void testLateBounces() {
+
+    counter = { 0, 0 };
+
+    BounceWindow window(WINDOW_MS);
+    window.reset(0, counter);
+
+    run(window, 0, 100);
+
+    // Des transitions au-delà de la fenêtre sont comptées dans la suivante.
+    bounce(3);
+    CHECK_EQUAL(120, run(window, 100, 1000));
+    CHECK_EQUAL(2, window.up());
+    CHECK_EQUAL(1, window.down());
+
+    bounce(2);
+    CHECK_EQUAL(141, run(window, 121, 1000));
+    CHECK_EQUAL(1, window.up());
+    CHECK_EQUAL(1, window.down());
+
+}
+
+void testReset() {
+
+    counter = { 0, 0 };
+
+    BounceWindow window(WINDOW_MS);
+    window.reset(0, counter);
+
+    run(window, 0, 100);
+    bounce(5);
+    CHECK_EQUAL(110, run(window, 100, 110));
+
+    // Réinitialisation : les transitions déjà observées sont oubliées.
+    window.reset(110, counter);
+
+    CHECK_EQUAL(1000, run(window, 110, 1000));
+
+    bounce(2);
+    CHECK_EQUAL(1020, run(window, 1000, 2000));
+    CHECK_EQUAL(1, window.up());
+    CHECK_EQUAL(1, window.down());
+
+}
+
+void testCounterWrapAround() {
+
+    // Le compteur de fronts montants déborde pendant la fenêtre.
+    counter = { 65534, 0 };
+
+    BounceWindow window(WINDOW_MS);
+    window.reset(0, counter);
+
+    run(window, 0, 100);
+    bounce(9);
+
+    CHECK_EQUAL(120, run(window, 100, 1000));
+    CHECK_EQUAL(3, counter.rising);
+    CHECK_EQUAL(5, window.up());
+    CHECK_EQUAL(4, window.down());
+
+}
+
+void testMillisWrapAround() {
+
+    counter = { 0, 0 };
+
+    // La date repasse par 0 pendant la fenêtre, 10 ms après son ouverture.
+    const uint32_t START = 0xFFFFFFF0;
+
+    BounceWindow window(WINDOW_MS);
+    window.reset(START - 100, counter);
+
+    CHECK_EQUAL(START + 6, run(window, START - 100, START + 6));
+
+    bounce(3);
+
+    CHECK_EQUAL((uint32_t) (START + 5 + WINDOW_MS + 1), run(window, START + 6, 1000));
+    CHECK_EQUAL(2, window.up());
+    CHECK_EQUAL(1, window.down());
+
+    // Et le repos qui suit ne rouvre pas la fenêtre.
+    CHECK_EQUAL(2000, run(window, START + 5 + WINDOW_MS + 2, 2000));
+
+}
+
+int main() {
+
+    testIdle();
+    testExpiry();
+    testLateBounces();
+    testReset();
+    testCounterWrapAround();
+    testMillisWrapAround();
+
+    return checkReport("bounce_window");
+
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test du décompte des appuis (Button::takePresses()) sous des rafales
+ * d'appuis francs, jusqu'à la cadence maximale annoncée et au-delà
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <KuhnButton.h>
+
+/**
+ * @brief Période d'échantillonnage (exprimée en microsecondes).
+ */
+const uint16_t SAMPLE_US = 100;
+
+/**
+ * @brief Nombre d'appuis de chaque rafale.
+ */
+const uint16_t TAPS = 500;
+
+/**
+ * @brief Période de relevé du compteur d'appuis (exprimée en échantillons).
+ */
+const uint16_t CONSUMER_SAMPLES = 100;
+
+/**
+ * @brief Durée du repos qui encadre chaque rafale (exprimée en échantillons).
+ */
+const uint16_t IDLE_SAMPLES = 300;
+
+/**
+ * @brief Bouton sans déparasitage : la sortie recopie l'entrée.
+ */
+class RawButton : public Button {
+
+    protected:
+
+        void _debounce(const uint8_t input) override {
+            _output = input;
+        }
+
+};
+
+/**
+ * @brief Soumet un bouton à une rafale d'appuis francs.
+ *
+ * @param button Bouton éprouvé.
+ * @param half   Durée de chaque niveau (exprimée en échantillons).
+ *
+ * @return Le nombre d'appuis relevés par takePresses(), toutes les 10 ms.
+ */
+uint32_t burst(Button &button, const uint16_t half) {
+
+    uint32_t samples = 2UL * TAPS * half + 2 * IDLE_SAMPLES;
+    uint32_t presses = 0;
+
+    button.takePresses();
+
+    for (uint32_t i=0; i<samples; i++) {
+
+        // Repos, rafale, puis retour au repos.
+        uint32_t t     = i - IDLE_SAMPLES;
+        uint8_t  input = i >= IDLE_SAMPLES && t < 2UL * TAPS * half && (t / half) & 0x1;
+
+        button.read(input);
+
+        if (!((i + 1) % CONSUMER_SAMPLES)) presses += button.takePresses();
+
+        host_micros += SAMPLE_US;
+
+    }
+
+    return presses + button.takePresses();
+
+}
+
+/**
+ * @brief Durée de chaque niveau (en échantillons) pour une cadence donnée (en appuis par seconde).
+ */
+uint16_t halfPeriod(const uint16_t rate) {
+    return 500000UL / ((uint32_t) rate * SAMPLE_US);
+}
+
+void testKuhnUpToMaximumRate() {
+
+    // 312 appuis par seconde (16 lectures par niveau) : la cadence maximale
+    // annoncée par Button::takePresses() pour KuhnButton à 100 µs.
+    const uint16_t RATES[] = { 10, 50, 100, 200, 250, 300, 312 };
+
+    for (uint16_t rate : RATES) {
+
+        KuhnButton button(Button::NO_PIN);
+
+        CHECK_EQUAL(TAPS, burst(button, halfPeriod(rate)));
+
+    }
+
+    CHECK_EQUAL(16, halfPeriod(312));
+
+}
+
+void testKuhnAboveMaximumRate() {
+
+    // Au-delà, chaque niveau dure moins de 16 lectures : l'intégrateur
+    // n'atteint plus ses bornes, et les appuis sont perdus.
+    const uint16_t RATES[] = { 334, 400, 500, 1000 };
+
+    for (uint16_t rate : RATES) {
+
+        KuhnButton button(Button::NO_PIN);
+
+        CHECK(halfPeriod(rate) < 16);
+        CHECK(burst(button, halfPeriod(rate)) < TAPS);
+
+    }
+
+}
+
+void testStateMachineEveryTwoReads() {
+
+    // Sans déparasitage, l'interprétation de la sortie suit jusqu'à un appui
+    // toutes les deux lectures.
+    RawButton button;
+
+    CHECK_EQUAL(TAPS, burst(button, 1));
+    CHECK_EQUAL(TAPS, burst(button, 2));
+
+}
+
+void testSaturation() {
+
+    // Le compteur sature à 255 lorsque le programme tarde à le relever.
+    RawButton button;
+
+    for (uint16_t i=0; i<600; i++) button.read(i & 0x1);
+
+    CHECK_EQUAL(255, button.takePresses());
+    CHECK_EQUAL(0, button.takePresses());
+
+}
+
+int main() {
+
+    testKuhnUpToMaximumRate();
+    testKuhnAboveMaximumRate();
+    testStateMachineEveryTwoReads();
+    testSaturation();
+
+    return checkReport("button_taps");
+
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test des traces de lecture (BUTTON_TRACE) d'un KuhnButton, et du tampon
+ * ButtonTraceRing qui les recueille
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <KuhnButton.h>
+#include <ButtonTrace.h>
+
+/**
+ * @brief Période d'échantillonnage (exprimée en microsecondes).
+ */
+const uint16_t SAMPLE_US = 100;
+
+/**
+ * @brief États du bouton, codés comme dans les traces.
+ */
+enum { FREE, PRESSED, HELD, RELEASED };
+
+/**
+ * @brief Tampon qui recueille les traces de Button::read().
+ */
+ButtonTraceRing<16> ring;
+
+void buttonTrace(const ButtonTrace &trace) {
+    ring.push(trace);
+}
+
+/**
+ * @brief Vérifie la trace suivante du tampon.
+ */
+void expectTrace(const Button &button, const uint32_t time_us, const uint8_t input, const uint8_t output, const uint8_t state) {
+
+    ButtonTrace trace = {};
+
+    CHECK(ring.pop(trace));
+    CHECK(trace.button == &button);
+    CHECK_EQUAL(time_us, trace.time_us);
+    CHECK_EQUAL(input,  trace.input);
+    CHECK_EQUAL(output, trace.output);
+    CHECK_EQUAL(state,  trace.state);
+
+}
+
+void testPressAndRelease() {
+
+    KuhnButton button(Button::NO_PIN);
+
+    host_micros = 0;
+
+    // Appui franc, maintenu bien au-delà du seuil de l'intégrateur, puis
+    // relâchement franc : seuls les changements sont tracés.
+    for (uint8_t i=0; i<40; i++) {
+        button.read(1);
+        host_micros += SAMPLE_US;
+    }
+
+    for (uint8_t i=0; i<40; i++) {
+        button.read(0);
+        host_micros += SAMPLE_US;
+    }
+
+    CHECK_EQUAL(6, ring.size());
+
+    // L'intégrateur atteint sa borne à la 16e lecture de chaque niveau.
+    expectTrace(button,  0 * SAMPLE_US, 1, 0, FREE);
+    expectTrace(button, 15 * SAMPLE_US, 1, 1, PRESSED);
+    expectTrace(button, 16 * SAMPLE_US, 1, 1, HELD);
+    expectTrace(button, 40 * SAMPLE_US, 0, 1, HELD);
+    expectTrace(button, 55 * SAMPLE_US, 0, 0, RELEASED);
+    expectTrace(button, 56 * SAMPLE_US, 0, 0, FREE);
+
+    CHECK_EQUAL(0, ring.size());
+    CHECK_EQUAL(0, ring.takeLost());
+
+}
+
+void testLostTraces() {
+
+    KuhnButton button(Button::NO_PIN);
+
+    // Chaque changement d'entrée produit une trace : le tampon déborde, les
+    // traces excédentaires sont perdues et comptées.
+    for (uint8_t i=0; i<20; i++) button.read(i & 0x1 ? 0 : 1);
+
+    CHECK_EQUAL(16, ring.size());
+
+    SREG |= _BV(SREG_I);
+    CHECK_EQUAL(4, ring.takeLost());
+    CHECK(SREG & _BV(SREG_I));
+    CHECK_EQUAL(0, ring.takeLost());
+
+    ButtonTrace trace = {};
+    while (ring.pop(trace));
+
+}
+
+int main() {
+
+    testPressAndRelease();
+    testLostTraces();
+
+    return checkReport("button_trace");
+
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe CharlieLedBank : les masques DDRx et PORTx appliqués à
+ * chaque slot sont relevés, et les LEDs qu'ils allument en sont déduites
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <CharlieLedBank.h>
+
+/**
+ * @brief Bits du port qui n'appartiennent pas à la rampe, et qui doivent être préservés.
+ */
+const uint8_t OTHERS = 0xC0;
+
+/**
+ * @brief Parcourt les N slots et relève, pour chacun, les LEDs allumées.
+ *
+ * @param lit Image relevée (un bit par LED, dans l'ordre du câblage).
+ *
+ * @note Les LEDs sont numérotées indépendamment de la table de la classe :
+ *       anode par anode, puis cathode par cathode dans l'ordre croissant.
+ *       Une LED est allumée si son anode est une sortie au niveau haut et
+ *       sa cathode une sortie au niveau bas.
+ */
+template <uint8_t N>
+void observe(CharlieLedBank<N> &leds, uint8_t *lit) {
+
+    const uint8_t ALL = (1 << N) - 1;
+
+    memset(lit, 0, (N * (N - 1) + 7) / 8);
+
+    for (uint8_t slot=0; slot<N; slot++) {
+
+        leds.refresh();
+
+        uint8_t ddr  = DDRC & ALL;
+        uint8_t port = PORTC & ALL;
+
+        CHECK_EQUAL(OTHERS, DDRC & ~ALL);
+        CHECK_EQUAL(OTHERS, PORTC & ~ALL);
+
+        // Une seule broche au niveau haut : l'anode du slot.
+        CHECK(port && !(port & (port - 1)));
+        // Les broches au niveau bas en sortie sont des cathodes ; le niveau
+        // haut n'est en sortie que s'il y a au moins une cathode.
+        CHECK(!ddr || (ddr & port));
+        CHECK(ddr != port);
+
+        uint8_t led = 0;
+
+        for (uint8_t a=0; a<N; a++) {
+            for (uint8_t c=0; c<N; c++) {
+
+                if (c == a) continue;
+
+                bool on = (ddr & _BV(a)) && (port & _BV(a)) && (ddr & _BV(c)) && !(port & _BV(c));
+
+                if (on) {
+                    // Chaque LED n'est allumée que dans un seul slot.
+                    CHECK(!(lit[led >> 3] & _BV(led & 0x7)));
+                    lit[led >> 3] |= _BV(led & 0x7);
+                }
+
+                led++;
+
+            }
+        }
+
+    }
+
+}
+
+template <uint8_t N>
+void testSingleLeds() {
+
+    const uint8_t SIZE = N * (N - 1);
+
+    CharlieLedBank<N> leds(DDRC, PORTC);
+    uint8_t           frame[4], lit[4];
+
+    DDRC  = OTHERS | ((1 << N) - 1);
+    PORTC = OTHERS | ((1 << N) - 1);
+
+    leds.begin(200);
+
+    CHECK_EQUAL(OTHERS, DDRC);
+    CHECK_EQUAL(OTHERS, PORTC);
+
+    // Chaque LED seule : exactement deux broches en sortie dans son slot,
+    // l'anode au niveau haut et la cathode au niveau bas, les autres en
+    // haute impédance ; aucune broche en sortie dans les autres slots.
+    for (uint8_t i=0; i<SIZE; i++) {
+
+        memset(frame, 0, sizeof(frame));
+        frame[i >> 3] = _BV(i & 0x7);
+
+        leds.write(frame);
+
+        uint8_t outputs = 0;
+
+        for (uint8_t slot=0; slot<N; slot++) {
+
+            leds.refresh();
+
+            uint8_t ddr  = DDRC & ((1 << N) - 1);
+            uint8_t port = PORTC & ((1 << N) - 1);
+
+            if (!ddr) continue;
+
+            outputs++;
+
+            CHECK_EQUAL(2, __builtin_popcount(ddr));
+            CHECK_EQUAL(1, __builtin_popcount(ddr & port));
+            CHECK_EQUAL(port, ddr & port);
+
+        }
+
+        CHECK_EQUAL(1, outputs);
+
+        observe(leds, lit);
+
+        for (uint8_t b=0; b<(SIZE + 7) / 8; b++) CHECK_EQUAL(frame[b], lit[b]);
+
+    }
+
+    leds.end();
+
+    CHECK_EQUAL(OTHERS, DDRC);
+    CHECK_EQUAL(OTHERS, PORTC & ~((1 << N) - 1));
+
+}
+
+template <uint8_t N>
+void testFrames() {
+
+    const uint8_t SIZE = N * (N - 1);
+
+    CharlieLedBank<N> leds(DDRC, PORTC);
+    uint8_t           frame[4], lit[4];
+
+    DDRC  = OTHERS;
+    PORTC = OTHERS;
+
+    leds.begin(200);
+
+    // Images quelconques : les LEDs allumées sont exactement celles de l'image.
+    for (uint16_t k=0; k<300; k++) {
+
+        memset(frame, 0, sizeof(frame));
+        for (uint8_t i=0; i<SIZE; i++) {
+            if ((i * 7 + k * 13) % 5 < 2 || k % 17 == 0) frame[i >> 3] |= _BV(i & 0x7);
+        }
+
+        leds.write(frame);
+        observe(leds, lit);
+
+        for (uint8_t b=0; b<(SIZE + 7) / 8; b++) CHECK_EQUAL(frame[b], lit[b]);
+
+    }
+
+}
+
+void testRefreshRate() {
+
+    // 5 slots à 200 Hz : 1000 Hz, soit 62 périodes de 16 µs.
+    CHECK_EQUAL(61, CharlieLedBank<5>::ocrFor(200));
+
+    // OCR2A n'a que 8 bits : 245 Hz au minimum pour les slots.
+    CHECK_EQUAL(254, CharlieLedBank<5>::ocrFor(49));
+    CHECK_EQUAL(255, CharlieLedBank<5>::ocrFor(48));
+    CHECK_EQUAL(255, CharlieLedBank<5>::ocrFor(10));
+    CHECK_EQUAL(255, CharlieLedBank<5>::ocrFor(0));
+    CHECK_EQUAL(255, CharlieLedBank<2>::ocrFor(1));
+
+    // Et 62,5 kHz au maximum.
+    CHECK_EQUAL(0, CharlieLedBank<5>::ocrFor(12500));
+    CHECK_EQUAL(0, CharlieLedBank<6>::ocrFor(60000));
+
+}
+
+int main() {
+
+    testSingleLeds<2>();
+    testSingleLeds<3>();
+    testSingleLeds<5>();
+    testSingleLeds<6>();
+
+    testFrames<3>();
+    testFrames<5>();
+    testFrames<6>();
+
+    testRefreshRate();
+
+    return checkReport("charlie_led_bank");
+
+}
\ No newline at end of file
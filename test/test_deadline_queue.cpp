@@ -0,0 +1,176 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe DeadlineQueue, comparée à un modèle naïf qui recherche
+ * l'échéance la plus proche parmi toutes les échéances programmées
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+
+// Avec une capacité de 1, GCC signale la lecture de cases non initialisées
+// de _due et _id dans _siftDown() et _remove(), sur des chemins que la
+// borne _size rend impossibles : fausse alerte, limitée à cette inclusion.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <DeadlineQueue.h>
+#pragma GCC diagnostic pop
+#include <stdlib.h>
+
+/**
+ * @brief Modèle naïf : la date de chaque échéance, et un indicateur de programmation.
+ */
+template <uint8_t CAPACITY>
+struct Model {
+
+    uint32_t due[CAPACITY];
+    bool     scheduled[CAPACITY];
+
+    Model() {
+        memset(due, 0, sizeof(due));
+        memset(scheduled, 0, sizeof(scheduled));
+    }
+
+    uint8_t size() const {
+
+        uint8_t n = 0;
+        for (uint16_t id=0; id<CAPACITY; id++) n += scheduled[id];
+
+        return n;
+
+    }
+
+    /**
+     * @brief Date de l'échéance la plus proche, parmi celles qui sont programmées.
+     */
+    bool earliest(uint32_t &date) const {
+
+        bool found = false;
+
+        for (uint16_t id=0; id<CAPACITY; id++) {
+            if (!scheduled[id]) continue;
+            if (!found || (int32_t) (due[id] - date) < 0) date = due[id];
+            found = true;
+        }
+
+        return found;
+
+    }
+
+};
+
+/**
+ * @brief Confronte la file et le modèle au cours d'une suite d'opérations aléatoires.
+ *
+ * @param start Date de départ de l'horloge.
+ * @param steps Nombre d'opérations.
+ */
+template <uint8_t CAPACITY>
+void bruteForce(const uint32_t start, const uint32_t steps) {
+
+    DeadlineQueue<CAPACITY> queue;
+    Model<CAPACITY>         model;
+    uint32_t                now = start;
+
+    for (uint32_t step=0; step<steps; step++) {
+
+        uint8_t  id = rand() % CAPACITY;
+        uint32_t date;
+
+        switch (rand() % 8) {
+
+            case 0: case 1: case 2: case 3:
+                // Échéances de 0 à 999 ms, parfois déjà passées.
+                date = now + rand() % 1000 - 50;
+                queue.schedule(id, date);
+                model.due[id]       = date;
+                model.scheduled[id] = true;
+                break;
+
+            case 4:
+                queue.cancel(id);
+                model.scheduled[id] = false;
+                break;
+
+            default:
+                now += rand() % 200;
+                while (queue.expired(now, id)) {
+                    uint32_t earliest = 0;
+                    CHECK(model.earliest(earliest));
+                    CHECK(model.scheduled[id]);
+                    // Ex æquo : n'importe laquelle des échéances de même date.
+                    CHECK_EQUAL(earliest, model.due[id]);
+                    CHECK((int32_t) (now - model.due[id]) >= 0);
+                    model.scheduled[id] = false;
+                }
+                uint32_t earliest = 0;
+                if (model.earliest(earliest)) {
+                    CHECK((int32_t) (earliest - now) > 0);
+                    CHECK_EQUAL(earliest, queue.next());
+                }
+                break;
+
+        }
+
+        CHECK_EQUAL(model.size(), queue.size());
+
+        for (uint16_t i=0; i<CAPACITY; i++) CHECK_EQUAL(model.scheduled[i], queue.isScheduled(i));
+
+        if (check_failures) return;
+
+    }
+
+}
+
+/**
+ * @brief Programme toutes les échéances, puis les extrait : elles doivent sortir dans l'ordre.
+ */
+template <uint8_t CAPACITY>
+void fillAndDrain(const uint32_t start) {
+
+    DeadlineQueue<CAPACITY> queue;
+
+    // Dates distinctes, programmées dans le désordre.
+    for (uint16_t i=0; i<CAPACITY; i++) queue.schedule(i, start + (i * 97) % CAPACITY);
+
+    CHECK_EQUAL(CAPACITY, queue.size());
+
+    uint8_t  id;
+    uint16_t drained = 0;
+    uint32_t last    = start;
+
+    while (drained <= CAPACITY && queue.expired(start + CAPACITY, id)) {
+        uint32_t date = start + (id * 97) % CAPACITY;
+        CHECK((int32_t) (date - last) >= 0);
+        last = date;
+        drained++;
+    }
+
+    CHECK_EQUAL(CAPACITY, drained);
+    CHECK_EQUAL(0, queue.size());
+
+}
+
+int main() {
+
+    srand(42);
+
+    // Capacité maximale : les enfants des positions 127 et au-delà dépassent 255.
+    fillAndDrain<254>(0);
+    fillAndDrain<254>(0xFFFFFF80);
+    fillAndDrain<120>(0);
+    fillAndDrain<1>(0);
+
+    bruteForce<1>(0, 2000);
+    bruteForce<7>(0, 20000);
+    bruteForce<64>(0xFFFF0000, 50000);
+    bruteForce<254>(0xFFFF0000, 50000);
+
+    return checkReport("deadline_queue");
+
+}
\ No newline at end of file
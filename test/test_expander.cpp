@@ -0,0 +1,244 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test des classes Mcp23017, ExpanderLedBank et ExpanderButtons : le bus
+ * I2C est simulé (voir host/Wire.h), et chaque transaction y est relevée
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <ExpanderLedBank.h>
+#include <ExpanderButtons.h>
+
+/**
+ * @brief Adresse du composant sur le bus.
+ */
+const uint8_t ADDRESS = 0x20;
+
+/**
+ * @brief Remet le bus à zéro, avec un MCP23017 à l'adresse ADDRESS.
+ */
+void reset() {
+    Wire.device = ADDRESS;
+    Wire.reset();
+}
+
+/**
+ * @brief Valeur 16 bits d'un couple de registres (port A, port B).
+ */
+uint16_t reg16(const uint8_t reg) {
+    return Wire.registers[reg] | Wire.registers[reg + 1] << 8;
+}
+
+/**
+ * @brief Dernière séquence émise sur le bus.
+ */
+const TwoWire::Sequence &last() {
+    return Wire.log[Wire.sequences - 1];
+}
+
+/**
+ * @brief Nombre de lectures émises sur le bus.
+ */
+uint16_t reads() {
+
+    uint16_t n = 0;
+    for (uint16_t i=0; i<Wire.sequences; i++) n += Wire.log[i].read;
+
+    return n;
+
+}
+
+/**
+ * @brief Niveau des broches du composant : les registres GPIOA et GPIOB
+ *        les présentent après application de la polarité (IPOLA, IPOLB).
+ */
+void setPins(const uint16_t levels) {
+
+    uint16_t gpio = levels ^ reg16(Mcp23017::IPOLA);
+
+    Wire.registers[Mcp23017::GPIOA]     = gpio;
+    Wire.registers[Mcp23017::GPIOA + 1] = gpio >> 8;
+
+}
+
+void testChipBegin() {
+
+    reset();
+
+    Mcp23017 chip(ADDRESS);
+
+    chip.begin();
+
+    // Bus à 400 kHz, IOCON écrit en une transaction de 2 octets.
+    CHECK(Wire.begun);
+    CHECK_EQUAL(400000, Wire.clock_hz);
+    CHECK_EQUAL(1, Wire.transactions);
+    CHECK_EQUAL(ADDRESS, last().address);
+    CHECK_EQUAL(Mcp23017::IOCON, last().reg);
+    CHECK_EQUAL(2, last().length);
+    CHECK_EQUAL(0x44, Wire.registers[Mcp23017::IOCON]);
+    CHECK_EQUAL(1, chip.transactions());
+
+}
+
+void testLedBankBegin() {
+
+    reset();
+
+    Mcp23017        chip(ADDRESS);
+    ExpanderLedBank bank(chip, 12);
+
+    bank.begin();
+
+    // Les 12 LEDs en sortie, éteintes : deux rafales de 2 octets.
+    CHECK_EQUAL(2, Wire.transactions);
+    CHECK_EQUAL(2, Wire.sequences);
+    CHECK_EQUAL(3, Wire.log[0].length);
+    CHECK_EQUAL(3, Wire.log[1].length);
+    CHECK_EQUAL(0xF000, reg16(Mcp23017::IODIRA));
+    CHECK_EQUAL(0x0000, reg16(Mcp23017::OLATA));
+
+}
+
+void testOneBurstPerChangedFrame() {
+
+    reset();
+
+    Mcp23017        chip(ADDRESS);
+    ExpanderLedBank bank(chip, 16);
+
+    bank.begin();
+
+    uint8_t frame[2] = { 0x01, 0x80 };
+
+    // Une image modifiée : une seule rafale, registre OLATA puis 2 octets.
+    bank.write(frame);
+
+    CHECK_EQUAL(3, Wire.transactions);
+    CHECK_EQUAL(ADDRESS, last().address);
+    CHECK(!last().read);
+    CHECK(last().stop);
+    CHECK_EQUAL(Mcp23017::OLATA, last().reg);
+    CHECK_EQUAL(3, last().length);
+    CHECK_EQUAL(0x8001, reg16(Mcp23017::OLATA));
+
+    // Une image identique : aucune transaction.
+    bank.write(frame);
+    bank.write(frame);
+
+    CHECK_EQUAL(3, Wire.transactions);
+
+    // Chaque nouvelle image, et elle seule, coûte une rafale.
+    for (uint8_t i=0; i<16; i++) {
+
+        frame[0] = 1 << (i & 7);
+        frame[1] = i;
+        bank.write(frame);
+        bank.write(frame);
+
+        CHECK_EQUAL(frame[0] | frame[1] << 8, reg16(Mcp23017::OLATA));
+
+    }
+
+    CHECK_EQUAL(19, Wire.transactions);
+    CHECK_EQUAL(19, Wire.sequences);
+    CHECK_EQUAL(0, reads());
+    CHECK_EQUAL(Wire.transactions, chip.transactions());
+
+}
+
+void testSmallBankIgnoresSecondByte() {
+
+    reset();
+
+    Mcp23017        chip(ADDRESS);
+    ExpanderLedBank bank(chip, 8);
+
+    bank.begin();
+
+    uint8_t frame[2] = { 0x00, 0xFF };
+
+    // Seul le premier octet compte : l'image est identique à l'état initial.
+    bank.write(frame);
+
+    CHECK_EQUAL(2, Wire.transactions);
+
+}
+
+void testButtonsReadOnlyOnInterrupt() {
+
+    reset();
+
+    const uint8_t INT_PIN = 2;
+
+    Mcp23017        chip(ADDRESS);
+    ExpanderButtons buttons(chip, INT_PIN);
+
+    // Boutons relâchés : entrées au niveau haut, grâce aux résistances de rappel.
+    host_pins[INT_PIN] = HIGH;
+
+    buttons.begin(0x000F);
+
+    CHECK_EQUAL(0x000F, reg16(Mcp23017::GPPUA));
+    CHECK_EQUAL(0x000F, reg16(Mcp23017::IPOLA));
+    CHECK_EQUAL(0x000F, reg16(Mcp23017::GPINTENA));
+
+    // Cinq écritures, puis une lecture des deux ports : registre GPIOA sans
+    // stop (redémarrage), puis 2 octets lus, en une seule transaction.
+    CHECK_EQUAL(6, Wire.transactions);
+    CHECK_EQUAL(7, Wire.sequences);
+    CHECK_EQUAL(1, reads());
+    CHECK(!Wire.log[5].stop);
+    CHECK_EQUAL(1, Wire.log[5].length);
+    CHECK_EQUAL(Mcp23017::GPIOA, Wire.log[5].reg);
+    CHECK(Wire.log[6].read);
+    CHECK_EQUAL(2, Wire.log[6].length);
+    CHECK_EQUAL(Mcp23017::GPIOA, Wire.log[6].reg);
+    CHECK_EQUAL(Wire.transactions, chip.transactions());
+
+    // INT au repos (niveau haut) : aucune transaction sur le bus.
+    setPins(0xFFFF);
+
+    for (uint8_t i=0; i<100; i++) CHECK(!buttons.sample());
+
+    CHECK_EQUAL(6, Wire.transactions);
+    CHECK_EQUAL(0, buttons.input(1));
+
+    // Bouton 1 enfoncé : INT passe au niveau bas, une seule lecture des deux ports.
+    setPins(0xFFFD);
+    host_pins[INT_PIN] = LOW;
+
+    CHECK(buttons.sample());
+    CHECK_EQUAL(7, Wire.transactions);
+    CHECK_EQUAL(2, reads());
+    CHECK_EQUAL(2, last().length);
+    CHECK_EQUAL(1, buttons.input(1));
+    CHECK_EQUAL(0, buttons.input(0));
+
+    // La lecture acquitte l'interruption : INT remonte, plus aucune lecture.
+    host_pins[INT_PIN] = HIGH;
+
+    CHECK(!buttons.sample());
+    CHECK_EQUAL(7, Wire.transactions);
+    CHECK_EQUAL(1, buttons.input(1));
+    CHECK_EQUAL(Wire.transactions, chip.transactions());
+
+}
+
+int main() {
+
+    testChipBegin();
+    testLedBankBegin();
+    testOneBurstPerChangedFrame();
+    testSmallBankIgnoresSecondByte();
+    testButtonsReadOnlyOnInterrupt();
+
+    return checkReport("expander");
+
+}
\ No newline at end of file
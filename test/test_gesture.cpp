@@ -0,0 +1,166 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe Gesture, sur un bouton virtuel sans déparasitage
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <Gesture.h>
+
+/**
+ * @brief Bouton sans déparasitage : la sortie recopie l'entrée.
+ */
+class RawButton : public Button {
+
+    protected:
+
+        void _debounce(const uint8_t input) override {
+            _output = input;
+        }
+
+};
+
+/**
+ * @brief Nombre maximal de gestes relevés.
+ */
+const uint8_t MAX_EVENTS = 16;
+
+/**
+ * @brief Gestes relevés.
+ */
+struct Events {
+    GestureEvent list[MAX_EVENTS];
+    uint8_t      count;
+} events;
+
+/**
+ * @brief Maintient le bouton à un niveau pendant `duration_ms`, une lecture par milliseconde.
+ */
+void hold(RawButton &button, Gesture &gesture, const uint8_t level, const uint16_t duration_ms) {
+
+    for (uint16_t i=0; i<duration_ms; i++) {
+
+        button.read(level);
+
+        GestureEvent event = gesture.update(host_micros / 1000);
+
+        if (event != GestureEvent::none && events.count < MAX_EVENTS) events.list[events.count++] = event;
+
+        host_micros += 1000;
+
+    }
+
+}
+
+void reset() {
+    memset(&events, 0, sizeof(events));
+}
+
+void testClick() {
+
+    reset();
+
+    RawButton button;
+    Gesture   gesture(button);
+
+    hold(button, gesture, 1, 100);
+    hold(button, gesture, 0, 400);
+
+    CHECK_EQUAL(1, events.count);
+    CHECK(events.list[0] == GestureEvent::click);
+
+}
+
+void testDoubleClick() {
+
+    reset();
+
+    RawButton button;
+    Gesture   gesture(button);
+
+    hold(button, gesture, 1, 100);
+    hold(button, gesture, 0, 100);
+    hold(button, gesture, 1, 100);
+    hold(button, gesture, 0, 400);
+
+    CHECK_EQUAL(1, events.count);
+    CHECK(events.list[0] == GestureEvent::doubleClick);
+
+}
+
+void testLongPressAndRepeat() {
+
+    reset();
+
+    RawButton button;
+    Gesture   gesture(button);
+
+    // 500 ms d'appui long, puis 200 + 150 ms de répétitions.
+    hold(button, gesture, 1, 860);
+    hold(button, gesture, 0, 400);
+
+    CHECK_EQUAL(3, events.count);
+    CHECK(events.list[0] == GestureEvent::longPress);
+    CHECK(events.list[1] == GestureEvent::repeat);
+    CHECK(events.list[2] == GestureEvent::repeat);
+    CHECK_EQUAL(2, gesture.repeats());
+
+}
+
+void testClickThenLongPress() {
+
+    reset();
+
+    RawButton button;
+    Gesture   gesture(button);
+
+    // Clic, puis appui long dans le délai de double clic : le clic en
+    // attente n'est pas avalé par l'appui long.
+    hold(button, gesture, 1, 100);
+    hold(button, gesture, 0, 100);
+    hold(button, gesture, 1, 600);
+    hold(button, gesture, 0, 400);
+
+    CHECK_EQUAL(2, events.count);
+    CHECK(events.list[0] == GestureEvent::click);
+    CHECK(events.list[1] == GestureEvent::longPress);
+
+}
+
+void testClickThenLongPressReleasedAtOnce() {
+
+    reset();
+
+    RawButton button;
+    Gesture   gesture(button);
+
+    // Le second appui est relâché à la lecture même qui suit l'émission du
+    // clic en attente : l'appui long est tout de même émis.
+    hold(button, gesture, 1, 100);
+    hold(button, gesture, 0, 100);
+    hold(button, gesture, 1, 501);
+    hold(button, gesture, 0, 400);
+
+    CHECK_EQUAL(2, events.count);
+    CHECK(events.list[0] == GestureEvent::click);
+    CHECK(events.list[1] == GestureEvent::longPress);
+
+}
+
+int main() {
+
+    testClick();
+    testDoubleClick();
+    testLongPressAndRepeat();
+    testClickThenLongPress();
+    testClickThenLongPressReleasedAtOnce();
+
+    return checkReport("gesture");
+
+}
\ No newline at end of file
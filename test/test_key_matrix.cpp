@@ -0,0 +1,218 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe KeyMatrix, sur un clavier simulé de 3 x 3 touches : les
+ * lignes sont relevées par store(), à la place de la routine d'interruption
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <KeyMatrix.h>
+#include <KuhnButton.h>
+
+typedef KeyMatrix<3, 3, KuhnButton> Keypad;
+
+const uint8_t ROW_PINS[] = { 2, 3, 4 };
+const uint8_t COL_PINS[] = { 5, 6, 7 };
+
+/**
+ * @brief Nombre de lectures franches nécessaires à KuhnButton.
+ */
+const uint8_t THRESHOLD = 16;
+
+/**
+ * @brief Balayages complets d'un clavier dont les colonnes enfoncées de chaque ligne sont `raw`.
+ */
+void scan(Keypad &keypad, const uint8_t *raw, const uint8_t scans = 1) {
+
+    for (uint8_t s=0; s<scans; s++) {
+        for (uint8_t r=0; r<3; r++) keypad.store(raw[keypad.row()]);
+    }
+
+}
+
+/**
+ * @brief Balaye et traite `scans` fois, et renvoie le nombre d'événements émis.
+ */
+uint8_t run(Keypad &keypad, const uint8_t *raw, const uint8_t scans) {
+
+    uint8_t        events = 0;
+    Keypad::Event  event;
+
+    for (uint8_t s=0; s<scans; s++) {
+        scan(keypad, raw);
+        keypad.update();
+        while (keypad.nextEvent(event)) events++;
+    }
+
+    return events;
+
+}
+
+void testDebounce() {
+
+    Keypad   keypad(ROW_PINS, COL_PINS);
+    PinSetup pins;
+
+    keypad.configure(pins);
+    keypad.begin(1000);
+
+    const uint8_t idle[3]    = { 0, 0, 0 };
+    const uint8_t key5[3]    = { 0, 0b100, 0 };
+    Keypad::Event event;
+
+    CHECK(!keypad.update());
+
+    // Rebonds : un balayage sur deux, l'intégrateur ne décolle pas.
+    for (uint8_t i=0; i<20; i++) CHECK_EQUAL(0, run(keypad, i & 0x1 ? idle : key5, 1));
+
+    CHECK(keypad.key(5).isFree());
+
+    // Appui franc : l'événement n'est émis qu'au seuil de l'intégrateur.
+    CHECK_EQUAL(0, run(keypad, key5, THRESHOLD - 1));
+    CHECK(keypad.key(5).isFree());
+
+    scan(keypad, key5);
+
+    CHECK(keypad.update());
+    CHECK(keypad.key(5).isPressed());
+    CHECK(keypad.nextEvent(event));
+    CHECK_EQUAL(5, event.key);
+    CHECK(event.pressed);
+    CHECK(!keypad.nextEvent(event));
+
+    // Les autres touches ne bougent pas.
+    for (uint8_t k=0; k<Keypad::SIZE; k++) {
+        if (k != 5) CHECK(keypad.key(k).isFree());
+    }
+
+    CHECK_EQUAL(0, run(keypad, key5, 30));
+    CHECK(keypad.key(5).isHeld());
+
+    // Relâchement : même seuil dans l'autre sens.
+    CHECK_EQUAL(0, run(keypad, idle, THRESHOLD - 1));
+
+    scan(keypad, idle);
+    keypad.update();
+
+    CHECK(keypad.key(5).isReleased());
+    CHECK(keypad.nextEvent(event));
+    CHECK_EQUAL(5, event.key);
+    CHECK(!event.pressed);
+
+    // Le bloc atomique a restauré les interruptions.
+    CHECK(SREG & _BV(SREG_I));
+
+    keypad.end();
+
+}
+
+void testGhostRejection() {
+
+    Keypad  keypad(ROW_PINS, COL_PINS);
+    Keypad::Event event;
+
+    // Touches 0 et 1 (ligne 0), enfoncées et stables.
+    const uint8_t two[3]   = { 0b011, 0, 0 };
+    // Touche 3 en plus (ligne 1, colonne 0) : la touche 4 apparaît aussi.
+    const uint8_t ghost[3] = { 0b011, 0b011, 0 };
+    // Touche 2 en plus (ligne 0, colonne 2) : aucune ambiguïté.
+    const uint8_t three[3] = { 0b111, 0, 0 };
+
+    CHECK_EQUAL(2, run(keypad, two, THRESHOLD + 5));
+    CHECK(!Keypad::isAmbiguous(two));
+    CHECK(Keypad::isAmbiguous(ghost));
+
+    // Configuration ambiguë : balayages ignorés, état précédent conservé.
+    CHECK_EQUAL(0, run(keypad, ghost, 3 * THRESHOLD));
+    CHECK(keypad.isGhosting());
+    CHECK(keypad.key(0).isHeld());
+    CHECK(keypad.key(1).isHeld());
+    CHECK(keypad.key(3).isFree());
+    CHECK(keypad.key(4).isFree());
+
+    // Fin de l'ambiguïté : le balayage est de nouveau pris en compte.
+    CHECK_EQUAL(1, run(keypad, three, THRESHOLD + 1));
+    CHECK(!keypad.isGhosting());
+    CHECK(keypad.key(2).isHeld());
+    CHECK(keypad.key(4).isFree());
+
+    // Plusieurs appuis simultanés : un événement par touche, dans l'ordre des indices.
+    const uint8_t idle[3] = { 0, 0, 0 };
+    const uint8_t diag[3] = { 0b001, 0b010, 0b100 };
+
+    run(keypad, idle, THRESHOLD + 1);
+
+    for (uint8_t s=0; s<THRESHOLD; s++) {
+        scan(keypad, diag);
+        keypad.update();
+    }
+
+    const uint8_t expected[] = { 0, 4, 8 };
+
+    for (uint8_t i=0; i<3; i++) {
+        CHECK(keypad.nextEvent(event));
+        CHECK_EQUAL(expected[i], event.key);
+        CHECK(event.pressed);
+    }
+
+    CHECK(!keypad.nextEvent(event));
+
+}
+
+void testSlowLoop() {
+
+    Keypad        keypad(ROW_PINS, COL_PINS);
+    Keypad::Event event;
+
+    const uint8_t key7[3] = { 0, 0, 0b010 };
+
+    // Trois balayages par passage dans la boucle : le déparasitage suit la
+    // cadence du balayage, pas celle de la boucle.
+    for (uint8_t i=0; i<5; i++) {
+        scan(keypad, key7, 3);
+        CHECK(keypad.update());
+    }
+
+    CHECK(!keypad.nextEvent(event));
+
+    scan(keypad, key7, 3);
+    keypad.update();
+
+    CHECK(keypad.nextEvent(event));
+    CHECK_EQUAL(7, event.key);
+    CHECK(!keypad.update());
+
+    // Au-delà de la capacité de la file, seuls les 3 derniers balayages sont
+    // traités : le relâchement exige alors davantage de balayages.
+    const uint8_t idle[3] = { 0, 0, 0 };
+
+    for (uint8_t i=0; i<5; i++) {
+        scan(keypad, idle, 10);
+        keypad.update();
+    }
+
+    CHECK(!keypad.nextEvent(event));
+
+    scan(keypad, idle, 10);
+    keypad.update();
+
+    CHECK(keypad.nextEvent(event));
+    CHECK(!event.pressed);
+
+}
+
+int main() {
+
+    testDebounce();
+    testGhostRejection();
+    testSlowLoop();
+
+    return checkReport("key_matrix");
+
+}
\ No newline at end of file
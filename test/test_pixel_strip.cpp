@@ -0,0 +1,189 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe PixelStrip : la routine de transmission en assembleur
+ * est remplacée par un relevé des octets émis sur la broche de données
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <PixelStrip.h>
+
+/**
+ * @brief Nombre maximal d'octets relevés.
+ */
+const uint16_t MAX_BYTES = 64 * 3;
+
+/**
+ * @brief Relevé des transmissions.
+ */
+struct Line {
+    uint8_t  bytes[MAX_BYTES]; // Octets émis, dans l'ordre.
+    uint16_t count;            // Nombre d'octets émis.
+    uint8_t  shows;            // Nombre de transmissions.
+    bool     interrupts;       // Transmission avec les interruptions actives.
+    bool     bad_levels;       // Niveaux qui modifient les autres broches du port.
+} line;
+
+void PixelStrip::_transmit(volatile uint8_t *out, uint8_t hi, uint8_t lo, const uint8_t *ptr, uint16_t bytes) {
+
+    if (SREG & _BV(SREG_I)) line.interrupts = true;
+
+    // Les deux niveaux ne diffèrent que par le bit de la broche de données.
+    uint8_t pin = hi ^ lo;
+    if (!pin || (pin & (pin - 1)) || !(hi & pin) || lo != (*out & ~pin)) line.bad_levels = true;
+
+    line.shows++;
+
+    // Les octets sont relevés dans l'ordre d'émission : l'ordre des bits
+    // (poids fort en tête) est celui de la routine en assembleur.
+    while (bytes--) {
+        if (line.count < MAX_BYTES) line.bytes[line.count] = *ptr;
+        line.count++;
+        ptr++;
+    }
+
+}
+
+void reset() {
+    memset(&line, 0, sizeof(line));
+}
+
+void testTransmitTime() {
+
+    uint8_t pixels[3];
+
+    // 167 cycles par octet à 16 MHz, arrondis à la microseconde supérieure.
+    CHECK_EQUAL(1879, PixelStrip(6, pixels, 60).transmitTimeUs());
+    CHECK_EQUAL(32,   PixelStrip(6, pixels, 1).transmitTimeUs());
+    CHECK_EQUAL(2067, PixelStrip(6, pixels, 66).transmitTimeUs());
+    CHECK_EQUAL(0,    PixelStrip(6, pixels, 0).transmitTimeUs());
+
+    // Au-delà de 63 pixels, la transmission dépasse 2 ms.
+    CHECK(PixelStrip(6, pixels, 63).transmitTimeUs() <= 2000);
+    CHECK(PixelStrip(6, pixels, 64).transmitTimeUs() >  2000);
+
+}
+
+void testGrbOrder() {
+
+    reset();
+
+    uint8_t    pixels[4 * 3] = {};
+    PixelStrip strip(6, pixels, 4);
+    PinSetup   pins;
+
+    strip.configure(pins);
+
+    strip.setPixel(0, 0x11, 0x22, 0x33);
+    strip.setPixel(3, 0x80, 0x01, 0xC5);
+    strip.setPixel(4, 0xFF, 0xFF, 0xFF); // Hors du ruban : ignoré.
+
+    CHECK(strip.show());
+
+    const uint8_t expected[] = {
+        0x22, 0x11, 0x33,
+        0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00,
+        0x01, 0x80, 0xC5
+    };
+
+    CHECK_EQUAL(sizeof(expected), line.count);
+    for (uint8_t i=0; i<sizeof(expected); i++) CHECK_EQUAL(expected[i], line.bytes[i]);
+
+    // Interruptions désactivées pendant la transmission, puis restaurées.
+    CHECK(!line.interrupts);
+    CHECK(SREG & _BV(SREG_I));
+
+}
+
+void testPinLevels() {
+
+    reset();
+
+    uint8_t    pixels[3] = {};
+    PixelStrip strip(6, pixels, 1);
+    PinSetup   pins;
+
+    strip.configure(pins);
+
+    // Les autres broches du port D conservent leur niveau.
+    PORTD = 0xA5 & ~_BV(6);
+
+    CHECK(strip.show());
+    CHECK(!line.bad_levels);
+
+}
+
+void testDirtyFlag() {
+
+    reset();
+
+    uint8_t    pixels[2 * 3] = {};
+    PixelStrip strip(6, pixels, 2);
+    PinSetup   pins;
+
+    // Rien n'est transmis tant que la broche n'est pas configurée...
+    CHECK(strip.isDirty());
+    CHECK(!strip.show());
+    CHECK_EQUAL(0, line.shows);
+
+    // ... mais l'image reste à transmettre.
+    strip.configure(pins);
+
+    CHECK(strip.isDirty());
+    CHECK(strip.show());
+    CHECK(!strip.isDirty());
+    CHECK_EQUAL(1, line.shows);
+
+    // Image inchangée : aucune transmission.
+    CHECK(!strip.show());
+    CHECK_EQUAL(1, line.shows);
+
+    strip.setPixel(1, 1, 2, 3);
+
+    CHECK(strip.isDirty());
+    CHECK(strip.show());
+    CHECK_EQUAL(2, line.shows);
+
+    strip.clear();
+
+    CHECK(strip.show());
+    CHECK_EQUAL(3, line.shows);
+    CHECK_EQUAL(18, line.count);
+    for (uint8_t i=12; i<18; i++) CHECK_EQUAL(0, line.bytes[i]);
+
+}
+
+void testEmptyStrip() {
+
+    reset();
+
+    uint8_t    pixels[1];
+    PixelStrip strip(6, pixels, 0);
+    PinSetup   pins;
+
+    strip.configure(pins);
+
+    // La routine exige au moins un octet : un ruban vide n'est jamais transmis.
+    CHECK(!strip.show());
+    CHECK_EQUAL(0, line.shows);
+
+}
+
+int main() {
+
+    testTransmitTime();
+    testGrbOrder();
+    testPinLevels();
+    testDirtyFlag();
+    testEmptyStrip();
+
+    return checkReport("pixel_strip");
+
+}
\ No newline at end of file
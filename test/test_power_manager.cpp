@@ -0,0 +1,104 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test des seuils de décision de la classe PowerManager, et de la routine
+ * d'interruption de réveil
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <PowerManager.h>
+
+/**
+ * @brief Broche de réveil (port D : groupe PCINT2).
+ */
+const uint8_t WAKE_PIN = 2;
+
+POWER_WAKE_INTERRUPT(WAKE_PIN, 2)
+
+/**
+ * @brief Routines d'interruption que la macro ne doit pas définir.
+ *
+ * @note Une définition en double ferait échouer l'édition de liens.
+ */
+ISR(PCINT0_vect) {}
+ISR(PCINT1_vect) {}
+
+void testDecide() {
+
+    // Échéance arrivée : le programme reste actif.
+    CHECK(PowerManager::decide(false, 0) == PowerState::active);
+    CHECK(PowerManager::decide(true,  0) == PowerState::active);
+
+    // Travail en cours : mode idle, quelle que soit l'échéance.
+    CHECK(PowerManager::decide(true, 1)                         == PowerState::idle);
+    CHECK(PowerManager::decide(true, 1000)                      == PowerState::idle);
+    CHECK(PowerManager::decide(true, PowerManager::NO_DEADLINE) == PowerState::idle);
+
+    // Échéance trop proche pour le chien de garde (moins de 16 ms) : mode idle.
+    for (uint32_t ms=1; ms<16; ms++) CHECK(PowerManager::decide(false, ms) == PowerState::idle);
+
+    // Sinon : mode power-down.
+    CHECK(PowerManager::decide(false, 16)                        == PowerState::powerDown);
+    CHECK(PowerManager::decide(false, 8000)                      == PowerState::powerDown);
+    CHECK(PowerManager::decide(false, PowerManager::NO_DEADLINE) == PowerState::powerDown);
+
+}
+
+void testWatchdogStep() {
+
+    // La plus longue période (16 ms x 2^rang) qui n'excède pas l'échéance.
+    CHECK_EQUAL(0, PowerManager::watchdogStep(16));
+    CHECK_EQUAL(0, PowerManager::watchdogStep(31));
+    CHECK_EQUAL(1, PowerManager::watchdogStep(32));
+    CHECK_EQUAL(5, PowerManager::watchdogStep(1000));
+    CHECK_EQUAL(7, PowerManager::watchdogStep(4095));
+    CHECK_EQUAL(8, PowerManager::watchdogStep(4096));
+    CHECK_EQUAL(9, PowerManager::watchdogStep(8192));
+
+    // Plafonnée au rang 9 (8 s).
+    CHECK_EQUAL(9, PowerManager::watchdogStep(60000));
+    CHECK_EQUAL(9, PowerManager::watchdogStep(PowerManager::NO_DEADLINE));
+
+    // Pour toute échéance qui mène au mode power-down, la période n'excède
+    // jamais l'échéance, et la période suivante l'excéderait (sauf au plafond).
+    for (uint32_t ms=16; ms<20000; ms++) {
+
+        uint8_t  step   = PowerManager::watchdogStep(ms);
+        uint32_t period = (uint32_t) PowerManager::MIN_WATCHDOG_MS << step;
+
+        CHECK(step < PowerManager::WATCHDOG_STEPS);
+        CHECK(period <= ms);
+        CHECK(step == PowerManager::WATCHDOG_STEPS - 1 || 2 * period > ms);
+
+        if (check_failures) break;
+
+    }
+
+}
+
+void testWakeGroup() {
+
+    // Groupe PCINT de chaque broche, vérifié par POWER_WAKE_INTERRUPT().
+    for (uint8_t pin=0; pin<8; pin++)   CHECK_EQUAL(2, digitalPinToPCICRbit(pin));
+    for (uint8_t pin=8; pin<14; pin++)  CHECK_EQUAL(0, digitalPinToPCICRbit(pin));
+    for (uint8_t pin=14; pin<20; pin++) CHECK_EQUAL(1, digitalPinToPCICRbit(pin));
+
+    PCINT2_vect();
+
+}
+
+int main() {
+
+    testDecide();
+    testWatchdogStep();
+    testWakeGroup();
+
+    return checkReport("power_manager");
+
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe RecordLog, sur l'EEPROM simulée MemoryEeprom
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <RecordLog.h>
+#include <MemoryEeprom.h>
+
+/**
+ * @brief Enregistrement de test : 3 octets, soit 6 octets par emplacement.
+ */
+struct Record {
+    uint16_t count;
+    uint8_t  flags;
+} __attribute__((packed));
+
+/**
+ * @brief EEPROM de 64 octets, dont 60 (10 emplacements) à partir de l'adresse 4.
+ */
+typedef MemoryEeprom<64>             Eeprom;
+typedef RecordLog<Record, Eeprom>    Log;
+
+const uint16_t BASE        = 4;
+const uint16_t SIZE        = 60;
+const uint8_t  SLOT_SIZE   = sizeof(Record) + 3;
+const uint32_t INTERVAL_MS = 1000;
+
+/**
+ * @brief Mène la sauvegarde en cours à son terme, et renvoie le nombre d'appels de update().
+ */
+uint16_t flush(Log &log, const uint32_t now_ms) {
+
+    uint16_t calls = 0;
+
+    while (log.isBusy() && calls < 1000) {
+        log.update(now_ms);
+        calls++;
+    }
+
+    return calls;
+
+}
+
+/**
+ * @brief Sauvegarde complète d'un enregistrement, à la date `now_ms`.
+ */
+void store(Log &log, const uint16_t count, const uint8_t flags, const uint32_t now_ms) {
+
+    Record record = { count, flags };
+
+    log.save(record);
+    flush(log, now_ms);
+
+}
+
+/**
+ * @brief Nombre total d'écritures subies par la zone du journal.
+ */
+uint32_t totalWrites(const Eeprom &eeprom) {
+
+    uint32_t total = 0;
+    for (uint16_t a=0; a<64; a++) total += eeprom.writes(a);
+
+    return total;
+
+}
+
+void testBlank() {
+
+    Eeprom eeprom;
+    Log    log(eeprom, BASE, SIZE, INTERVAL_MS);
+    Record record = { 7, 7 };
+
+    CHECK_EQUAL(10, log.slots());
+    CHECK(!log.load(record));
+    CHECK_EQUAL(7, record.count);
+
+}
+
+void testFirstSaveWrites() {
+
+    Eeprom eeprom;
+    Log    log(eeprom, BASE, SIZE, INTERVAL_MS);
+
+    store(log, 0x1234, 0xFF, 1000);
+
+    // Séquence 1 (01 00), enregistrement (34 12 FF), CRC : l'octet qui vaut
+    // déjà 0xFF n'est pas réécrit, et une EEPROM vierge n'est jamais effacée.
+    CHECK_EQUAL(1, log.sequence());
+    CHECK_EQUAL(1, eeprom.writes(BASE + 0));
+    CHECK_EQUAL(1, eeprom.writes(BASE + 1));
+    CHECK_EQUAL(1, eeprom.writes(BASE + 2));
+    CHECK_EQUAL(1, eeprom.writes(BASE + 3));
+    CHECK_EQUAL(0, eeprom.writes(BASE + 4));
+    CHECK_EQUAL(1, eeprom.writes(BASE + 5));
+
+    for (uint16_t a=0; a<64; a++) CHECK_EQUAL(0, eeprom.erases(a));
+
+    // Rien n'est écrit en dehors du premier emplacement.
+    CHECK_EQUAL(5, totalWrites(eeprom));
+
+    Log    reader(eeprom, BASE, SIZE, INTERVAL_MS);
+    Record record;
+
+    CHECK(reader.load(record));
+    CHECK_EQUAL(0x1234, record.count);
+    CHECK_EQUAL(0xFF, record.flags);
+    CHECK_EQUAL(1, reader.sequence());
+
+}
+
+void testWearLeveling() {
+
+    Eeprom   eeprom;
+    Log      log(eeprom, BASE, SIZE, INTERVAL_MS);
+    uint32_t now = 0;
+
+    // 100 sauvegardes d'une même valeur sur 10 emplacements.
+    for (uint8_t i=0; i<100; i++) store(log, 0x0101, 0x01, now += INTERVAL_MS);
+
+    CHECK_EQUAL(100, log.sequence());
+
+    // Chaque octet est écrit au plus une fois par tour du journal, et les
+    // octets de l'enregistrement, inchangés, ne le sont qu'une seule fois.
+    CHECK(eeprom.maxWrites() <= 10);
+
+    for (uint8_t s=0; s<10; s++) {
+        uint16_t slot = BASE + s * SLOT_SIZE;
+        CHECK_EQUAL(1, eeprom.writes(slot + 2));
+        CHECK_EQUAL(1, eeprom.writes(slot + 3));
+        CHECK_EQUAL(1, eeprom.writes(slot + 4));
+    }
+
+    // Octets hors de la zone du journal intacts.
+    for (uint16_t a=0; a<BASE; a++) CHECK_EQUAL(0, eeprom.writes(a));
+
+    // Les effacements n'ont lieu que lorsqu'un bit repasse de 0 à 1 : jamais
+    // pour l'enregistrement, qui ne change pas.
+    CHECK_EQUAL(0, eeprom.erases(BASE + 2));
+    CHECK(eeprom.erases(BASE + 0) > 0);
+
+    Log    reader(eeprom, BASE, SIZE, INTERVAL_MS);
+    Record record;
+
+    CHECK(reader.load(record));
+    CHECK_EQUAL(100, reader.sequence());
+
+}
+
+void testRateLimit() {
+
+    Eeprom eeprom;
+    Log    log(eeprom, BASE, SIZE, INTERVAL_MS);
+    Record record = { 1, 0 };
+
+    // Pas de sauvegarde avant le délai minimal, même pour la première.
+    log.save(record);
+
+    for (uint32_t t=0; t<INTERVAL_MS; t+=10) log.update(t);
+
+    CHECK(log.isBusy());
+    CHECK_EQUAL(0, totalWrites(eeprom));
+
+    // Le délai écoulé, l'emplacement est écrit à raison d'un octet par appel.
+    log.update(INTERVAL_MS);
+
+    CHECK_EQUAL(0, totalWrites(eeprom));
+
+    log.update(INTERVAL_MS);
+
+    CHECK_EQUAL(1, totalWrites(eeprom));
+    CHECK(flush(log, INTERVAL_MS) <= SLOT_SIZE);
+    CHECK(!log.isBusy());
+
+    // Demandes rapprochées : rien avant le délai, puis seule la dernière est écrite.
+    for (uint8_t i=2; i<=5; i++) {
+        record.count = i;
+        log.save(record);
+        log.update(INTERVAL_MS + i * 100);
+    }
+
+    uint32_t writes = totalWrites(eeprom);
+
+    log.update(2 * INTERVAL_MS - 1);
+
+    CHECK(log.isBusy());
+    CHECK_EQUAL(writes, totalWrites(eeprom));
+
+    flush(log, 2 * INTERVAL_MS);
+
+    CHECK_EQUAL(2, log.sequence());
+
+    Log reader(eeprom, BASE, SIZE, INTERVAL_MS);
+
+    CHECK(reader.load(record));
+    CHECK_EQUAL(5, record.count);
+
+}
+
+void testSequenceWrapAround() {
+
+    Eeprom   eeprom;
+    Log      log(eeprom, BASE, SIZE, 0);
+    bool     blank   = false;
+    bool     wrapped = false;
+    uint32_t saves   = 0;
+
+    // La séquence fait le tour de 65536 en sautant 0xFFFF (emplacement vierge).
+    do {
+        store(log, saves, 0, 0);
+        if (log.sequence() == 0xFFFF) blank   = true;
+        if (log.sequence() == 0)      wrapped = true;
+        saves++;
+    } while (!wrapped || log.sequence() != 3);
+
+    CHECK(!blank);
+    CHECK_EQUAL(65538, saves);
+
+    // Les emplacements portent maintenant 0xFFF9 ... 0xFFFE, 0, 1, 2 et 3 :
+    // c'est le dernier écrit qui est chargé, malgré son petit numéro.
+    Log    reader(eeprom, BASE, SIZE, 0);
+    Record record;
+
+    CHECK(reader.load(record));
+    CHECK_EQUAL(3, reader.sequence());
+    CHECK_EQUAL((uint16_t) (saves - 1), record.count);
+
+    // Et la sauvegarde suivante repart de là, dans l'emplacement suivant.
+    store(reader, 0xBEEF, 0, 0);
+
+    Log last(eeprom, BASE, SIZE, 0);
+
+    CHECK(last.load(record));
+    CHECK_EQUAL(4, last.sequence());
+    CHECK_EQUAL(0xBEEF, record.count);
+
+}
+
+void testCorruptedSlot() {
+
+    Eeprom   eeprom;
+    Log      log(eeprom, BASE, SIZE, INTERVAL_MS);
+    uint32_t now = 0;
+
+    for (uint8_t i=1; i<=13; i++) store(log, i, i, now += INTERVAL_MS);
+
+    // Le dernier enregistrement (séquence 13) est dans l'emplacement 2.
+    uint16_t slot = BASE + 2 * SLOT_SIZE;
+
+    eeprom.corrupt(slot + 3, eeprom.read(slot + 3) ^ 0x10);
+
+    Log    reader(eeprom, BASE, SIZE, INTERVAL_MS);
+    Record record;
+
+    CHECK(reader.load(record));
+    CHECK_EQUAL(12, reader.sequence());
+    CHECK_EQUAL(12, record.count);
+
+    // La sauvegarde suivante réutilise l'emplacement écarté.
+    store(reader, 99, 0, now += INTERVAL_MS);
+
+    Log again(eeprom, BASE, SIZE, INTERVAL_MS);
+
+    CHECK(again.load(record));
+    CHECK_EQUAL(13, again.sequence());
+    CHECK_EQUAL(99, record.count);
+
+}
+
+void testInterruptedSave() {
+
+    Eeprom eeprom;
+    Log    log(eeprom, BASE, SIZE, INTERVAL_MS);
+
+    store(log, 0x1111, 0x11, INTERVAL_MS);
+
+    // Coupure d'alimentation au milieu de l'écriture de l'emplacement suivant.
+    Record record = { 0x2222, 0x22 };
+
+    log.save(record);
+
+    for (uint8_t i=0; i<4; i++) log.update(2 * INTERVAL_MS);
+
+    CHECK(log.isBusy());
+
+    Log reader(eeprom, BASE, SIZE, INTERVAL_MS);
+
+    CHECK(reader.load(record));
+    CHECK_EQUAL(1, reader.sequence());
+    CHECK_EQUAL(0x1111, record.count);
+
+}
+
+int main() {
+
+    testBlank();
+    testFirstSaveWrites();
+    testWearLeveling();
+    testRateLimit();
+    testSequenceWrapAround();
+    testCorruptedSlot();
+    testInterruptedSave();
+
+    return checkReport("record_log");
+
+}
\ No newline at end of file
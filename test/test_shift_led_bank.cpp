@@ -0,0 +1,201 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test de la classe ShiftLedBank : le SPI et la broche de verrouillage
+ * sont remplacés par une chaîne de 74HC595 simulée
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <ShiftLedBank.h>
+
+/**
+ * @brief Nombre maximal de registres simulés.
+ */
+const uint8_t MAX_REGISTERS = 16;
+
+/**
+ * @brief Chaîne de registres à décalage simulée.
+ *
+ * @note Chaque front d'horloge décale la chaîne d'un bit : l'entrée SER
+ *       arrive sur QA (bit 0) du premier registre, et la sortie QH (bit 7)
+ *       de chaque registre alimente l'entrée du suivant.
+ */
+struct Chain {
+    uint8_t  shift[MAX_REGISTERS];    // Registres à décalage.
+    uint8_t  outputs[MAX_REGISTERS];  // Registres de sortie (verrouillés).
+    uint8_t  sent[MAX_REGISTERS * 2]; // Octets transmis, dans l'ordre.
+    uint8_t  count;                   // Nombre d'octets transmis.
+    uint8_t  pulses;                  // Nombre de fronts montants sur RCLK.
+    bool     latch;                   // Niveau de la broche de verrouillage.
+    bool     late;                    // Octet transmis pendant que RCLK est haut.
+} chain;
+
+void reset() {
+    memset(&chain, 0, sizeof(chain));
+    chain.latch = true;
+}
+
+void clock(const uint8_t bit) {
+
+    uint8_t in = bit;
+
+    for (uint8_t k=0; k<MAX_REGISTERS; k++) {
+        uint8_t out = chain.shift[k] >> 7;
+        chain.shift[k] = (chain.shift[k] << 1) | in;
+        in = out;
+    }
+
+}
+
+void ShiftLedBank::_transfer(const uint8_t byte) {
+
+    if (chain.latch) chain.late = true;
+    if (chain.count < sizeof(chain.sent)) chain.sent[chain.count++] = byte;
+
+    // Ordre des bits fixé par le bit DORD du registre SPCR.
+    bool lsb_first = SPCR & _BV(DORD);
+
+    for (uint8_t i=0; i<8; i++) clock((byte >> (lsb_first ? i : 7 - i)) & 1);
+
+}
+
+void ShiftLedBank::_latch(const bool high) {
+
+    if (high && !chain.latch) {
+        memcpy(chain.outputs, chain.shift, sizeof(chain.outputs));
+        chain.pulses++;
+    }
+
+    chain.latch = high;
+
+}
+
+/**
+ * @brief État de la LED d'indice `index` sur les sorties de la chaîne.
+ */
+bool lit(const uint8_t index) {
+    return chain.outputs[index >> 3] & (1 << (index & 7));
+}
+
+void testNothingBeforeConfigure() {
+
+    reset();
+
+    ShiftLedBank bank(10, 16);
+    uint8_t frame[] = { 0xff, 0xff };
+
+    bank.write(frame);
+
+    CHECK_EQUAL(0, chain.count);
+    CHECK_EQUAL(0, chain.pulses);
+
+}
+
+void testSpiSetup() {
+
+    ShiftLedBank bank(10, 8);
+    PinSetup pins;
+
+    SPCR = _BV(DORD);
+    bank.configure(pins);
+    bank.begin();
+
+    // Maître, bit de poids fort en tête (DORD à 0).
+    CHECK(SPCR & _BV(SPE));
+    CHECK(SPCR & _BV(MSTR));
+    CHECK(!(SPCR & _BV(DORD)));
+
+}
+
+void testFrameOrdering() {
+
+    reset();
+
+    ShiftLedBank bank(10, 64);
+    PinSetup pins;
+
+    bank.configure(pins);
+    bank.begin();
+
+    uint8_t frame[] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+
+    bank.write(frame);
+
+    // Le dernier octet de l'image part en premier.
+    CHECK_EQUAL(8, chain.count);
+    for (uint8_t i=0; i<8; i++) CHECK_EQUAL(frame[7 - i], chain.sent[i]);
+
+    // Une seule impulsion de verrouillage, après le dernier octet.
+    CHECK_EQUAL(1, chain.pulses);
+    CHECK(!chain.late);
+
+    // La LED 8k+j est la sortie Qj du registre k.
+    for (uint8_t i=0; i<64; i++) CHECK_EQUAL(i % 9 == 0, lit(i));
+
+}
+
+void testOneLatchPerFrame() {
+
+    reset();
+
+    ShiftLedBank bank(10, 24);
+    PinSetup pins;
+
+    bank.configure(pins);
+    bank.begin();
+
+    for (uint8_t n=0; n<10; n++) {
+        uint8_t frame[] = { n, (uint8_t) ~n, (uint8_t) (n << 4) };
+        bank.write(frame);
+        CHECK_EQUAL(n + 1, chain.pulses);
+        CHECK_EQUAL(n, chain.outputs[0]);
+        CHECK_EQUAL((uint8_t) ~n, chain.outputs[1]);
+        CHECK_EQUAL((uint8_t) (n << 4), chain.outputs[2]);
+    }
+
+    CHECK(!chain.late);
+
+}
+
+void testLightAndShow() {
+
+    reset();
+
+    ShiftLedBank bank(10, 16);
+    PinSetup pins;
+
+    bank.configure(pins);
+    bank.begin();
+
+    bank.light(3, true);
+    bank.light(12, true);
+    bank.toggle(15);
+    bank.toggle(12);
+
+    // L'image courante n'est transmise qu'à l'appel de show().
+    CHECK_EQUAL(0, chain.pulses);
+
+    bank.show();
+
+    CHECK_EQUAL(1, chain.pulses);
+    for (uint8_t i=0; i<16; i++) CHECK_EQUAL(i == 3 || i == 15, lit(i));
+
+}
+
+int main() {
+
+    testNothingBeforeConfigure();
+    testSpiSetup();
+    testFrameOrdering();
+    testOneLatchPerFrame();
+    testLightAndShow();
+
+    return checkReport("shift_led_bank");
+
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+/*
+ * -------------------------------------------------------------------------
+ * Atelier de programmation Robotic 974
+ * © 2020 Stéphane Calderoni
+ * -------------------------------------------------------------------------
+ * Introduction à la programmation des cartes Arduino
+ * Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+ * -------------------------------------------------------------------------
+ * Test du tampon circulaire Ring et de l'émission de la classe Uart : la
+ * routine d'interruption est appelée par le test, octet par octet
+ * -------------------------------------------------------------------------
+ */
+
+#include "check.h"
+#include <Uart.h>
+
+/**
+ * @brief Avance les deux indices d'un tampon vide de `steps` positions.
+ */
+template <uint8_t SIZE>
+void advance(Ring<SIZE> &ring, const uint16_t steps) {
+
+    uint8_t byte = 0;
+
+    for (uint16_t i=0; i<steps; i++) {
+        ring.push(0);
+        ring.pop(byte);
+    }
+
+}
+
+/**
+ * @brief Remplit un tampon dont les indices valent `start`, puis le vide :
+ *        les bornes plein / vide et l'ordre des octets ne dépendent pas des
+ *        indices, même lorsqu'ils repassent par 0.
+ */
+template <uint8_t SIZE>
+void fillAndDrain(const uint8_t start) {
+
+    Ring<SIZE> ring;
+    uint8_t    byte = 0;
+
+    advance(ring, start);
+
+    CHECK(ring.isEmpty());
+    CHECK(!ring.isFull());
+    CHECK_EQUAL(SIZE, ring.space());
+    CHECK(!ring.pop(byte));
+
+    for (uint16_t i=0; i<SIZE; i++) {
+        CHECK(!ring.isFull());
+        CHECK(ring.push(i + 1));
+        CHECK_EQUAL(i + 1, ring.size());
+    }
+
+    // Les SIZE octets sont utilisables : le tampon n'est plein qu'à SIZE.
+    CHECK(ring.isFull());
+    CHECK(!ring.isEmpty());
+    CHECK_EQUAL(SIZE, ring.size());
+    CHECK_EQUAL(0, ring.space());
+    CHECK(!ring.push(0xEE));
+    CHECK_EQUAL(SIZE, ring.size());
+
+    for (uint16_t i=0; i<SIZE; i++) {
+        CHECK(ring.pop(byte));
+        CHECK_EQUAL((uint8_t) (i + 1), byte);
+    }
+
+    CHECK(ring.isEmpty());
+    CHECK(!ring.pop(byte));
+
+}
+
+void testRingBoundaries() {
+
+    // Indices de départ choisis pour que le remplissage franchisse 255.
+    const uint8_t STARTS[] = { 0, 1, 127, 128, 200, 250, 255 };
+
+    for (uint8_t start : STARTS) {
+        fillAndDrain<1>(start);
+        fillAndDrain<4>(start);
+        fillAndDrain<64>(start);
+        fillAndDrain<128>(start);
+    }
+
+}
+
+void testRingWrapAround() {
+
+    Ring<8>  ring;
+    uint8_t  byte = 0;
+    uint8_t  next_in  = 0;
+    uint8_t  next_out = 0;
+
+    // Remplissages et vidages partiels sur plusieurs tours des indices.
+    for (uint16_t round=0; round<1000; round++) {
+
+        uint8_t in  = round % 7 + 1;
+        uint8_t out = round % 5 + 1;
+
+        for (uint8_t i=0; i<in; i++) {
+            if (ring.push(next_in)) next_in++;
+        }
+
+        CHECK_EQUAL((uint8_t) (next_in - next_out), ring.size());
+        CHECK(ring.size() <= 8);
+
+        for (uint8_t i=0; i<out && ring.pop(byte); i++) {
+            CHECK_EQUAL(next_out, byte);
+            next_out++;
+        }
+
+        CHECK_EQUAL((uint8_t) (next_in - next_out), ring.size());
+
+    }
+
+}
+
+void testRingBulkPush() {
+
+    Ring<8> ring;
+    uint8_t data[20];
+    uint8_t byte = 0;
+
+    for (uint8_t i=0; i<20; i++) data[i] = 0x40 + i;
+
+    advance(ring, 254);
+
+    ring.push(0x01);
+    ring.push(0x02);
+    ring.push(0x03);
+
+    // 5 places libres : seuls les 5 premiers octets sont déposés.
+    CHECK_EQUAL(5, ring.push(data, 20));
+    CHECK(ring.isFull());
+    CHECK_EQUAL(0, ring.push(data, 20));
+    CHECK_EQUAL(0, ring.push(data, 0));
+
+    const uint8_t expected[] = { 0x01, 0x02, 0x03, 0x40, 0x41, 0x42, 0x43, 0x44 };
+
+    for (uint8_t i=0; i<8; i++) {
+        CHECK(ring.pop(byte));
+        CHECK_EQUAL(expected[i], byte);
+    }
+
+    CHECK(ring.isEmpty());
+
+}
+
+/**
+ * @brief Relevé des octets émis par la routine d'interruption.
+ */
+struct Line {
+    uint8_t  bytes[1024];
+    uint16_t count;
+} line;
+
+/**
+ * @brief Appelle la routine d'interruption jusqu'à `bytes` fois, tant que
+ *        l'interruption d'émission est active, et relève les octets émis.
+ *
+ * @note La routine n'écrit TXC0 (pour l'effacer) que lorsqu'elle émet un
+ *       octet : le bit est remis à 0 avant chaque appel pour le savoir.
+ */
+void drain(Uart &uart, const uint16_t bytes) {
+
+    for (uint16_t i=0; i<bytes && (UCSR0B & _BV(UDRIE0)); i++) {
+
+        UCSR0A = _BV(U2X0);
+        uart.transmit();
+
+        if ((UCSR0A & _BV(TXC0)) && line.count < sizeof(line.bytes)) line.bytes[line.count++] = UDR0;
+
+    }
+
+}
+
+void reset() {
+    memset(&line, 0, sizeof(line));
+    SREG = _BV(SREG_I);
+}
+
+void testUartNonBlockingWrite() {
+
+    reset();
+
+    Uart    uart;
+    uint8_t data[300];
+
+    for (uint16_t i=0; i<300; i++) data[i] = i * 7;
+
+    uart.begin(1000000);
+
+    CHECK_EQUAL(1, UBRR0);
+    CHECK_EQUAL(UART_TX_SIZE, uart.availableForWrite());
+    CHECK(!(UCSR0B & _BV(UDRIE0)));
+
+    // Plus d'octets que de places : seuls les premiers sont acceptés, sans attente.
+    CHECK_EQUAL(UART_TX_SIZE, uart.write(data, 300));
+    CHECK_EQUAL(0, uart.availableForWrite());
+    CHECK(UCSR0B & _BV(UDRIE0));
+    CHECK_EQUAL(0, uart.write(0x55));
+    CHECK_EQUAL(0, uart.write(data, 10));
+
+    // La routine d'interruption libère 10 places : une suite de 25 octets
+    // n'est acceptée qu'à hauteur de 10.
+    drain(uart, 10);
+
+    CHECK_EQUAL(10, line.count);
+    CHECK_EQUAL(10, uart.availableForWrite());
+    CHECK_EQUAL(10, uart.write(data + 100, 25));
+    CHECK_EQUAL(0, uart.availableForWrite());
+
+    // Tout est émis dans l'ordre, puis l'interruption d'émission s'arrête.
+    drain(uart, 1000);
+
+    CHECK(!(UCSR0B & _BV(UDRIE0)));
+    CHECK_EQUAL(UART_TX_SIZE + 10, line.count);
+
+    for (uint16_t i=0; i<UART_TX_SIZE; i++) CHECK_EQUAL(data[i], line.bytes[i]);
+    for (uint16_t i=0; i<10; i++) CHECK_EQUAL(data[100 + i], line.bytes[UART_TX_SIZE + i]);
+
+    CHECK_EQUAL(UART_TX_SIZE, uart.availableForWrite());
+
+    // Octet par octet : accepté jusqu'à ce que le tampon soit plein.
+    uint16_t accepted = 0;
+    for (uint16_t i=0; i<100; i++) accepted += uart.write((uint8_t) i);
+
+    CHECK_EQUAL(UART_TX_SIZE, accepted);
+
+}
+
+void testUartBaudRates() {
+
+    CHECK_EQUAL(16, Uart::ubrrFor(115200));
+    CHECK_EQUAL(117647, Uart::baudFor(16));
+    CHECK_EQUAL(1, Uart::ubrrFor(1000000));
+    CHECK_EQUAL(0, Uart::ubrrFor(2000000));
+    CHECK_EQUAL(0x0fff, Uart::ubrrFor(300));
+
+}
+
+int main() {
+
+    testRingBoundaries();
+    testRingWrapAround();
+    testRingBulkPush();
+    testUartNonBlockingWrite();
+    testUartBaudRates();
+
+    return checkReport("uart");
+
+}
\ No newline at end of file
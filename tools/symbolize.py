@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+# -------------------------------------------------------------------------
+# Atelier de programmation Robotic 974
+# © 2020 Stéphane Calderoni
+# -------------------------------------------------------------------------
+# Introduction à la programmation des cartes Arduino
+# Contrôle d'un chenillard à 8 LEDs par un bouton poussoir
+# -------------------------------------------------------------------------
+# Association de l'histogramme restitué par la classe Profiler aux
+# fonctions du programme, à partir de la table des symboles du fichier ELF.
+#
+# Usage : tools/symbolize.py firmware.elf [capture.txt]
+#
+# La capture (l'entrée standard par défaut) est le texte reçu sur le
+# moniteur série : seul le dernier histogramme complet est analysé.
+# Lorsqu'une tranche d'adresses couvre plusieurs fonctions, ses
+# échantillons sont répartis au prorata des octets de chacune.
+# -------------------------------------------------------------------------
+
+import subprocess
+import sys
+
+
+def read_profile(lines):
+    """Dernier histogramme complet de la capture : (entête, {adresse: compte})."""
+
+    profile, header, bins = None, None, None
+
+    for line in lines:
+        line = line.strip()
+        if line.startswith('# profile'):
+            header = dict(f.split('=') for f in line.split()[2:])
+            bins = {}
+        elif line == '# end' and bins is not None:
+            profile = (header, bins)
+            bins = None
+        elif bins is not None and line.startswith('0x'):
+            address, count = line.split()
+            bins[int(address, 16)] = int(count)
+
+    return profile
+
+
+def read_symbols(elf, nm='avr-nm'):
+    """Fonctions du programme, triées par adresse : [(début, fin, nom)]."""
+
+    output = subprocess.run(
+        [nm, '-C', '-n', '-S', '--defined-only', elf],
+        check=True, capture_output=True, text=True).stdout
+
+    symbols = []
+
+    for line in output.splitlines():
+        fields = line.split(maxsplit=3)
+        if len(fields) == 4 and fields[2] in 'tTwW':
+            start, size = int(fields[0], 16), int(fields[1], 16)
+            if size:
+                symbols.append((start, start + size, fields[3]))
+
+    return symbols
+
+
+def attribute(bins, width, symbols):
+    """Répartition des échantillons de chaque tranche entre les fonctions qu'elle couvre."""
+
+    totals = {}
+
+    for start, count in bins.items():
+
+        end = start + width
+        covered = 0
+
+        for s_start, s_end, name in symbols:
+            overlap = min(end, s_end) - max(start, s_start)
+            if overlap > 0:
+                totals[name] = totals.get(name, 0) + count * overlap / width
+                covered += overlap
+
+        if covered < width:
+            totals['?'] = totals.get('?', 0) + count * (width - covered) / width
+
+    return totals
+
+
+def main():
+
+    if len(sys.argv) < 2:
+        sys.exit('usage: symbolize.py firmware.elf [capture.txt]')
+
+    capture = open(sys.argv[2]) if len(sys.argv) > 2 else sys.stdin
+    profile = read_profile(capture)
+
+    if not profile:
+        sys.exit('no complete profile found')
+
+    header, bins = profile
+    width = int(header['width'])
+    totals = attribute(bins, width, read_symbols(sys.argv[1]))
+    samples = sum(bins.values()) or 1
+
+    print(f"{header['samples']} samples at {header['rate']} Hz, "
+          f"{width}-byte bins, {header['other']} outside the program")
+    print()
+
+    for name, count in sorted(totals.items(), key=lambda t: -t[1]):
+        print(f'{100 * count / samples:6.1f} %  {count:8.1f}  {name}')
+
+
+if __name__ == '__main__':
+    main()